@@ -39,6 +39,10 @@ struct nrf_wifi_fmac_vif_ctx_lnx {
 	unsigned long rssi_record_timestamp_us;
         signed short rssi;
 	char ifname[16];
+
+	/* RX frames waiting to be delivered from the NAPI poll */
+	struct napi_struct napi;
+	struct sk_buff_head rx_q;
 };
 
 struct nrf_wifi_fmac_vif_ctx_lnx *nrf_wifi_lnx_wlan_fmac_add_vif(struct nrf_wifi_ctx_lnx *rpu_ctx_lnx,
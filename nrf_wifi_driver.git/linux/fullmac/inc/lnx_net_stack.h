@@ -26,5 +26,16 @@ void nrf_wifi_netdev_frame_rx_callbk_fn(void *vif_ctx,
 
 enum nrf_wifi_status nrf_wifi_netdev_if_state_chg_callbk_fn(void *vif_ctx,
 							    enum nrf_wifi_fmac_if_carr_state if_state);
+
+#ifdef CONFIG_NRF700X_DATA_TX
+void nrf_wifi_netdev_tx_flow_ctrl_callbk_fn(void *os_vif_ctx,
+					    unsigned int ac,
+					    bool stop);
+
+void nrf_wifi_netdev_tx_done_callbk_fn(void *os_vif_ctx,
+				       unsigned int ac,
+				       unsigned int pkts,
+				       unsigned int bytes);
+#endif /* CONFIG_NRF700X_DATA_TX */
 #endif /* !CONFIG_NRF700X_RADIO_TEST */
 #endif /* __LNX_NET_STACK_H__ */
@@ -53,6 +53,7 @@ struct lnx_shim_bus_pcie_dev_ctx {
 #endif
 	void *intr_callbk_data;
 	int (*intr_callbk_fn)(void *intr_callbk_data);
+	bool irq_thread_sched_set;
 
 	char *dev_name;
 	bool is_msi;
@@ -707,6 +707,10 @@ static int nrf_wifi_lnx_wlan_fmac_conf_disp(struct seq_file *m, void *v)
 	int i = 0;
 	struct nrf_wifi_ctx_lnx *rpu_ctx_lnx = (struct nrf_wifi_ctx_lnx *)m->private;
 	struct rpu_conf_params *conf_params = NULL;
+	struct nrf_wifi_hal_dev_ctx *hal_dev_ctx = NULL;
+#ifndef CONFIG_NRF700X_RADIO_TEST
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+#endif /* !CONFIG_NRF700X_RADIO_TEST */
 
 	conf_params = &rpu_ctx_lnx->conf_params;
 
@@ -999,6 +1003,31 @@ static int nrf_wifi_lnx_wlan_fmac_conf_disp(struct seq_file *m, void *v)
 		   ps_wakeup_mode ? "LISTEN INTERVAL" : "DTIM");
 #endif /* CONFIG_NRF700X_RADIO_TEST */
 #endif /* SOC_WEZEN */
+#ifndef CONFIG_NRF700X_RADIO_TEST
+	def_dev_ctx = wifi_dev_priv(rpu_ctx_lnx->rpu_ctx);
+
+	seq_printf(m,
+		   "tx_sched = %s\n",
+		   (def_dev_ctx->tx_config.sched_policy ==
+		    NRF_WIFI_FMAC_TX_SCHED_AIRTIME) ? "AIRTIME" : "RR");
+	seq_printf(m,
+		   "tx_agg_min = %u\n",
+		   def_dev_ctx->tx_config.agg_min);
+	seq_printf(m,
+		   "tx_agg_max = %u\n",
+		   def_dev_ctx->tx_config.agg_max);
+#endif /* !CONFIG_NRF700X_RADIO_TEST */
+	hal_dev_ctx = ((struct nrf_wifi_fmac_dev_ctx *)rpu_ctx_lnx->rpu_ctx)->hal_dev_ctx;
+
+	seq_printf(m,
+		   "irq_poll_thresh = %u\n",
+		   hal_dev_ctx->irq_poll_thresh);
+	seq_printf(m,
+		   "irq_poll_budget = %u\n",
+		   hal_dev_ctx->irq_poll_budget);
+	seq_printf(m,
+		   "irq_poll_usecs = %u\n",
+		   hal_dev_ctx->irq_poll_usecs);
 	return 0;
 }
 
@@ -1106,6 +1135,10 @@ static ssize_t nrf_wifi_lnx_wlan_fmac_conf_write(struct file *file,
 	ssize_t ret_val = count;
 	struct nrf_wifi_ctx_lnx *rpu_ctx_lnx = NULL;
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_hal_dev_ctx *hal_dev_ctx = NULL;
+#ifndef CONFIG_NRF700X_RADIO_TEST
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+#endif /* !CONFIG_NRF700X_RADIO_TEST */
 
 	rpu_ctx_lnx = (struct nrf_wifi_ctx_lnx *)file->f_inode->i_private;
 
@@ -2093,6 +2126,75 @@ static ssize_t nrf_wifi_lnx_wlan_fmac_conf_write(struct file *file,
 		}
 #endif
 #endif
+	} else if (param_get_val(conf_buf, "irq_poll_thresh=", &val)) {
+		hal_dev_ctx = ((struct nrf_wifi_fmac_dev_ctx *)rpu_ctx_lnx->rpu_ctx)->hal_dev_ctx;
+
+		nrf_wifi_fmac_set_irq_mod(rpu_ctx_lnx->rpu_ctx,
+					  val,
+					  hal_dev_ctx->irq_poll_budget,
+					  hal_dev_ctx->irq_poll_usecs);
+	} else if (param_get_val(conf_buf, "irq_poll_budget=", &val)) {
+		hal_dev_ctx = ((struct nrf_wifi_fmac_dev_ctx *)rpu_ctx_lnx->rpu_ctx)->hal_dev_ctx;
+
+		nrf_wifi_fmac_set_irq_mod(rpu_ctx_lnx->rpu_ctx,
+					  hal_dev_ctx->irq_poll_thresh,
+					  val,
+					  hal_dev_ctx->irq_poll_usecs);
+	} else if (param_get_val(conf_buf, "irq_poll_usecs=", &val)) {
+		hal_dev_ctx = ((struct nrf_wifi_fmac_dev_ctx *)rpu_ctx_lnx->rpu_ctx)->hal_dev_ctx;
+
+		nrf_wifi_fmac_set_irq_mod(rpu_ctx_lnx->rpu_ctx,
+					  hal_dev_ctx->irq_poll_thresh,
+					  hal_dev_ctx->irq_poll_budget,
+					  val);
+#ifndef CONFIG_NRF700X_RADIO_TEST
+	} else if (param_get_val(conf_buf, "tx_sched=", &val)) {
+		if (val > NRF_WIFI_FMAC_TX_SCHED_AIRTIME) {
+			snprintf(err_str,
+				 MAX_ERR_STR_SIZE,
+				 "Invalid value %lu\n",
+				 val);
+			ret_val = -EINVAL;
+			goto error;
+		}
+
+		status = nrf_wifi_fmac_set_tx_sched_policy(rpu_ctx_lnx->rpu_ctx,
+							   val);
+		if (status != NRF_WIFI_STATUS_SUCCESS) {
+			snprintf(err_str,
+				 MAX_ERR_STR_SIZE,
+				 "Setting TX scheduling policy failed\n");
+			goto error;
+		}
+	} else if (param_get_val(conf_buf, "tx_agg_min=", &val)) {
+		def_dev_ctx = wifi_dev_priv(rpu_ctx_lnx->rpu_ctx);
+
+		status = nrf_wifi_fmac_set_tx_agg_limits(rpu_ctx_lnx->rpu_ctx,
+							 val,
+							 def_dev_ctx->tx_config.agg_max);
+		if (status != NRF_WIFI_STATUS_SUCCESS) {
+			snprintf(err_str,
+				 MAX_ERR_STR_SIZE,
+				 "Invalid value %lu\n",
+				 val);
+			ret_val = -EINVAL;
+			goto error;
+		}
+	} else if (param_get_val(conf_buf, "tx_agg_max=", &val)) {
+		def_dev_ctx = wifi_dev_priv(rpu_ctx_lnx->rpu_ctx);
+
+		status = nrf_wifi_fmac_set_tx_agg_limits(rpu_ctx_lnx->rpu_ctx,
+							 def_dev_ctx->tx_config.agg_min,
+							 val);
+		if (status != NRF_WIFI_STATUS_SUCCESS) {
+			snprintf(err_str,
+				 MAX_ERR_STR_SIZE,
+				 "Invalid value %lu\n",
+				 val);
+			ret_val = -EINVAL;
+			goto error;
+		}
+#endif /* !CONFIG_NRF700X_RADIO_TEST */
 	} else if (param_get_sval(conf_buf, "tx_pkt_mcs=", &sval)) {
 #ifdef CONFIG_NRF700X_RADIO_TEST
 		if (rpu_ctx_lnx->conf_params.op_mode == RPU_OP_MODE_RADIO_TEST) {
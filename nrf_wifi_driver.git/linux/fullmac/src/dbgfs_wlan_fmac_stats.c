@@ -12,6 +12,9 @@ static void nrf_wifi_lnx_wlan_fmac_dbgfs_stats_show_host(struct seq_file *m,
 						      struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 						      struct rpu_host_stats *stats)
 {
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+	int ac = 0;
+	int pool = 0;
 #ifdef DEBUG_MODE_SUPPORT
 	int i = 0;
 	unsigned int cnt = 0;
@@ -27,6 +30,35 @@ static void nrf_wifi_lnx_wlan_fmac_dbgfs_stats_show_host(struct seq_file *m,
 	seq_printf(m,
 		   "total_rx_pkts = %llu\n",
 		   stats->total_rx_pkts);
+	seq_printf(m,
+		   "tx_cmd_pool_hits = %llu\n",
+		   stats->tx_cmd_pool_hits);
+	seq_printf(m,
+		   "tx_cmd_pool_misses = %llu\n",
+		   stats->tx_cmd_pool_misses);
+
+	for (pool = 0; pool < MAX_NUM_OF_RX_QUEUES; pool++) {
+		seq_printf(m,
+			   "rx_buf_recycle[%d] = %llu hits, %llu misses\n",
+			   pool,
+			   stats->rx_buf_recycle_hits[pool],
+			   stats->rx_buf_recycle_misses[pool]);
+	}
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	seq_printf(m,
+		   "tx_agg_bounds = %u - %u\n",
+		   def_dev_ctx->tx_config.agg_min,
+		   def_dev_ctx->tx_config.agg_max);
+
+	for (ac = 0; ac < NRF_WIFI_FMAC_AC_MAX; ac++) {
+		seq_printf(m,
+			   "tx_agg_limit[%d] = %u (tx_done_latency = %u us)\n",
+			   ac,
+			   def_dev_ctx->tx_config.agg_limit[ac],
+			   def_dev_ctx->tx_config.tx_done_latency_us[ac]);
+	}
 #ifdef DEBUG_MODE_SUPPORT
 
 	for (i = 0; i < fmac_dev_ctx->fpriv->data_config.max_tx_aggregation; i++) {
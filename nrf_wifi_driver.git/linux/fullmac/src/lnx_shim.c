@@ -14,6 +14,8 @@
 #include <linux/printk.h>
 #include <linux/skbuff.h>
 #include <linux/interrupt.h>
+#include <linux/sched.h>
+#include <linux/sched/types.h>
 #include <linux/delay.h>
 #include <linux/dma-mapping.h>
 #include <linux/firmware.h>
@@ -253,6 +255,16 @@ static void lnx_shim_nbuf_free(void *nbuf)
 }
 
 
+static void lnx_shim_nbuf_reset(void *nbuf)
+{
+	struct sk_buff *skb = (struct sk_buff *)nbuf;
+
+	skb->data = skb->head;
+	skb_reset_tail_pointer(skb);
+	skb->len = 0;
+}
+
+
 static void lnx_shim_nbuf_headroom_res(void *nbuf,
 				       unsigned int size)
 {
@@ -533,6 +545,10 @@ static unsigned int lnx_shim_time_elapsed_us(unsigned long start_time_us)
 }
 
 #ifdef BUS_IF_PCIE
+extern unsigned int irq_threaded;
+extern int irq_thread_cpu;
+extern unsigned int irq_thread_prio;
+
 static irqreturn_t lnx_shim_irq_handler(int irq, void *p)
 {
 	struct lnx_shim_bus_pcie_dev_ctx *lnx_pcie_dev_ctx = NULL;
@@ -551,6 +567,50 @@ static irqreturn_t lnx_shim_irq_handler(int irq, void *p)
 }
 
 
+static irqreturn_t lnx_shim_irq_hard_handler(int irq, void *p)
+{
+	/* The line stays masked (IRQF_ONESHOT) until the thread is done, the
+	 * RPU interrupt is acked by the thread before it reads the events.
+	 */
+	return IRQ_WAKE_THREAD;
+}
+
+
+static irqreturn_t lnx_shim_irq_thread_fn(int irq, void *p)
+{
+	struct lnx_shim_bus_pcie_dev_ctx *lnx_pcie_dev_ctx = NULL;
+	struct sched_attr attr;
+	irqreturn_t ret = IRQ_NONE;
+
+	lnx_pcie_dev_ctx = (struct lnx_shim_bus_pcie_dev_ctx *)p;
+
+	if (irq_thread_prio && !lnx_pcie_dev_ctx->irq_thread_sched_set) {
+		memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.sched_policy = SCHED_FIFO;
+		attr.sched_priority = min_t(unsigned int,
+					    irq_thread_prio,
+					    MAX_RT_PRIO - 1);
+
+		if (sched_setattr_nocheck(current, &attr))
+			pr_err("%s: Unable to set thread priority to %d\n",
+			       __func__,
+			       attr.sched_priority);
+
+		lnx_pcie_dev_ctx->irq_thread_sched_set = true;
+	}
+
+	/* The events are processed (and polled for) in this thread, the
+	 * softirqs it raises on the way (e.g. NAPI) run once it is done.
+	 */
+	local_bh_disable();
+	ret = lnx_shim_irq_handler(irq, p);
+	local_bh_enable();
+
+	return ret;
+}
+
+
 static void lnx_shim_bus_pcie_dev_host_map_get(void *os_pcie_dev_ctx,
 					       struct nrf_wifi_osal_host_map *host_map)
 {
@@ -645,6 +705,7 @@ enum nrf_wifi_status lnx_shim_bus_pcie_dev_intr_reg(void *os_pcie_dev_ctx,
 
 	lnx_pcie_dev_ctx->intr_callbk_data = callbk_data;
 	lnx_pcie_dev_ctx->intr_callbk_fn = callbk_fn;
+	lnx_pcie_dev_ctx->irq_thread_sched_set = false;
 
 #ifdef notyet
 	/* TODO: See why this flag is needed (is it necessary for WoWLAN?) */
@@ -655,18 +716,52 @@ enum nrf_wifi_status lnx_shim_bus_pcie_dev_intr_reg(void *os_pcie_dev_ctx,
 	if(lnx_pcie_dev_ctx->is_msi == 0)
 		irq_flags |= IRQF_SHARED;
 
+	/* A shared legacy line would stay masked for the other devices on it
+	 * while the thread runs (IRQF_ONESHOT), keep to the tasklet there. This
+	 * runs before the FMAC is told the mode, so it gets the fallback too.
+	 */
+	if (irq_threaded && (lnx_pcie_dev_ctx->is_msi == 0)) {
+		pr_err("%s: Threaded IRQ needs MSI, falling back to a tasklet\n",
+		       __func__);
+		irq_threaded = 0;
+	}
+
 	/* TODO: Replace wlan0 with a per RPU device name */
-	ret = request_irq(lnx_pcie_dev_ctx->pdev->irq,
-			  lnx_shim_irq_handler,
-			  irq_flags,
-			  "wlan0",
-			  lnx_pcie_dev_ctx);
+	if (irq_threaded) {
+		ret = request_threaded_irq(lnx_pcie_dev_ctx->pdev->irq,
+					   lnx_shim_irq_hard_handler,
+					   lnx_shim_irq_thread_fn,
+					   irq_flags | IRQF_ONESHOT,
+					   "wlan0",
+					   lnx_pcie_dev_ctx);
+	} else {
+		ret = request_irq(lnx_pcie_dev_ctx->pdev->irq,
+				  lnx_shim_irq_handler,
+				  irq_flags,
+				  "wlan0",
+				  lnx_pcie_dev_ctx);
+	}
 
 	if (ret) {
 		pr_err("%s: request_irq failed\n", __func__);
 		goto out;
 	}
 
+	/* The IRQ thread follows the affinity of the interrupt */
+	if (irq_thread_cpu >= 0) {
+		if ((irq_thread_cpu < nr_cpu_ids) && cpu_online(irq_thread_cpu)) {
+			if (irq_set_affinity_and_hint(lnx_pcie_dev_ctx->pdev->irq,
+						      cpumask_of(irq_thread_cpu)))
+				pr_err("%s: Unable to set IRQ affinity to CPU %d\n",
+				       __func__,
+				       irq_thread_cpu);
+		} else {
+			pr_err("%s: Invalid IRQ CPU %d\n",
+			       __func__,
+			       irq_thread_cpu);
+		}
+	}
+
 	status = NRF_WIFI_STATUS_SUCCESS;
 
 out:
@@ -683,6 +778,9 @@ void lnx_shim_bus_pcie_dev_intr_unreg(void *os_pcie_dev_ctx)
 
 	pdev = lnx_pcie_dev_ctx->pdev;
 
+	if (irq_thread_cpu >= 0)
+		irq_update_affinity_hint(lnx_pcie_dev_ctx->pdev->irq, NULL);
+
 	free_irq(lnx_pcie_dev_ctx->pdev->irq, lnx_pcie_dev_ctx);
 
 	if (lnx_pcie_dev_ctx->is_msi)
@@ -983,7 +1081,7 @@ void lnx_shim_bus_pcie_deinit(void *os_pcie_priv)
 }
 #endif
 
-#ifdef CONFIG_NRF_WIFI_LOW_POWER
+#if defined(CONFIG_NRF_WIFI_LOW_POWER) || defined(HAL_CMD_ASYNC)
 
 struct timer_info {
 	struct timer_list sleep_timer;
@@ -1039,7 +1137,7 @@ static void lnx_shim_timer_kill(void *timer)
 {
 	del_timer_sync(timer);
 }
-#endif
+#endif /* CONFIG_NRF_WIFI_LOW_POWER || HAL_CMD_ASYNC */
 
 static void lnx_shim_assert(int test_val, int val, enum nrf_wifi_assert_op_type op,
                         char *msg)
@@ -1130,6 +1228,7 @@ const struct nrf_wifi_osal_ops nrf_wifi_os_lnx_ops = {
 
 	.nbuf_alloc = lnx_shim_nbuf_alloc,
 	.nbuf_free = lnx_shim_nbuf_free,
+	.nbuf_reset = lnx_shim_nbuf_reset,
 	.nbuf_headroom_res = lnx_shim_nbuf_headroom_res,
 	.nbuf_headroom_get = lnx_shim_nbuf_headroom_get,
 	.nbuf_data_size = lnx_shim_nbuf_data_size,
@@ -1163,13 +1262,13 @@ const struct nrf_wifi_osal_ops nrf_wifi_os_lnx_ops = {
 	.bus_pcie_dev_dma_unmap = lnx_shim_bus_pcie_dev_dma_unmap,
 	.bus_pcie_dev_host_map_get = lnx_shim_bus_pcie_dev_host_map_get,
 #endif
-#ifdef CONFIG_NRF_WIFI_LOW_POWER
+#if defined(CONFIG_NRF_WIFI_LOW_POWER) || defined(HAL_CMD_ASYNC)
 	.timer_alloc = lnx_shim_timer_alloc,
 	.timer_init = lnx_shim_timer_init,
 	.timer_free = lnx_shim_timer_free,
 	.timer_schedule = lnx_shim_timer_schedule,
 	.timer_kill = lnx_shim_timer_kill,
-#endif
+#endif /* CONFIG_NRF_WIFI_LOW_POWER || HAL_CMD_ASYNC */
 	.assert = lnx_shim_assert,
 	.mem_cmp = lnx_shim_mem_cmp,
 	.strlen = lnx_shim_str_len,
@@ -46,6 +46,10 @@ module_param(sleep_type, charp, 0000);
 MODULE_PARM_DESC(sleep_type, "Configure the sleep type parameter");
 #endif
 
+unsigned int rx_napi_budget = NAPI_POLL_WEIGHT;
+module_param(rx_napi_budget, uint, 0000);
+MODULE_PARM_DESC(rx_napi_budget, "Max RX frames delivered per NAPI poll");
+
 #endif /* !CONFIG_NRF700X_RADIO_TEST */
 
 unsigned int phy_calib = NRF_WIFI_DEF_PHY_CALIB;
@@ -53,6 +57,30 @@ unsigned int phy_calib = NRF_WIFI_DEF_PHY_CALIB;
 module_param(phy_calib, uint, 0000);
 MODULE_PARM_DESC(phy_calib, "Configure the bitmap of the PHY calibrations required");
 
+unsigned int irq_poll_thresh = 0;
+module_param(irq_poll_thresh, uint, 0000);
+MODULE_PARM_DESC(irq_poll_thresh, "Events per interrupt at which the RPU interrupt is masked and events are polled for (0 = never poll)");
+
+unsigned int irq_poll_budget = 64;
+module_param(irq_poll_budget, uint, 0000);
+MODULE_PARM_DESC(irq_poll_budget, "Max consecutive event polls before the RPU interrupt is unmasked");
+
+unsigned int irq_poll_usecs = 100;
+module_param(irq_poll_usecs, uint, 0000);
+MODULE_PARM_DESC(irq_poll_usecs, "Time (us) to keep polling for events after the last one was seen");
+
+unsigned int irq_threaded = 0;
+module_param(irq_threaded, uint, 0000);
+MODULE_PARM_DESC(irq_threaded, "Handle the RPU interrupt in a kernel thread instead of in hard IRQ context and a tasklet");
+
+int irq_thread_cpu = -1;
+module_param(irq_thread_cpu, int, 0000);
+MODULE_PARM_DESC(irq_thread_cpu, "CPU to run the RPU interrupt (thread) on (-1 = no preference)");
+
+unsigned int irq_thread_prio = 0;
+module_param(irq_thread_prio, uint, 0000);
+MODULE_PARM_DESC(irq_thread_prio, "SCHED_FIFO priority of the RPU interrupt thread (0 = kernel default)");
+
 /* 3 bytes for addreess, 3 bytes for length */
 #define MAX_PKT_RAM_TX_ALIGN_OVERHEAD 6
 #define MAX_RX_QUEUES 3
@@ -596,6 +624,14 @@ struct nrf_wifi_ctx_lnx *nrf_wifi_fmac_dev_add_lnx(void)
 
 	rpu_ctx_lnx->rpu_ctx = rpu_ctx;
 
+	nrf_wifi_fmac_set_irq_mod(rpu_ctx,
+				  irq_poll_thresh,
+				  irq_poll_budget,
+				  irq_poll_usecs);
+
+	nrf_wifi_fmac_set_irq_threaded(rpu_ctx,
+				       irq_threaded ? true : false);
+
 #if defined(HOST_FW_LOAD_SUPPORT) || defined(HOST_FW_HEX_LOAD_SUPPORT)
 	/* Load the firmware to the RPU */
 	status = nrf_wifi_lnx_wlan_fmac_fw_load(rpu_ctx_lnx,
@@ -1465,6 +1501,10 @@ int __init nrf_wifi_init_lnx(void)
 #endif /* CONFIG_WIFI_MGMT_RAW_SCAN_RESULTS */
 	callbk_fns.set_if_callbk_fn = &nrf_wifi_set_if_callbk_fn;
 	callbk_fns.process_rssi_from_rx = &nrf_wifi_process_rssi_from_rx;
+#ifdef CONFIG_NRF700X_DATA_TX
+	callbk_fns.tx_flow_ctrl_callbk_fn = &nrf_wifi_netdev_tx_flow_ctrl_callbk_fn;
+	callbk_fns.tx_done_callbk_fn = &nrf_wifi_netdev_tx_done_callbk_fn;
+#endif /* CONFIG_NRF700X_DATA_TX */
 #ifdef HOST_CFG80211_SUPPORT	
 	callbk_fns.get_station_callbk_fn = &nrf_wifi_get_station_callbk_fn;
 	callbk_fns.chnl_get_callbk_fn = &nrf_wifi_chnl_get_callbk_fn;
@@ -16,11 +16,16 @@
 #include "lnx_fmac_main.h"
 #include "fmac_api.h"
 
+extern unsigned int rx_napi_budget;
+
 int nrf_wifi_netdev_open(struct net_device *netdev)
 {
 	struct nrf_wifi_ctx_lnx *rpu_ctx_lnx = NULL;
 	struct nrf_wifi_fmac_vif_ctx_lnx *vif_ctx_lnx = NULL;
 	struct nrf_wifi_umac_chg_vif_state_info *vif_info = NULL;
+#ifdef CONFIG_NRF700X_DATA_TX
+	unsigned int i = 0;
+#endif /* CONFIG_NRF700X_DATA_TX */
 	int status = -1;
 
 	vif_ctx_lnx = netdev_priv(netdev);
@@ -35,6 +40,14 @@ int nrf_wifi_netdev_open(struct net_device *netdev)
 
 	vif_info->state = 1;
 
+	napi_enable(&vif_ctx_lnx->napi);
+
+#ifdef CONFIG_NRF700X_DATA_TX
+	/* Drop any BQL state left over from frames that were never completed */
+	for (i = 0; i < netdev->real_num_tx_queues; i++)
+		netdev_tx_reset_queue(netdev_get_tx_queue(netdev, i));
+#endif /* CONFIG_NRF700X_DATA_TX */
+
 	vif_info->if_index = vif_ctx_lnx->if_idx;
 
 	memcpy(vif_ctx_lnx->ifname,
@@ -47,6 +60,7 @@ int nrf_wifi_netdev_open(struct net_device *netdev)
 
 	if (status == NRF_WIFI_STATUS_FAIL) {
 		pr_err("%s: nrf_wifi_fmac_chg_vif_state failed\n", __func__);
+		napi_disable(&vif_ctx_lnx->napi);
 		goto out;
 	}
 
@@ -93,6 +107,9 @@ int nrf_wifi_netdev_close(struct net_device *netdev)
 
 	netif_carrier_off(netdev);
 out:
+	napi_disable(&vif_ctx_lnx->napi);
+	skb_queue_purge(&vif_ctx_lnx->rx_q);
+
 	if(vif_info)
 		kfree(vif_info);
 
@@ -105,6 +122,8 @@ netdev_tx_t nrf_wifi_netdev_start_xmit(struct sk_buff *skb,
 {
 	struct nrf_wifi_ctx_lnx *rpu_ctx_lnx = NULL;
 	struct nrf_wifi_fmac_vif_ctx_lnx *vif_ctx_lnx = NULL;
+	struct netdev_queue *txq = NULL;
+	unsigned int len = 0;
 	int status = -1;
 	int ret = NETDEV_TX_OK;
 
@@ -117,12 +136,22 @@ netdev_tx_t nrf_wifi_netdev_start_xmit(struct sk_buff *skb,
 	 * */
 	sk_pacing_shift_update(skb->sk, 8);
 
+	/* The skb can be completed (and freed) before
+	 * nrf_wifi_fmac_start_xmit returns, so account it for BQL upfront.
+	 */
+	txq = netdev_get_tx_queue(netdev, skb_get_queue_mapping(skb));
+	len = skb->len;
+
+	netdev_tx_sent_queue(txq, len);
+
 	status = nrf_wifi_fmac_start_xmit(rpu_ctx_lnx->rpu_ctx,
 					    vif_ctx_lnx->if_idx,
 					    skb);
 
 	if (status == NRF_WIFI_STATUS_FAIL) {
 		pr_err("%s: nrf_wifi_fmac_start_xmit failed\n", __func__);
+		/* The skb has been dropped, it will never be completed */
+		netdev_tx_completed_queue(txq, 1, len);
 		ret = NETDEV_TX_OK;
 		goto out;
 	}
@@ -133,6 +162,84 @@ out:
 }
 
 
+#ifdef CONFIG_NRF700X_DATA_TX
+u16 nrf_wifi_netdev_select_queue(struct net_device *netdev,
+				 struct sk_buff *skb,
+				 struct net_device *sb_dev)
+{
+	struct nrf_wifi_ctx_lnx *rpu_ctx_lnx = NULL;
+	struct nrf_wifi_fmac_vif_ctx_lnx *vif_ctx_lnx = NULL;
+	int ac = NRF_WIFI_FMAC_AC_BE;
+
+	vif_ctx_lnx = netdev_priv(netdev);
+	rpu_ctx_lnx = vif_ctx_lnx->rpu_ctx;
+
+	ac = nrf_wifi_fmac_get_tx_ac(rpu_ctx_lnx->rpu_ctx,
+				     vif_ctx_lnx->if_idx,
+				     skb);
+
+	/* Multicast frames share the BE queue */
+	if (ac >= NRF_WIFI_FMAC_AC_MC)
+		ac = NRF_WIFI_FMAC_AC_BE;
+
+	return ac;
+}
+
+
+void nrf_wifi_netdev_tx_flow_ctrl_callbk_fn(void *os_vif_ctx,
+					    unsigned int ac,
+					    bool stop)
+{
+	struct nrf_wifi_fmac_vif_ctx_lnx *vif_ctx_lnx = NULL;
+
+	vif_ctx_lnx = (struct nrf_wifi_fmac_vif_ctx_lnx *)os_vif_ctx;
+
+	if (!vif_ctx_lnx || !vif_ctx_lnx->netdev) {
+		pr_err("%s: Invalid parameters\n", __func__);
+		return;
+	}
+
+	if (ac >= vif_ctx_lnx->netdev->real_num_tx_queues)
+		return;
+
+	if (stop)
+		netif_stop_subqueue(vif_ctx_lnx->netdev, ac);
+	else
+		netif_wake_subqueue(vif_ctx_lnx->netdev, ac);
+}
+
+
+void nrf_wifi_netdev_tx_done_callbk_fn(void *os_vif_ctx,
+				       unsigned int ac,
+				       unsigned int pkts,
+				       unsigned int bytes)
+{
+	struct nrf_wifi_fmac_vif_ctx_lnx *vif_ctx_lnx = NULL;
+	struct net_device *netdev = NULL;
+
+	vif_ctx_lnx = (struct nrf_wifi_fmac_vif_ctx_lnx *)os_vif_ctx;
+
+	if (!vif_ctx_lnx || !vif_ctx_lnx->netdev) {
+		pr_err("%s: Invalid parameters\n", __func__);
+		return;
+	}
+
+	netdev = vif_ctx_lnx->netdev;
+
+	/* Multicast frames are queued on the BE queue */
+	if (ac >= NRF_WIFI_FMAC_AC_MC)
+		ac = NRF_WIFI_FMAC_AC_BE;
+
+	if (ac >= netdev->real_num_tx_queues)
+		return;
+
+	netdev_tx_completed_queue(netdev_get_tx_queue(netdev, ac),
+				  pkts,
+				  bytes);
+}
+#endif /* CONFIG_NRF700X_DATA_TX */
+
+
 void nrf_wifi_netdev_set_multicast_list(struct net_device *netdev)
 {
 	struct nrf_wifi_ctx_lnx *rpu_ctx_lnx = NULL;
@@ -200,7 +307,47 @@ void nrf_wifi_netdev_frame_rx_callbk_fn(void *os_vif_ctx,
 	skb->protocol = eth_type_trans(skb, skb->dev);
 	skb->ip_summed = CHECKSUM_UNNECESSARY; /* don't check it */
 
-	netif_rx(skb);
+	/* NAPI is disabled while the interface is down */
+	if (!netif_running(netdev)) {
+		dev_kfree_skb_any(skb);
+		return;
+	}
+
+	/* Frames are handed to the stack in batches from the NAPI poll */
+	skb_queue_tail(&vif_ctx_lnx->rx_q, skb);
+
+	napi_schedule(&vif_ctx_lnx->napi);
+}
+
+
+static int nrf_wifi_netdev_napi_poll(struct napi_struct *napi,
+				     int budget)
+{
+	struct nrf_wifi_fmac_vif_ctx_lnx *vif_ctx_lnx = NULL;
+	struct sk_buff *skb = NULL;
+	int done = 0;
+
+	vif_ctx_lnx = container_of(napi,
+				   struct nrf_wifi_fmac_vif_ctx_lnx,
+				   napi);
+
+	while (done < budget) {
+		skb = skb_dequeue(&vif_ctx_lnx->rx_q);
+
+		if (!skb)
+			break;
+
+		napi_gro_receive(napi, skb);
+		done++;
+	}
+
+	if (done < budget && napi_complete_done(napi, done)) {
+		/* Frames queued after the queue was found empty */
+		if (!skb_queue_empty(&vif_ctx_lnx->rx_q))
+			napi_schedule(napi);
+	}
+
+	return done;
 }
 
 
@@ -241,6 +388,7 @@ const struct net_device_ops nrf_wifi_netdev_ops = {
 	.ndo_stop = nrf_wifi_netdev_close,
 #ifdef CONFIG_NRF700X_DATA_TX
 	.ndo_start_xmit = nrf_wifi_netdev_start_xmit,
+	.ndo_select_queue = nrf_wifi_netdev_select_queue,
 #endif /* CONFIG_NRF700X_DATA_TX */
 #if 0
 	.ndo_set_rx_mode = nrf_wifi_netdev_set_multicast_list,
@@ -261,7 +409,9 @@ struct nrf_wifi_fmac_vif_ctx_lnx *nrf_wifi_netdev_add_vif(struct nrf_wifi_ctx_ln
 
 	ASSERT_RTNL();
 
-	netdev = alloc_etherdev(sizeof(struct nrf_wifi_fmac_vif_ctx_lnx));
+	/* One TX queue per WMM access category, indexed by nrf_wifi_fmac_ac */
+	netdev = alloc_etherdev_mq(sizeof(struct nrf_wifi_fmac_vif_ctx_lnx),
+				   NRF_WIFI_FMAC_AC_MC);
 
 	if (!netdev) {
 		pr_err("%s: Unable to allocate memory for a new netdev\n",
@@ -275,6 +425,13 @@ struct nrf_wifi_fmac_vif_ctx_lnx *nrf_wifi_netdev_add_vif(struct nrf_wifi_ctx_ln
 
 	netdev->netdev_ops = &nrf_wifi_netdev_ops;
 
+	skb_queue_head_init(&vif_ctx_lnx->rx_q);
+
+	netif_napi_add_weight(netdev,
+			      &vif_ctx_lnx->napi,
+			      nrf_wifi_netdev_napi_poll,
+			      rx_napi_budget ? rx_napi_budget : NAPI_POLL_WEIGHT);
+
 	strncpy(netdev->name,
 		if_name,
 		sizeof(netdev->name) - 1);
@@ -625,6 +625,55 @@ enum nrf_wifi_status nrf_wifi_fmac_start_xmit(void *fmac_dev_ctx,
 					      unsigned char if_idx,
 					      void *netbuf);
 
+/**
+ * @brief Get the access category a frame will be queued on.
+ * @param fmac_dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ * @param if_idx Index of the interface on which the frame is to be
+ *               transmitted.
+ * @param netbuf Pointer to the OS specific network buffer.
+ *
+ * This function classifies a frame the same way as nrf_wifi_fmac_start_xmit,
+ * so that the OS can select the TX queue matching the access category.
+ *
+ *@retval	The access category (@ref nrf_wifi_fmac_ac) of the frame,
+ *		NRF_WIFI_FMAC_AC_BE if the peer is unknown.
+ */
+int nrf_wifi_fmac_get_tx_ac(void *fmac_dev_ctx,
+			    unsigned char if_idx,
+			    void *netbuf);
+
+/**
+ * @brief Set the policy used to schedule peers for TX.
+ * @param fmac_dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ * @param policy The scheduling policy to be used.
+ *
+ * This function selects how the peer which gets the next TX opportunity in
+ *	    an access category is picked. The airtime accounting of all peers is
+ *	    reset when the policy is changed.
+ *
+ *@retval	NRF_WIFI_STATUS_SUCCESS On success
+ *@retval	NRF_WIFI_STATUS_FAIL On failure
+ */
+enum nrf_wifi_status nrf_wifi_fmac_set_tx_sched_policy(void *fmac_dev_ctx,
+						       enum nrf_wifi_fmac_tx_sched_policy policy);
+
+/**
+ * @brief Set the bounds of the adaptive TX aggregation size.
+ * @param fmac_dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ * @param agg_min Minimum number of frames aggregated in a TX descriptor.
+ * @param agg_max Maximum number of frames aggregated in a TX descriptor.
+ *
+ * This function sets the range within which the number of frames aggregated
+ *	    per TX descriptor is adapted, \p agg_max cannot exceed the
+ *	    max_tx_aggregation the device was initialized with.
+ *
+ *@retval	NRF_WIFI_STATUS_SUCCESS On success
+ *@retval	NRF_WIFI_STATUS_FAIL On failure
+ */
+enum nrf_wifi_status nrf_wifi_fmac_set_tx_agg_limits(void *fmac_dev_ctx,
+						     unsigned int agg_min,
+						     unsigned int agg_max);
+
 /**
  * @brief Inform the RPU firmware that host is going to suspend state.
  * @param fmac_dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
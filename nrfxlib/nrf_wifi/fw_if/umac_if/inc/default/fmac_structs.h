@@ -24,6 +24,12 @@
 
 #define MAX_PEERS 5
 #define MAX_SW_PEERS (MAX_PEERS + 1)
+/* Slots in the peer lookup table, power of 2 and more than MAX_PEERS. The
+ * table is a single 32 bit word, see tx_config.peer_hash.
+ */
+#define PEER_HASH_SIZE 8
+#define PEER_HASH_SLOT_BITS 4
+#define PEER_HASH_SLOT_MASK ((1 << PEER_HASH_SLOT_BITS) - 1)
 #define NRF_WIFI_AC_TWT_PRIORITY_EMERGENCY 0xFF
 
 
@@ -246,6 +252,17 @@ struct nrf_wifi_fmac_callbk_fns {
 	/** Callback function to be called when rssi is to be processed from the received frame. */
 	void (*process_rssi_from_rx)(void *os_vif_ctx,
 				     signed short signal);
+
+	/** Callback function to be called to stop or resume the OS TX queue of an access category. */
+	void (*tx_flow_ctrl_callbk_fn)(void *os_vif_ctx,
+				       unsigned int ac,
+				       bool stop);
+
+	/** Callback function to be called when frames of an access category have been transmitted. */
+	void (*tx_done_callbk_fn)(void *os_vif_ctx,
+				  unsigned int ac,
+				  unsigned int pkts,
+				  unsigned int bytes);
 #endif /* CONFIG_NRF700X_STA_MODE */
 };
 
@@ -261,6 +278,17 @@ enum nrf_wifi_fmac_twt_state {
 	NRF_WIFI_FMAC_TWT_STATE_AWAKE
 };
 
+/**
+ * @brief The policy used to pick the peer which gets the next TX opportunity in an AC.
+ *
+ */
+enum nrf_wifi_fmac_tx_sched_policy {
+	/** Round robin over the peers with pending frames. */
+	NRF_WIFI_FMAC_TX_SCHED_RR,
+	/** Deficit round robin over the peers, keyed on the airtime they used. */
+	NRF_WIFI_FMAC_TX_SCHED_AIRTIME
+};
+
 /**
  * @brief Structure to hold peer context information.
  *
@@ -280,6 +308,8 @@ struct peers_info {
 	unsigned char qos_supported;
 	/** Pending queue bitmap. */
 	unsigned char pend_q_bmp;
+	/** Pending queue bitmap as last written to the RPU. */
+	unsigned char pend_q_bmp_rpu;
 	/** Receiver address. */
 	unsigned char ra_addr[NRF_WIFI_ETH_ADDR_LEN];
 	/** Pairwise cipher. */
@@ -291,28 +321,84 @@ struct peers_info {
 /**
  * @brief Structure to hold transmit path context information.
  *
+ * Locks, when nested, are taken in the below order:
+ *  - ac_lock: more than one is taken by the TX done path for spare
+ *    descriptors (VO to BK) and by nrf_wifi_fmac_set_tx_sched_policy() and
+ *    nrf_wifi_fmac_set_tx_agg_limits(), which take all of them (MC to BK)
+ *    from process context. Either way always in descending AC order.
+ *  - peer_lock.
+ *  - tx_cmd_lock.
+ *  - ps_lock.
+ *  - spare_desc_lock.
+ * HAL locks are always taken after all of these.
  */
 struct tx_config {
-	/** Lock used to make code portions in the TX path atomic. */
-	void *tx_lock;
+	/** Per-AC lock protecting the reserved descriptors, outstanding_descs,
+	 *  curr_peer_opp, airtime_deficit, agg_limit and the data_pending_txq of
+	 *  every peer for that AC.
+	 */
+	void *ac_lock[NRF_WIFI_FMAC_AC_MAX];
+	/** Per-peer lock protecting state shared by all ACs of a peer (pend_q_bmp). */
+	void *peer_lock[MAX_SW_PEERS];
+	/** Lock serializing the building and posting of TX commands. */
+	void *tx_cmd_lock;
+	/** Lock protecting wakeup_client_q and the power save token counts of peers. */
+	void *ps_lock;
+	/** Lock protecting spare_desc_free_bmp and spare_desc_queue_map. */
+	void *spare_desc_lock;
 	/** Context information about peers that the RPU firmware is connected to. */
 	struct peers_info peers[MAX_SW_PEERS];
+	/** Open addressed lookup table of unicast peers keyed on the MAC address,
+	 *  slot n is bits [4n + 3:4n] and holds (peer index + 1) or 0 if empty.
+	 *  Lookups are lockless, so the table is rebuilt aside and replaced with
+	 *  a single store.
+	 */
+	unsigned int peer_hash;
+	/** Index of the peer found by the last lookup. */
+	int last_peer_id;
 	/** Coalesce count of TX frames. */
 	unsigned int *send_pkt_coalesce_count_p;
 	/** per-peer/per-AC Queue for frames waiting to be passed to the RPU firmware for TX. */
 	void *data_pending_txq[MAX_SW_PEERS][NRF_WIFI_FMAC_AC_MAX];
 	/** Queue for peers which have woken up from 802.11 power save. */
 	void *wakeup_client_q;
-	/** Used to store tx descs(buff pool ids). */
-	unsigned long *buf_pool_bmp_p;
+	/** Per-AC bitmap of free reserved TX descriptors, bit n stands for
+	 *  descriptor (ac + (NRF_WIFI_FMAC_AC_MAX * n)).
+	 */
+	unsigned long long desc_free_bmp[NRF_WIFI_FMAC_AC_MAX];
+	/** Bitmap of free spare TX descriptors, bit n stands for the n-th
+	 *  descriptor after the reserved ones.
+	 */
+	unsigned long long spare_desc_free_bmp;
 	/** TX descriptors which have been queued to the RPU firmware. */
 	unsigned int outstanding_descs[NRF_WIFI_FMAC_AC_MAX];
 	/** Peer who will be get the next opportunity for TX. */
 	unsigned int curr_peer_opp[NRF_WIFI_FMAC_AC_MAX];
+	/** Policy used to pick the peer for the next TX opportunity. */
+	enum nrf_wifi_fmac_tx_sched_policy sched_policy;
+	/** Per-peer/per-AC airtime (in us) left in the current round, used by
+	 *  the NRF_WIFI_FMAC_TX_SCHED_AIRTIME policy, protected by ac_lock.
+	 */
+	int airtime_deficit[MAX_PEERS][NRF_WIFI_FMAC_AC_MAX];
+	/** Per-AC number of frames aggregated in a TX descriptor, adapted
+	 *  between agg_min and agg_max based on the TX done latency, protected
+	 *  by ac_lock.
+	 */
+	unsigned int agg_limit[NRF_WIFI_FMAC_AC_MAX];
+	/** Per-AC smoothed time (in us) from posting a TX descriptor to its TX done. */
+	unsigned int tx_done_latency_us[NRF_WIFI_FMAC_AC_MAX];
+	/** Lower bound of agg_limit. */
+	unsigned int agg_min;
+	/** Upper bound of agg_limit. */
+	unsigned int agg_max;
 	/** Access category which will get the next spare descriptor. */
 	unsigned int next_spare_desc_ac;
 	/** Frame context information. */
 	struct tx_pkt_info *pkt_info_p;
+	/** Preformatted TX commands, one per TX descriptor. */
+	unsigned char *tx_cmd_pool;
+	/** Size of each TX command in tx_cmd_pool. */
+	unsigned int tx_cmd_pool_buf_size;
 	/** Map for the spare descriptor queues
 	 *  - First four bits : Spare desc1 queue number,
 	 *  - Second four bits: Spare desc2 queue number.
@@ -442,6 +528,16 @@ struct nrf_wifi_fmac_dev_ctx_def {
 	unsigned char num_ap;
 	/** Queue for storing mapping info of RX buffers. */
 	struct nrf_wifi_fmac_buf_map_info *rx_buf_info;
+	/** Per pool queue of RX buffers which can be reused for refills. */
+	void *rx_buf_free_q[MAX_NUM_OF_RX_QUEUES];
+	/** Descs consumed by the RX event being processed, re-armed in one go. */
+	unsigned int rx_refill_desc[MAX_RX_BUFS_PER_EVNT];
+#ifdef SOC_WEZEN
+#ifdef CMD_RX_BUFF
+	/** Buffer info of the re-armed descs, to be programmed to the UMAC. */
+	struct nrf_wifi_rx_buf rx_buf_ipc[MAX_RX_BUFS_PER_EVNT];
+#endif /* CMD_RX_BUFF */
+#endif /* SOC_WEZEN */
 #if defined(CONFIG_NRF700X_STA_MODE)
 	/** Queue for storing mapping info of TX buffers. */
 	struct nrf_wifi_fmac_buf_map_info *tx_buf_info;
@@ -483,6 +579,8 @@ struct nrf_wifi_fmac_vif_ctx {
 	int if_type;
 	/** BSSID of the AP to which this VIF is connected (applicable only in STA mode). */
 	unsigned char bssid[NRF_WIFI_ETH_ADDR_LEN];
+	/** Per-AC flag indicating the OS TX queue has been stopped, protected by ac_lock. */
+	bool txq_stopped[NRF_WIFI_FMAC_AC_MAX];
 };
 
 /**
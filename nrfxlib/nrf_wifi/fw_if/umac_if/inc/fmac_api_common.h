@@ -133,6 +133,41 @@ enum nrf_wifi_status nrf_wifi_fmac_conf_ltf_gi(struct nrf_wifi_fmac_dev_ctx *fma
 					       unsigned char he_gi,
 					       unsigned char enabled);
 
+/**
+ * @brief Configure moderation of the interrupts from the RPU.
+ * @param fmac_dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ * @param poll_thresh Number of events fetched in a single interrupt at which
+ *		      the RPU interrupt is masked and events are polled for
+ *		      instead, 0 to always use interrupts.
+ * @param poll_budget Maximum number of consecutive polls before the RPU
+ *		      interrupt is unmasked again.
+ * @param poll_usecs Time (in us) to keep polling for after the last poll
+ *		     which found events.
+ *
+ * This function is used to trade interrupt rate against event latency at
+ *	    high packet rates.
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_fmac_set_irq_mod(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+					       unsigned int poll_thresh,
+					       unsigned int poll_budget,
+					       unsigned int poll_usecs);
+
+/**
+ * @brief Configure threaded handling of the interrupts from the RPU.
+ * @param fmac_dev_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ * @param threaded Whether the OS handles the RPU interrupt in a thread.
+ *
+ * This function is used to tell the RPU HAL that its interrupt handler is
+ *	    only ever invoked from a thread, so that it can read and process
+ *	    the RPU events with interrupts enabled.
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_fmac_set_irq_threaded(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+						    bool threaded);
+
 #if defined(CONFIG_NRF700X_UTIL) || defined(__DOXYGEN__)
 enum nrf_wifi_status nrf_wifi_fmac_set_tx_rate(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 					       unsigned char rate_flag,
@@ -39,6 +39,10 @@ enum nrf_wifi_status nrf_wifi_fmac_rx_event_process(struct nrf_wifi_fmac_dev_ctx
 
 void nrf_wifi_fmac_rx_tasklet(void *data);
 
+enum nrf_wifi_status nrf_wifi_fmac_rx_buf_cache_init(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx);
+
+void nrf_wifi_fmac_rx_buf_cache_deinit(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx);
+
 #ifdef SOC_WEZEN
 #ifdef CMD_RX_BUFF
 unsigned long nrf_wifi_fmac_get_rx_buf_map_addr(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
@@ -36,6 +36,14 @@ struct rpu_host_stats {
 	unsigned long long total_rx_pkts;
 	/** Total number of RX frames dropped. */
 	unsigned long long total_rx_drop_pkts;
+	/** Number of TX commands served from the preallocated pool. */
+	unsigned long long tx_cmd_pool_hits;
+	/** Number of TX commands which had to be allocated. */
+	unsigned long long tx_cmd_pool_misses;
+	/** Number of RX refills served from the recycled buffers of each pool. */
+	unsigned long long rx_buf_recycle_hits[MAX_NUM_OF_RX_QUEUES];
+	/** Number of RX refills of each pool which had to allocate a buffer. */
+	unsigned long long rx_buf_recycle_misses[MAX_NUM_OF_RX_QUEUES];
 };
 
 /**
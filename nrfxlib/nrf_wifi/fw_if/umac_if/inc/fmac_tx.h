@@ -15,7 +15,9 @@
 #include "host_rpu_data_if.h"
 #include "fmac_structs.h"
 
-#define TX_DESC_BUCKET_BOUND 32
+/* Width of the per-AC free descriptor bitmaps */
+#define TX_DESC_BMP_BITS 64
+#define TX_DESC_BMP_MASK(n) (((n) >= TX_DESC_BMP_BITS) ? ~0ULL : ((1ULL << (n)) - 1))
 #define DOT11_WMM_PARAMS_LEN 2
 
 /* 4 bits represent 4 access categories.
@@ -23,6 +25,21 @@
  */
 #define SPARE_DESC_Q_MAP_SIZE 4
 
+/* Airtime (in us) a peer is credited with per round by the airtime scheduler */
+#define TX_AIRTIME_QUANTUM_US 2000
+/* Largest airtime (in us) taken from the TX done timestamps as valid */
+#define TX_AIRTIME_MAX_US 100000
+/* Rate (in Mbps) used to estimate the airtime when the timestamps are unusable */
+#define TX_AIRTIME_DEF_RATE_MBPS 54
+
+/* Default lower bound of the per-AC adaptive TX aggregation size */
+#define TX_AGG_MIN_DEF 1
+
+/* Pending frames of a peer/AC at which the OS TX queue of the AC is stopped */
+#define TX_PENDING_QLEN_HIGH_WM ((CONFIG_NRF700X_MAX_TX_PENDING_QLEN * 3) / 4)
+/* Pending frames of every peer/AC of a VIF below which the OS TX queue is resumed */
+#define TX_PENDING_QLEN_LOW_WM (CONFIG_NRF700X_MAX_TX_PENDING_QLEN / 4)
+
 /**
  * enum nrf_wifi_fmac_tx_status - The status of a TX operation performed by the
  *						RPU driver.
@@ -42,6 +59,9 @@ enum nrf_wifi_fmac_tx_status {
 struct tx_pkt_info {
 	void *pkt;
 	unsigned int peer_id;
+	unsigned int ac;
+	unsigned long submit_time_us;
+	unsigned int bytes;
 };
 
 struct tx_cmd_prep_info {
@@ -49,6 +69,12 @@ struct tx_cmd_prep_info {
 	struct nrf_wifi_tx_buff *config;
 };
 
+struct wakeup_q_info {
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx;
+	unsigned int ac;
+	int peer_id;
+};
+
 enum nrf_wifi_status tx_init(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx);
 
 void tx_deinit(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx);
@@ -59,6 +85,10 @@ enum nrf_wifi_status nrf_wifi_fmac_tx_done_event_process(struct nrf_wifi_fmac_de
 unsigned int tx_desc_get(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 			 int queue);
 
+void tx_desc_free(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+		  unsigned int desc,
+		  int queue);
+
 enum nrf_wifi_status tx_pending_process(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 					unsigned int desc,
 					unsigned int ac);
@@ -66,7 +96,15 @@ enum nrf_wifi_status tx_pending_process(struct nrf_wifi_fmac_dev_ctx *fmac_dev_c
 enum nrf_wifi_status tx_cmd_init(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 				 void *txq,
 				 int desc,
-				 int peer_id);
+				 int peer_id,
+				 bool batch);
+
+void flush_pend_q_bmp(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx);
+
+void tx_flow_ctrl_resume(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx);
+
+void tx_peer_flush(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+		   int peer_id);
 
 unsigned int tx_buff_req_free(struct nrf_wifi_fmac_dev_ctx *fmac_ctx,
 			      unsigned int desc,
@@ -119,6 +119,12 @@ static enum nrf_wifi_status nrf_wifi_fmac_init_rx(struct nrf_wifi_fmac_dev_ctx *
 		goto out;
 	}
 
+	status = nrf_wifi_fmac_rx_buf_cache_init(fmac_dev_ctx);
+
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		goto out;
+	}
+
 	for (desc_id = 0; desc_id < def_priv->num_rx_bufs; desc_id++) {
 		status = nrf_wifi_fmac_rx_cmd_send(fmac_dev_ctx,
 						   NRF_WIFI_FMAC_RX_CMD_TYPE_INIT,
@@ -199,6 +205,8 @@ static enum nrf_wifi_status nrf_wifi_fmac_deinit_rx(struct nrf_wifi_fmac_dev_ctx
 			       def_dev_ctx->rx_buf_info);
 
 	def_dev_ctx->rx_buf_info = NULL;
+
+	nrf_wifi_fmac_rx_buf_cache_deinit(fmac_dev_ctx);
 out:
 	return status;
 }
@@ -3565,9 +3573,11 @@ enum nrf_wifi_status nrf_wifi_fmac_prog_rx_buf_info(void *dev_ctx,
 		rx_buf_cmd->umac_hdr.cmd_evnt = NRF_WIFI_UMAC_CMD_CONFIG_RX_BUF;
 		nrf_wifi_osal_mem_cpy(fmac_dev_ctx->fpriv->opriv,
 				      &rx_buf_cmd->info,
-				      rx_buf,
+				      rx_buf_iter,
 				      rx_buff_prog_cnt * sizeof(struct nrf_wifi_rx_buf));
 
+		rx_buf_iter += rx_buff_prog_cnt;
+
 		rx_buf_cmd->rx_buf_num = rx_buff_prog_cnt;
 
 		status = umac_cmd_cfg(fmac_dev_ctx,
@@ -3591,7 +3601,7 @@ enum nrf_wifi_status nrf_wifi_fmac_prog_rx_buf_info(void *dev_ctx,
 		rx_buf_cmd->umac_hdr.cmd_evnt = NRF_WIFI_UMAC_CMD_CONFIG_RX_BUF;
 		nrf_wifi_osal_mem_cpy(fmac_dev_ctx->fpriv->opriv,
 				      &rx_buf_cmd->info,
-				      rx_buf + (MAX_BUFS_PER_CMD),
+				      rx_buf_iter,
 				      remained_buf_cnt * sizeof(struct nrf_wifi_rx_buf));
 
 		rx_buf_cmd->rx_buf_num = remained_buf_cnt;
@@ -37,9 +37,6 @@ enum nrf_wifi_status sap_client_ps_get_frames(struct nrf_wifi_fmac_dev_ctx *fmac
 	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 	def_priv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
 
-	nrf_wifi_osal_spinlock_take(fmac_dev_ctx->fpriv->opriv,
-				    def_dev_ctx->tx_config.tx_lock);
-
 	id = nrf_wifi_fmac_peer_get_id(fmac_dev_ctx, config->mac_addr);
 
 	if (id == -1) {
@@ -47,12 +44,12 @@ enum nrf_wifi_status sap_client_ps_get_frames(struct nrf_wifi_fmac_dev_ctx *fmac
 				      "%s: Invalid Peer_ID, Mac Addr =%pM\n",
 				      __func__,
 				      config->mac_addr);
-
-		nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->fpriv->opriv,
-					   def_dev_ctx->tx_config.tx_lock);
 		goto out;
 	}
 
+	nrf_wifi_osal_spinlock_take(fmac_dev_ctx->fpriv->opriv,
+				    def_dev_ctx->tx_config.ps_lock);
+
 
 	peer = &def_dev_ctx->tx_config.peers[id];
 	peer->ps_token_count = config->num_frames;
@@ -65,16 +62,24 @@ enum nrf_wifi_status sap_client_ps_get_frames(struct nrf_wifi_fmac_dev_ctx *fmac
 					 peer);
 	}
 
+	nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->fpriv->opriv,
+				   def_dev_ctx->tx_config.ps_lock);
+
 	for (ac = NRF_WIFI_FMAC_AC_VO; ac >= 0; --ac) {
+		nrf_wifi_osal_spinlock_take(fmac_dev_ctx->fpriv->opriv,
+					    def_dev_ctx->tx_config.ac_lock[ac]);
+
 		desc = tx_desc_get(fmac_dev_ctx, ac);
 
 		if (desc < def_priv->num_tx_tokens) {
 			tx_pending_process(fmac_dev_ctx, desc, ac);
 		}
+
+		nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->fpriv->opriv,
+					   def_dev_ctx->tx_config.ac_lock[ac]);
 	}
 
-	nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->fpriv->opriv,
-				   def_dev_ctx->tx_config.tx_lock);
+	flush_pend_q_bmp(fmac_dev_ctx);
 
 	status = NRF_WIFI_STATUS_SUCCESS;
 out:
@@ -104,9 +109,6 @@ enum nrf_wifi_status sap_client_update_pmmode(struct nrf_wifi_fmac_dev_ctx *fmac
 	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 	def_priv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
 
-	nrf_wifi_osal_spinlock_take(fmac_dev_ctx->fpriv->opriv,
-				    def_dev_ctx->tx_config.tx_lock);
-
 	id = nrf_wifi_fmac_peer_get_id(fmac_dev_ctx,
 				       config->mac_addr);
 
@@ -116,14 +118,15 @@ enum nrf_wifi_status sap_client_update_pmmode(struct nrf_wifi_fmac_dev_ctx *fmac
 				      __func__,
 				      config->mac_addr);
 
-		nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->fpriv->opriv,
-					   def_dev_ctx->tx_config.tx_lock);
-
 		goto out;
 	}
 
 
 	peer = &def_dev_ctx->tx_config.peers[id];
+
+	nrf_wifi_osal_spinlock_take(fmac_dev_ctx->fpriv->opriv,
+				    def_dev_ctx->tx_config.ps_lock);
+
 	peer->ps_state = config->sta_ps_state;
 
 	if (peer->ps_state == NRF_WIFI_CLIENT_ACTIVE) {
@@ -134,18 +137,31 @@ enum nrf_wifi_status sap_client_update_pmmode(struct nrf_wifi_fmac_dev_ctx *fmac
 						 wakeup_client_q,
 						 peer);
 		}
+	}
+
+	nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->fpriv->opriv,
+				   def_dev_ctx->tx_config.ps_lock);
 
+	if (peer->ps_state == NRF_WIFI_CLIENT_ACTIVE) {
 		for (ac = NRF_WIFI_FMAC_AC_VO; ac >= 0; --ac) {
+			nrf_wifi_osal_spinlock_take(fmac_dev_ctx->fpriv->opriv,
+						    def_dev_ctx->tx_config.ac_lock[ac]);
+
 			desc = tx_desc_get(fmac_dev_ctx, ac);
 
 			if (desc < def_priv->num_tx_tokens) {
 				tx_pending_process(fmac_dev_ctx, desc, ac);
 			}
+
+			nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->fpriv->opriv,
+						   def_dev_ctx->tx_config.ac_lock[ac]);
 		}
-	}
 
-	nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->fpriv->opriv,
-				   def_dev_ctx->tx_config.tx_lock);
+		flush_pend_q_bmp(fmac_dev_ctx);
+	} else {
+		/* The backlog of the client no longer holds the OS queues */
+		tx_flow_ctrl_resume(fmac_dev_ctx);
+	}
 
 	status = NRF_WIFI_STATUS_SUCCESS;
 
@@ -1190,6 +1190,56 @@ err:
 	return NRF_WIFI_STATUS_FAIL;
 }
 
+
+enum nrf_wifi_status nrf_wifi_fmac_set_irq_mod(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+					       unsigned int poll_thresh,
+					       unsigned int poll_budget,
+					       unsigned int poll_usecs)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+
+	if (!fmac_dev_ctx) {
+		goto out;
+	}
+
+	status = nrf_wifi_hal_irq_mod_set(fmac_dev_ctx->hal_dev_ctx,
+					  poll_thresh,
+					  poll_budget,
+					  poll_usecs);
+
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_osal_log_err(fmac_dev_ctx->fpriv->opriv,
+				      "%s: Configuring interrupt moderation failed\n",
+				      __func__);
+		goto out;
+	}
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_fmac_set_irq_threaded(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+						    bool threaded)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+
+	if (!fmac_dev_ctx) {
+		goto out;
+	}
+
+	status = nrf_wifi_hal_irq_threaded_set(fmac_dev_ctx->hal_dev_ctx,
+					       threaded);
+
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_osal_log_err(fmac_dev_ctx->fpriv->opriv,
+				      "%s: Configuring threaded interrupt handling failed\n",
+				      __func__);
+		goto out;
+	}
+out:
+	return status;
+}
+
 #ifdef CONFIG_NRF700X_UTIL
 enum nrf_wifi_status nrf_wifi_fmac_set_tx_rate(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 					       unsigned char rate_flag,
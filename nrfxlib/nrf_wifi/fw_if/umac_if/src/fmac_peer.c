@@ -13,11 +13,74 @@
 #include "fmac_peer.h"
 #include "host_rpu_umac_if.h"
 #include "fmac_util.h"
+#include "fmac_tx.h"
+
+static unsigned int peer_hash_idx(const unsigned char *mac_addr)
+{
+	/* The NIC specific part of the address has the most entropy */
+	return (mac_addr[5] ^ (mac_addr[4] << 1) ^ (mac_addr[3] << 2)) &
+		(PEER_HASH_SIZE - 1);
+}
+
+
+static unsigned int peer_hash_insert(unsigned int hash,
+				     const unsigned char *mac_addr,
+				     int peer_id)
+{
+	unsigned int idx = 0;
+	unsigned int i = 0;
+
+	idx = peer_hash_idx(mac_addr);
+
+	for (i = 0; i < PEER_HASH_SIZE; i++) {
+		if (!((hash >> (idx * PEER_HASH_SLOT_BITS)) & PEER_HASH_SLOT_MASK)) {
+			return hash | ((peer_id + 1) << (idx * PEER_HASH_SLOT_BITS));
+		}
+
+		idx = (idx + 1) & (PEER_HASH_SIZE - 1);
+	}
+
+	return hash;
+}
+
+
+/* With at most MAX_PEERS entries rebuilding is cheaper than keeping
+ * tombstones around for removed peers. The new table is built aside and
+ * published with one store, so a lockless lookup sees either the old or
+ * the new table and never a partially filled one. The peer must be fully
+ * set up before calling this, the release orders it before the table.
+ */
+static void peer_hash_rebuild(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	int i = 0;
+	unsigned int hash = 0;
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	for (i = 0; i < MAX_PEERS; i++) {
+		if (def_dev_ctx->tx_config.peers[i].peer_id == -1) {
+			continue;
+		}
+
+		hash = peer_hash_insert(hash,
+					def_dev_ctx->tx_config.peers[i].ra_addr,
+					i);
+	}
+
+	__atomic_store_n(&def_dev_ctx->tx_config.peer_hash,
+			 hash,
+			 __ATOMIC_RELEASE);
+}
+
 
 int nrf_wifi_fmac_peer_get_id(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 			      const unsigned char *mac_addr)
 {
-	int i;
+	unsigned int idx = 0;
+	unsigned int i = 0;
+	unsigned int hash = 0;
+	unsigned char slot = 0;
 	struct peers_info *peer;
 	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
 
@@ -27,17 +90,39 @@ int nrf_wifi_fmac_peer_get_id(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 		return MAX_PEERS;
 	}
 
-	for (i = 0; i < MAX_PEERS; i++) {
-		peer = &def_dev_ctx->tx_config.peers[i];
-		if (peer->peer_id == -1) {
-			continue;
+	/* Mostly a single peer in STA mode */
+	peer = &def_dev_ctx->tx_config.peers[def_dev_ctx->tx_config.last_peer_id];
+
+	if ((peer->peer_id != -1) &&
+	    nrf_wifi_util_ether_addr_equal(mac_addr,
+					   (void *)peer->ra_addr)) {
+		return peer->peer_id;
+	}
+
+	hash = __atomic_load_n(&def_dev_ctx->tx_config.peer_hash,
+			       __ATOMIC_ACQUIRE);
+
+	idx = peer_hash_idx(mac_addr);
+
+	for (i = 0; i < PEER_HASH_SIZE; i++) {
+		slot = (hash >> (idx * PEER_HASH_SLOT_BITS)) & PEER_HASH_SLOT_MASK;
+
+		if (!slot) {
+			break;
 		}
 
-		if ((nrf_wifi_util_ether_addr_equal(mac_addr,
-						    (void *)peer->ra_addr))) {
+		peer = &def_dev_ctx->tx_config.peers[slot - 1];
+
+		if ((peer->peer_id != -1) &&
+		    nrf_wifi_util_ether_addr_equal(mac_addr,
+						   (void *)peer->ra_addr)) {
+			def_dev_ctx->tx_config.last_peer_id = slot - 1;
 			return peer->peer_id;
 		}
+
+		idx = (idx + 1) & (PEER_HASH_SIZE - 1);
 	}
+
 	return -1;
 }
 
@@ -79,6 +164,11 @@ int nrf_wifi_fmac_peer_add(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 			peer->peer_id = i;
 			peer->is_legacy = is_legacy;
 			peer->qos_supported = qos_supported;
+			peer_hash_rebuild(fmac_dev_ctx);
+			nrf_wifi_osal_mem_set(fmac_dev_ctx->fpriv->opriv,
+					      def_dev_ctx->tx_config.airtime_deficit[i],
+					      0,
+					      sizeof(def_dev_ctx->tx_config.airtime_deficit[i]));
 			if (vif_ctx->if_type == NRF_WIFI_IFTYPE_AP) {
 				hal_rpu_mem_write(fmac_dev_ctx->hal_dev_ctx,
 						  (RPU_MEM_UMAC_PEND_Q_BMP +
@@ -111,6 +201,13 @@ void nrf_wifi_fmac_peer_remove(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 	vif_ctx = def_dev_ctx->vif_ctx[if_idx];
 	peer = &def_dev_ctx->tx_config.peers[peer_id];
 
+	/* Take the peer out of the lookup table before wiping it */
+	peer->peer_id = -1;
+	peer_hash_rebuild(fmac_dev_ctx);
+
+	/* Frames still held for the peer will never be sent */
+	tx_peer_flush(fmac_dev_ctx, peer_id);
+
 	nrf_wifi_osal_mem_set(fmac_dev_ctx->fpriv->opriv,
 			      peer,
 			      0x0,
@@ -124,6 +221,9 @@ void nrf_wifi_fmac_peer_remove(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 				  peer->ra_addr,
 				  NRF_WIFI_FMAC_ETH_ADDR_LEN);
 	}
+
+	/* The removed peer may have been the one holding the OS queues back */
+	tx_flow_ctrl_resume(fmac_dev_ctx);
 }
 
 
@@ -140,9 +240,20 @@ void nrf_wifi_fmac_peers_flush(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 	vif_ctx = def_dev_ctx->vif_ctx[if_idx];
 	def_dev_ctx->tx_config.peers[MAX_PEERS].peer_id = -1;
 
+	/* Take the peers out of the lookup table before wiping them */
+	for (i = 0; i < MAX_PEERS; i++) {
+		peer = &def_dev_ctx->tx_config.peers[i];
+		if (peer->if_idx == if_idx) {
+			peer->peer_id = -1;
+		}
+	}
+
+	peer_hash_rebuild(fmac_dev_ctx);
+
 	for (i = 0; i < MAX_PEERS; i++) {
 		peer = &def_dev_ctx->tx_config.peers[i];
 		if (peer->if_idx == if_idx) {
+			tx_peer_flush(fmac_dev_ctx, i);
 
 			nrf_wifi_osal_mem_set(fmac_dev_ctx->fpriv->opriv,
 					      peer,
@@ -159,4 +270,6 @@ void nrf_wifi_fmac_peers_flush(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 			}
 		}
 	}
+
+	tx_flow_ctrl_resume(fmac_dev_ctx);
 }
@@ -12,6 +12,7 @@
 #include "hal_api.h"
 #include "fmac_rx.h"
 #include "fmac_util.h"
+#include "queue.h"
 #ifdef SOC_WEZEN
 #ifdef CMD_RX_BUFF
 #include "fmac_api.h"
@@ -25,27 +26,152 @@ nrf_wifi_fmac_map_desc_to_pool(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 			       struct nrf_wifi_fmac_rx_pool_map_info *pool_info)
 {
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
-	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
 	struct nrf_wifi_fmac_priv_def *def_priv = NULL;
 	unsigned int pool_id = 0;
+	unsigned int i = 0;
 
-	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 	def_priv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
 
+	if (desc_id >= def_priv->num_rx_bufs) {
+		goto out;
+	}
+
+	/* The pools own consecutive ranges of descs starting at rx_desc[], so
+	 * the pool of a desc is the number of pool starts (after the first)
+	 * at or below it. Empty pools share their start with the next pool and
+	 * are skipped over. This is computed without branching on the pools.
+	 */
+	for (i = 1; i < MAX_NUM_OF_RX_QUEUES; i++) {
+		pool_id += (desc_id >= def_priv->rx_desc[i]);
+	}
+
+	pool_info->pool_id = pool_id;
+	pool_info->buf_id = (desc_id - def_priv->rx_desc[pool_id]);
+
+	status = NRF_WIFI_STATUS_SUCCESS;
+out:
+	return status;
+}
+
+enum nrf_wifi_status nrf_wifi_fmac_rx_buf_cache_init(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+	unsigned int pool_id = 0;
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
 	for (pool_id = 0; pool_id < MAX_NUM_OF_RX_QUEUES; pool_id++) {
-		if ((desc_id >= def_priv->rx_desc[pool_id]) &&
-		    (desc_id < (def_priv->rx_desc[pool_id] +
-				def_priv->rx_buf_pools[pool_id].num_bufs))) {
-			pool_info->pool_id = pool_id;
-			pool_info->buf_id = (desc_id - def_priv->rx_desc[pool_id]);
-			status = NRF_WIFI_STATUS_SUCCESS;
+		def_dev_ctx->rx_buf_free_q[pool_id] = nrf_wifi_utils_q_alloc(fmac_dev_ctx->fpriv->opriv);
+
+		if (!def_dev_ctx->rx_buf_free_q[pool_id]) {
+			nrf_wifi_osal_log_err(fmac_dev_ctx->fpriv->opriv,
+					      "%s: Unable to allocate RX buffer free queue\n",
+					      __func__);
 			goto out;
 		}
 	}
+
+	status = NRF_WIFI_STATUS_SUCCESS;
 out:
 	return status;
 }
 
+
+void nrf_wifi_fmac_rx_buf_cache_deinit(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+	unsigned int pool_id = 0;
+	void *nwb = NULL;
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	for (pool_id = 0; pool_id < MAX_NUM_OF_RX_QUEUES; pool_id++) {
+		if (!def_dev_ctx->rx_buf_free_q[pool_id]) {
+			continue;
+		}
+
+		while ((nwb = nrf_wifi_utils_q_dequeue(fmac_dev_ctx->fpriv->opriv,
+						       def_dev_ctx->rx_buf_free_q[pool_id]))) {
+			nrf_wifi_osal_nbuf_free(fmac_dev_ctx->fpriv->opriv,
+						nwb);
+		}
+
+		nrf_wifi_utils_q_free(fmac_dev_ctx->fpriv->opriv,
+				      def_dev_ctx->rx_buf_free_q[pool_id]);
+
+		def_dev_ctx->rx_buf_free_q[pool_id] = NULL;
+	}
+}
+
+
+/* Get a buffer for refilling a desc of a pool, preferring one which was
+ * recycled over a fresh allocation.
+ */
+static void *rx_buf_get(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+			unsigned int pool_id,
+			unsigned int buf_len)
+{
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+	void *nwb = NULL;
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	if (def_dev_ctx->rx_buf_free_q[pool_id]) {
+		nwb = nrf_wifi_utils_q_dequeue(fmac_dev_ctx->fpriv->opriv,
+					       def_dev_ctx->rx_buf_free_q[pool_id]);
+	}
+
+	if (nwb) {
+		def_dev_ctx->host_stats.rx_buf_recycle_hits[pool_id]++;
+		goto out;
+	}
+
+	def_dev_ctx->host_stats.rx_buf_recycle_misses[pool_id]++;
+
+	nwb = nrf_wifi_osal_nbuf_alloc(fmac_dev_ctx->fpriv->opriv,
+				       buf_len);
+out:
+	return nwb;
+}
+
+
+/* Return a buffer which was not handed over to the OS (e.g. a dropped
+ * frame or one consumed by the driver) to the free queue of its pool.
+ */
+static void rx_buf_recycle(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+			   unsigned int pool_id,
+			   void *nwb)
+{
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+	struct nrf_wifi_fmac_priv_def *def_priv = NULL;
+	void *free_q = NULL;
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	def_priv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
+
+	free_q = def_dev_ctx->rx_buf_free_q[pool_id];
+
+	if (!free_q ||
+	    (nrf_wifi_utils_q_len(fmac_dev_ctx->fpriv->opriv,
+				  free_q) >= def_priv->rx_buf_pools[pool_id].num_bufs)) {
+		nrf_wifi_osal_nbuf_free(fmac_dev_ctx->fpriv->opriv,
+					nwb);
+		return;
+	}
+
+	nrf_wifi_osal_nbuf_reset(fmac_dev_ctx->fpriv->opriv,
+				 nwb);
+
+	if (nrf_wifi_utils_q_enqueue(fmac_dev_ctx->fpriv->opriv,
+				     free_q,
+				     nwb) != NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_osal_nbuf_free(fmac_dev_ctx->fpriv->opriv,
+					nwb);
+	}
+}
+
+
 #ifdef SOC_WEZEN
 #ifdef CMD_RX_BUFF
 unsigned long nrf_wifi_fmac_get_rx_buf_map_addr(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
@@ -130,8 +256,9 @@ enum nrf_wifi_status nrf_wifi_fmac_rx_cmd_send(struct nrf_wifi_fmac_dev_ctx *fma
 			goto out;
 		}
 
-		nwb = (unsigned long)nrf_wifi_osal_nbuf_alloc(fmac_dev_ctx->fpriv->opriv,
-							      buf_len);
+		nwb = (unsigned long)rx_buf_get(fmac_dev_ctx,
+						pool_info.pool_id,
+						buf_len);
 
 		if (!nwb) {
 			nrf_wifi_osal_log_err(fmac_dev_ctx->fpriv->opriv,
@@ -177,7 +304,8 @@ enum nrf_wifi_status nrf_wifi_fmac_rx_cmd_send(struct nrf_wifi_fmac_dev_ctx *fma
 						    &rx_cmd,
 						    sizeof(rx_cmd),
 						    desc_id,
-						    pool_info.pool_id);
+						    pool_info.pool_id,
+						    false);
 #endif /* !CMD_RX_BUFF */
 #else
 		status = nrf_wifi_hal_data_cmd_send(fmac_dev_ctx->hal_dev_ctx,
@@ -185,7 +313,8 @@ enum nrf_wifi_status nrf_wifi_fmac_rx_cmd_send(struct nrf_wifi_fmac_dev_ctx *fma
 						    &rx_cmd,
 						    sizeof(rx_cmd),
 						    desc_id,
-						    pool_info.pool_id);
+						    pool_info.pool_id,
+						    false);
 #endif /* SOC_WEZEN */
 	} else if (cmd_type == NRF_WIFI_FMAC_RX_CMD_TYPE_DEINIT) {
 		/* TODO: Need to initialize a command and send it to LMAC
@@ -229,6 +358,82 @@ out:
 }
 
 
+/* Re-arm the descs consumed by an RX event in one pass. Under CMD_RX_BUFF
+ * the new buffers are also programmed to the UMAC together, rather than
+ * one command per frame.
+ */
+static enum nrf_wifi_status rx_bufs_rearm(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+					  unsigned int num_descs)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_SUCCESS;
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+	unsigned int desc_id = 0;
+	unsigned int i = 0;
+#ifdef SOC_WEZEN
+#ifdef CMD_RX_BUFF
+	enum nrf_wifi_status prog_status = NRF_WIFI_STATUS_FAIL;
+	unsigned int buf_addr = 0;
+	unsigned int num_armed = 0;
+#endif /* CMD_RX_BUFF */
+#endif /* SOC_WEZEN */
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	for (i = 0; i < num_descs; i++) {
+		desc_id = def_dev_ctx->rx_refill_desc[i];
+
+		status = nrf_wifi_fmac_rx_cmd_send(fmac_dev_ctx,
+						   NRF_WIFI_FMAC_RX_CMD_TYPE_INIT,
+						   desc_id);
+
+		if (status != NRF_WIFI_STATUS_SUCCESS) {
+			nrf_wifi_osal_log_err(fmac_dev_ctx->fpriv->opriv,
+					      "%s: nrf_wifi_fmac_rx_cmd_send failed\n",
+					      __func__);
+			goto out;
+		}
+#ifdef SOC_WEZEN
+#ifdef CMD_RX_BUFF
+		buf_addr = (unsigned int)nrf_wifi_fmac_get_rx_buf_map_addr(fmac_dev_ctx,
+									   desc_id);
+
+		if (!buf_addr) {
+			nrf_wifi_osal_log_err(fmac_dev_ctx->fpriv->opriv,
+					      "%s: UMAC rx buff not mapped for desc_id = %d\n",
+					      __func__,
+					      desc_id);
+			status = NRF_WIFI_STATUS_FAIL;
+			goto out;
+		}
+
+		def_dev_ctx->rx_buf_ipc[num_armed].skb_pointer = buf_addr;
+		def_dev_ctx->rx_buf_ipc[num_armed].skb_desc_no = desc_id;
+		num_armed++;
+#endif /* CMD_RX_BUFF */
+#endif /* SOC_WEZEN */
+	}
+out:
+#ifdef SOC_WEZEN
+#ifdef CMD_RX_BUFF
+	/* Hand over whatever could be re-armed, even on failure */
+	if (num_armed) {
+		prog_status = nrf_wifi_fmac_prog_rx_buf_info(fmac_dev_ctx,
+							     def_dev_ctx->rx_buf_ipc,
+							     num_armed);
+
+		if (prog_status != NRF_WIFI_STATUS_SUCCESS) {
+			nrf_wifi_osal_log_err(fmac_dev_ctx->fpriv->opriv,
+					      "%s: UMAC rx buff programming failed\n",
+					      __func__);
+			status = NRF_WIFI_STATUS_FAIL;
+		}
+	}
+#endif /* CMD_RX_BUFF */
+#endif /* SOC_WEZEN */
+	return status;
+}
+
+
 #ifdef CONFIG_NRF700X_RX_WQ_ENABLED
 void nrf_wifi_fmac_rx_tasklet(void *data)
 {
@@ -285,12 +490,9 @@ enum nrf_wifi_status nrf_wifi_fmac_rx_event_process(struct nrf_wifi_fmac_dev_ctx
 #endif /* CONFIG_NRF700X_STA_MODE */
 	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
 	struct nrf_wifi_fmac_priv_def *def_priv = NULL;
-#ifdef SOC_WEZEN
-#ifdef CMD_RX_BUFF
-	unsigned int buf_addr = 0;
-	struct nrf_wifi_rx_buf *rx_buf_ipc = NULL, *rx_buf_info_iter = NULL;
-#endif /* CMD_RX_BUFF */
-#endif /* SOC_WEZEN */
+	unsigned int num_refill = 0;
+	enum nrf_wifi_status refill_status = NRF_WIFI_STATUS_FAIL;
+
 	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 	def_priv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
 
@@ -301,13 +503,6 @@ enum nrf_wifi_status nrf_wifi_fmac_rx_event_process(struct nrf_wifi_fmac_dev_ctx
 							     config->signal);
 #endif /* CONFIG_NRF700X_STA_MODE */
 	num_pkts = config->rx_pkt_cnt;
-#ifdef SOC_WEZEN
-#ifdef CMD_RX_BUFF
-	rx_buf_ipc = nrf_wifi_osal_mem_zalloc(fmac_dev_ctx->fpriv->opriv,
-					      num_pkts * sizeof(struct nrf_wifi_rx_buf));
-	rx_buf_info_iter = rx_buf_ipc;
-#endif /* CMD_RX_BUFF */
-#endif /* SOC_WEZEN */
 
 	for (i = 0; i < num_pkts; i++) {
 		desc_id = config->rx_buff_info[i].descriptor_id;
@@ -360,6 +555,9 @@ enum nrf_wifi_status nrf_wifi_fmac_rx_event_process(struct nrf_wifi_fmac_dev_ctx
 		rx_buf_info->nwb = 0;
 		rx_buf_info->mapped = false;
 
+		/* The desc has to be re-armed whatever happens to the frame */
+		def_dev_ctx->rx_refill_desc[num_refill++] = desc_id;
+
 		if (config->rx_pkt_type == NRF_WIFI_RX_PKT_DATA) {
 #ifdef CONFIG_NRF700X_STA_MODE
 			switch (config->rx_buff_info[i].pkt_type) {
@@ -403,6 +601,9 @@ enum nrf_wifi_status nrf_wifi_fmac_rx_event_process(struct nrf_wifi_fmac_dev_ctx
 						      "%s: Invalid pkt_type=%d\n",
 						      __func__,
 						      (config->rx_buff_info[i].pkt_type));
+				rx_buf_recycle(fmac_dev_ctx,
+					       pool_info.pool_id,
+					       nwb);
 				status = NRF_WIFI_STATUS_FAIL;
 				goto out;
 			}
@@ -417,67 +618,41 @@ enum nrf_wifi_status nrf_wifi_fmac_rx_event_process(struct nrf_wifi_fmac_dev_ctx
 							config->frequency,
 							config->signal);
 #endif /* CONFIG_WIFI_MGMT_RAW_SCAN_RESULTS */
-			nrf_wifi_osal_nbuf_free(fmac_dev_ctx->fpriv->opriv,
-						nwb);
+			/* The frame has been consumed, reuse the buffer */
+			rx_buf_recycle(fmac_dev_ctx,
+				       pool_info.pool_id,
+				       nwb);
 		} else {
 			nrf_wifi_osal_log_err(fmac_dev_ctx->fpriv->opriv,
 					      "%s: Invalid frame type recd %d\n",
 					      __func__,
 					      config->rx_pkt_type);
+			rx_buf_recycle(fmac_dev_ctx,
+				       pool_info.pool_id,
+				       nwb);
 			status = NRF_WIFI_STATUS_FAIL;
 			goto out;
 		}
 
-		status = nrf_wifi_fmac_rx_cmd_send(fmac_dev_ctx,
-						   NRF_WIFI_FMAC_RX_CMD_TYPE_INIT,
-						   desc_id);
+		if (num_refill == MAX_RX_BUFS_PER_EVNT) {
+			status = rx_bufs_rearm(fmac_dev_ctx,
+					       num_refill);
+			num_refill = 0;
 
-		if (status != NRF_WIFI_STATUS_SUCCESS) {
-			nrf_wifi_osal_log_err(fmac_dev_ctx->fpriv->opriv,
-					      "%s: nrf_wifi_fmac_rx_cmd_send failed\n",
-					      __func__);
-			goto out;
+			if (status != NRF_WIFI_STATUS_SUCCESS) {
+				goto out;
+			}
 		}
-#ifdef SOC_WEZEN
-#ifdef CMD_RX_BUFF
-                buf_addr = (unsigned int) nrf_wifi_fmac_get_rx_buf_map_addr(fmac_dev_ctx, desc_id);
-                if (buf_addr) {
-                        rx_buf_info_iter->skb_pointer = buf_addr;
-                        rx_buf_info_iter->skb_desc_no = desc_id;
-			rx_buf_info_iter++;
-                } else {
-                        nrf_wifi_osal_log_err(fmac_dev_ctx->fpriv->opriv,
-                                              "%s: UMAC rx buff not mapped\
-                                               for desc_id = %d\n", desc_id,
-                                              __func__);
-			status = NRF_WIFI_STATUS_FAIL;
-			goto out;
-                }
-#endif /* CMD_RX_BUFF */
-#endif /* SOC_WEZEN */
 	}
-#ifdef SOC_WEZEN
-#ifdef CMD_RX_BUFF
-	status = nrf_wifi_fmac_prog_rx_buf_info(fmac_dev_ctx,
-                                                rx_buf_ipc,
-                                                num_pkts);
-        if (status != NRF_WIFI_STATUS_SUCCESS) {
-                nrf_wifi_osal_log_err(fmac_dev_ctx->fpriv->opriv,
-                                      "%s: UMAC rx buff\
-                                      programming failed \n",
-                                      __func__);
-		status = NRF_WIFI_STATUS_FAIL;
-		goto out;
-        } else {
-                nrf_wifi_osal_log_dbg(fmac_dev_ctx->fpriv->opriv,
-                                         "%s: UMAC rx buff refill\
-                                          programmed for num_buffs= %d \n",
-                                          __func__, num_pkts);
-		nrf_wifi_osal_mem_free(fmac_dev_ctx->fpriv->opriv,
-				       rx_buf_ipc);
-	}
-#endif /* CMD_RX_BUFF */
-#endif /* SOC_WEZEN */
 out:
+	if (num_refill) {
+		refill_status = rx_bufs_rearm(fmac_dev_ctx,
+					      num_refill);
+
+		if (refill_status != NRF_WIFI_STATUS_SUCCESS) {
+			status = refill_status;
+		}
+	}
+
 	return status;
 }
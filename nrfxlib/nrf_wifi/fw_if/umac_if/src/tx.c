@@ -18,6 +18,15 @@
 #include "hal_mem.h"
 #include "fmac_util.h"
 
+/* TX done latency (in us) above which the aggregation size of an AC is reduced */
+static const unsigned int tx_agg_latency_target_us[NRF_WIFI_FMAC_AC_MAX] = {
+	[NRF_WIFI_FMAC_AC_BK] = 40000,
+	[NRF_WIFI_FMAC_AC_BE] = 20000,
+	[NRF_WIFI_FMAC_AC_VI] = 10000,
+	[NRF_WIFI_FMAC_AC_VO] = 4000,
+	[NRF_WIFI_FMAC_AC_MC] = 20000,
+};
+
 static bool is_twt_emergency_pkt(struct nrf_wifi_osal_priv *opriv, void *nwb)
 {
 	unsigned char priority = nrf_wifi_osal_nbuf_get_priority(opriv, nwb);
@@ -37,6 +46,48 @@ static bool can_xmit(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 	    def_dev_ctx->twt_sleep_status == NRF_WIFI_FMAC_TWT_STATE_AWAKE;
 }
 
+/* Report the completed frames to the OS, so that it can account the bytes
+ * in flight per queue (e.g. BQL). Frames dropped after having been accepted
+ * from the OS are reported as completed too. Not to be called with an AC
+ * lock held, the OS may need to serialize with its own xmit path.
+ */
+static void tx_done_notify(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+			   unsigned int peer_id,
+			   unsigned int ac,
+			   unsigned int pkts,
+			   unsigned int bytes)
+{
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+	struct nrf_wifi_fmac_priv_def *def_priv = NULL;
+	struct nrf_wifi_fmac_vif_ctx *vif_ctx = NULL;
+	unsigned char if_idx = 0;
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	def_priv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
+
+	if (!def_priv->callbk_fns.tx_done_callbk_fn || !pkts) {
+		return;
+	}
+
+	if_idx = def_dev_ctx->tx_config.peers[peer_id].if_idx;
+
+	if (if_idx >= MAX_NUM_VIFS) {
+		return;
+	}
+
+	vif_ctx = def_dev_ctx->vif_ctx[if_idx];
+
+	if (!vif_ctx) {
+		return;
+	}
+
+	def_priv->callbk_fns.tx_done_callbk_fn(vif_ctx->os_vif_ctx,
+					       ac,
+					       pkts,
+					       bytes);
+}
+
+
 /* Set the coresponding bit of access category.
  * First 4 bits(0 to 3) represenst first spare desc access cateogories
  * Second 4 bits(4 to 7) represenst second spare desc access cateogories and so on
@@ -160,33 +211,131 @@ enum nrf_wifi_status update_pend_q_bmp(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ct
 
 		len = nrf_wifi_utils_q_len(fmac_dev_ctx->fpriv->opriv, pend_pkt_q);
 
+		/* The bitmap is shared by all the ACs of the peer. Only the
+		 * host copy is updated here, the RPU copy is updated once per
+		 * processing pass by flush_pend_q_bmp.
+		 */
+		nrf_wifi_osal_spinlock_take(fmac_dev_ctx->fpriv->opriv,
+					    def_dev_ctx->tx_config.peer_lock[peer_id]);
+
 		if (len == 0) {
 			*bmp = *bmp & ~(1 << ac);
 		} else {
 			*bmp = *bmp | (1 << ac);
 		}
 
-		status = hal_rpu_mem_write(fmac_dev_ctx->hal_dev_ctx,
-					   (RPU_MEM_UMAC_PEND_Q_BMP +
-					    (sizeof(struct sap_pend_frames_bitmap) * peer_id) +
-					    NRF_WIFI_FMAC_ETH_ADDR_LEN),
-					   bmp,
-					   sizeof(unsigned char));
-	} else {
-		status = NRF_WIFI_STATUS_SUCCESS;
+		nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->fpriv->opriv,
+					   def_dev_ctx->tx_config.peer_lock[peer_id]);
 	}
+
+	status = NRF_WIFI_STATUS_SUCCESS;
 out:
 	return status;
 }
 
 
+void flush_pend_q_bmp(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	struct peers_info *peer = NULL;
+	int peer_id = 0;
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	for (peer_id = 0; peer_id < MAX_PEERS; peer_id++) {
+		peer = &def_dev_ctx->tx_config.peers[peer_id];
+
+		/* Unlocked check is fine, whoever changes the bitmap flushes
+		 * it at the end of its own pass.
+		 */
+		if (peer->pend_q_bmp == peer->pend_q_bmp_rpu) {
+			continue;
+		}
+
+		nrf_wifi_osal_spinlock_take(fmac_dev_ctx->fpriv->opriv,
+					    def_dev_ctx->tx_config.peer_lock[peer_id]);
+
+		if (peer->pend_q_bmp != peer->pend_q_bmp_rpu) {
+			if (hal_rpu_mem_write(fmac_dev_ctx->hal_dev_ctx,
+					      (RPU_MEM_UMAC_PEND_Q_BMP +
+					       (sizeof(struct sap_pend_frames_bitmap) * peer_id) +
+					       NRF_WIFI_FMAC_ETH_ADDR_LEN),
+					      &peer->pend_q_bmp,
+					      sizeof(unsigned char)) == NRF_WIFI_STATUS_SUCCESS) {
+				peer->pend_q_bmp_rpu = peer->pend_q_bmp;
+			}
+		}
+
+		nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->fpriv->opriv,
+					   def_dev_ctx->tx_config.peer_lock[peer_id]);
+	}
+}
+
+
+void tx_peer_flush(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+		   int peer_id)
+{
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+	void *pend_pkt_q = NULL;
+	void *nwb = NULL;
+	unsigned int pkts = 0;
+	unsigned int bytes = 0;
+	int ac = 0;
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	for (ac = 0; ac < NRF_WIFI_FMAC_AC_MAX; ac++) {
+		pkts = 0;
+		bytes = 0;
+
+		nrf_wifi_osal_spinlock_take(fmac_dev_ctx->fpriv->opriv,
+					    def_dev_ctx->tx_config.ac_lock[ac]);
+
+		pend_pkt_q = def_dev_ctx->tx_config.data_pending_txq[peer_id][ac];
+
+		while (nrf_wifi_utils_q_len(fmac_dev_ctx->fpriv->opriv,
+					    pend_pkt_q)) {
+			nwb = nrf_wifi_utils_q_dequeue(fmac_dev_ctx->fpriv->opriv,
+						       pend_pkt_q);
+
+			bytes += nrf_wifi_osal_nbuf_data_size(fmac_dev_ctx->fpriv->opriv,
+							      nwb);
+
+			nrf_wifi_osal_nbuf_free(fmac_dev_ctx->fpriv->opriv,
+						nwb);
+			pkts++;
+		}
+
+		update_pend_q_bmp(fmac_dev_ctx, ac, peer_id);
+
+		nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->fpriv->opriv,
+					   def_dev_ctx->tx_config.ac_lock[ac]);
+
+		/* The OS may take its TX locks, which nest outside the AC lock */
+		tx_done_notify(fmac_dev_ctx,
+			       peer_id,
+			       ac,
+			       pkts,
+			       bytes);
+	}
+}
+
+
+/* Index of the lowest set bit, bmp must be non-zero. */
+static inline unsigned int tx_desc_bmp_first(unsigned long long bmp)
+{
+	return __builtin_ctzll(bmp);
+}
+
+
 void tx_desc_free(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 		  unsigned int desc,
 		  int queue)
 {
 	struct nrf_wifi_fmac_priv *fpriv = NULL;
-	int bit = -1;
-	int pool_id = -1;
+	unsigned long long *bmp = NULL;
+	unsigned int num_rsvd_descs = 0;
+	unsigned int bit = 0;
 	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
 	struct nrf_wifi_fmac_priv_def *def_priv = NULL;
 
@@ -195,21 +344,42 @@ void tx_desc_free(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 	def_priv = wifi_fmac_priv(fpriv);
 
-	bit = (desc % TX_DESC_BUCKET_BOUND);
-	pool_id = (desc / TX_DESC_BUCKET_BOUND);
+	num_rsvd_descs = def_priv->num_tx_tokens_per_ac * NRF_WIFI_FMAC_AC_MAX;
 
-	if (!(def_dev_ctx->tx_config.buf_pool_bmp_p[pool_id] & (1 << bit))) {
-		return;
-	}
+	if (desc < num_rsvd_descs) {
+		bmp = &def_dev_ctx->tx_config.desc_free_bmp[desc % NRF_WIFI_FMAC_AC_MAX];
+		bit = (desc / NRF_WIFI_FMAC_AC_MAX);
+
+		/* Already free */
+		if (*bmp & (1ULL << bit)) {
+			return;
+		}
 
-	def_dev_ctx->tx_config.buf_pool_bmp_p[pool_id] &= (~(1 << bit));
+		*bmp |= (1ULL << bit);
+	} else if (desc < def_priv->num_tx_tokens) {
+		bmp = &def_dev_ctx->tx_config.spare_desc_free_bmp;
+		bit = (desc - num_rsvd_descs);
 
-	def_dev_ctx->tx_config.outstanding_descs[queue]--;
+		nrf_wifi_osal_spinlock_take(fpriv->opriv,
+					    def_dev_ctx->tx_config.spare_desc_lock);
+
+		if (*bmp & (1ULL << bit)) {
+			nrf_wifi_osal_spinlock_rel(fpriv->opriv,
+						   def_dev_ctx->tx_config.spare_desc_lock);
+			return;
+		}
+
+		*bmp |= (1ULL << bit);
 
-	if (desc >= (def_priv->num_tx_tokens_per_ac * NRF_WIFI_FMAC_AC_MAX)) {
 		clear_spare_desc_q_map(fmac_dev_ctx, desc, queue);
+
+		nrf_wifi_osal_spinlock_rel(fpriv->opriv,
+					   def_dev_ctx->tx_config.spare_desc_lock);
+	} else {
+		return;
 	}
 
+	def_dev_ctx->tx_config.outstanding_descs[queue]--;
 }
 
 
@@ -217,10 +387,9 @@ unsigned int tx_desc_get(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 			 int queue)
 {
 	struct nrf_wifi_fmac_priv *fpriv = NULL;
-	unsigned int cnt = 0;
-	int curr_bit = 0;
+	unsigned long long *bmp = NULL;
+	unsigned int bit = 0;
 	unsigned int desc = 0;
-	int pool_id = 0;
 	struct nrf_wifi_fmac_priv_def *def_priv = NULL;
 	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
 
@@ -230,61 +399,49 @@ unsigned int tx_desc_get(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 
 	desc = def_priv->num_tx_tokens;
 
-	/* First search for a reserved desc */
-
-	for (cnt = 0; cnt < def_priv->num_tx_tokens_per_ac; cnt++) {
-		curr_bit = ((queue + (NRF_WIFI_FMAC_AC_MAX * cnt)));
-		curr_bit = ((queue + (NRF_WIFI_FMAC_AC_MAX * cnt)) % TX_DESC_BUCKET_BOUND);
-		pool_id = ((queue + (NRF_WIFI_FMAC_AC_MAX * cnt)) / TX_DESC_BUCKET_BOUND);
+	/* First look for a reserved desc, the lowest free one is picked
+	 * to keep the same ordering as a linear search.
+	 */
+	bmp = &def_dev_ctx->tx_config.desc_free_bmp[queue];
 
-		if ((((def_dev_ctx->tx_config.buf_pool_bmp_p[pool_id] >>
-		       curr_bit)) & 1)) {
-			continue;
-		} else {
-			def_dev_ctx->tx_config.buf_pool_bmp_p[pool_id] |=
-				(1 << curr_bit);
-			desc = queue + (NRF_WIFI_FMAC_AC_MAX * cnt);
-			def_dev_ctx->tx_config.outstanding_descs[queue]++;
-			break;
-		}
+	if (*bmp) {
+		bit = tx_desc_bmp_first(*bmp);
+		*bmp &= ~(1ULL << bit);
+		desc = queue + (NRF_WIFI_FMAC_AC_MAX * bit);
+		def_dev_ctx->tx_config.outstanding_descs[queue]++;
+		goto out;
 	}
 
-	/* If reserved desc is not found search for a spare desc
-	 * (only for non beacon queues)
-	 */
-	if (cnt == def_priv->num_tx_tokens_per_ac) {
-		for (desc = def_priv->num_tx_tokens_per_ac * NRF_WIFI_FMAC_AC_MAX;
-		     desc < def_priv->num_tx_tokens;
-		     desc++) {
-			curr_bit = (desc % TX_DESC_BUCKET_BOUND);
-			pool_id = (desc / TX_DESC_BUCKET_BOUND);
-
-			if ((def_dev_ctx->tx_config.buf_pool_bmp_p[pool_id] >> curr_bit) & 1) {
-				continue;
-			} else {
-				def_dev_ctx->tx_config.buf_pool_bmp_p[pool_id] |=
-					(1 << curr_bit);
-				def_dev_ctx->tx_config.outstanding_descs[queue]++;
-				/* Keep a note which queue has been assigned the
-				 * spare desc. Need for processing of TX_DONE
-				 * event as queue number is not being provided
-				 * by UMAC.
-				 * First nibble epresent first spare desc
-				 * (B3B2B1B0: VO-VI-BE-BK)
-				 * Second nibble represent second spare desc
-				 * (B7B6B5B4 : V0-VI-BE-BK)
-				 * Third nibble represent second spare desc
-				 * (B11B10B9B8 : V0-VI-BE-BK)
-				 * Fourth nibble represent second spare desc
-				 * (B15B14B13B12 : V0-VI-BE-BK)
-				 */
-				set_spare_desc_q_map(fmac_dev_ctx, desc, queue);
-				break;
-			}
-		}
+	/* If reserved desc is not found look for a spare desc */
+	bmp = &def_dev_ctx->tx_config.spare_desc_free_bmp;
+
+	nrf_wifi_osal_spinlock_take(fpriv->opriv,
+				    def_dev_ctx->tx_config.spare_desc_lock);
+
+	if (*bmp) {
+		bit = tx_desc_bmp_first(*bmp);
+		*bmp &= ~(1ULL << bit);
+		desc = (def_priv->num_tx_tokens_per_ac * NRF_WIFI_FMAC_AC_MAX) + bit;
+		def_dev_ctx->tx_config.outstanding_descs[queue]++;
+		/* Keep a note which queue has been assigned the
+		 * spare desc. Need for processing of TX_DONE
+		 * event as queue number is not being provided
+		 * by UMAC.
+		 * First nibble epresent first spare desc
+		 * (B3B2B1B0: VO-VI-BE-BK)
+		 * Second nibble represent second spare desc
+		 * (B7B6B5B4 : V0-VI-BE-BK)
+		 * Third nibble represent second spare desc
+		 * (B11B10B9B8 : V0-VI-BE-BK)
+		 * Fourth nibble represent second spare desc
+		 * (B15B14B13B12 : V0-VI-BE-BK)
+		 */
+		set_spare_desc_q_map(fmac_dev_ctx, desc, queue);
 	}
 
-
+	nrf_wifi_osal_spinlock_rel(fpriv->opriv,
+				   def_dev_ctx->tx_config.spare_desc_lock);
+out:
 	return desc;
 }
 
@@ -336,96 +493,193 @@ int tx_aggr_check(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 }
 
 
-int get_peer_from_wakeup_q(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
-			   unsigned int ac)
+static enum nrf_wifi_status wakeup_q_callbk_fn(void *callbk_data,
+						void *data)
 {
-	int peer_id = -1;
+	struct wakeup_q_info *info = NULL;
 	struct peers_info *peer = NULL;
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
 	void *pend_q = NULL;
-	unsigned int pend_q_len;
-	void *client_q = NULL;
-	void *list_node = NULL;
+	unsigned int pend_q_len = 0;
+
+	info = (struct wakeup_q_info *)callbk_data;
+	peer = (struct peers_info *)data;
+
+	if (peer == NULL || !peer->ps_token_count) {
+		return NRF_WIFI_STATUS_SUCCESS;
+	}
+
+	def_dev_ctx = wifi_dev_priv(info->fmac_dev_ctx);
+
+	pend_q = def_dev_ctx->tx_config.data_pending_txq[peer->peer_id][info->ac];
+	pend_q_len = nrf_wifi_utils_q_len(info->fmac_dev_ctx->fpriv->opriv, pend_q);
+
+	if (!pend_q_len) {
+		return NRF_WIFI_STATUS_SUCCESS;
+	}
+
+	peer->ps_token_count--;
+	info->peer_id = peer->peer_id;
+
+	/* Found a peer, stop the traversal */
+	return NRF_WIFI_STATUS_FAIL;
+}
+
+
+int get_peer_from_wakeup_q(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+			   unsigned int ac)
+{
+	struct wakeup_q_info info;
 	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
 
 	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 
-	client_q = def_dev_ctx->tx_config.wakeup_client_q;
+	info.fmac_dev_ctx = fmac_dev_ctx;
+	info.ac = ac;
+	info.peer_id = -1;
+
+	nrf_wifi_osal_spinlock_take(fmac_dev_ctx->fpriv->opriv,
+				    def_dev_ctx->tx_config.ps_lock);
 
-	list_node = nrf_wifi_osal_llist_get_node_head(fmac_dev_ctx->fpriv->opriv,
-						      client_q);
+	nrf_wifi_utils_list_traverse(fmac_dev_ctx->fpriv->opriv,
+				     def_dev_ctx->tx_config.wakeup_client_q,
+				     &info,
+				     wakeup_q_callbk_fn);
 
-	while (list_node) {
-		peer = nrf_wifi_osal_llist_node_data_get(fmac_dev_ctx->fpriv->opriv,
-							 list_node);
+	nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->fpriv->opriv,
+				   def_dev_ctx->tx_config.ps_lock);
 
-		if (peer != NULL && peer->ps_token_count) {
+	return info.peer_id;
+}
 
-			pend_q = def_dev_ctx->tx_config.data_pending_txq[peer->peer_id][ac];
-			pend_q_len = nrf_wifi_utils_q_len(fmac_dev_ctx->fpriv->opriv, pend_q);
 
-			if (pend_q_len) {
-				peer->ps_token_count--;
-				return peer->peer_id;
-			}
-		}
+static bool tx_peer_has_pending(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+				unsigned int peer_id,
+				unsigned int ac)
+{
+	void *pend_q = NULL;
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 
-		list_node = nrf_wifi_osal_llist_get_node_nxt(fmac_dev_ctx->fpriv->opriv,
-							     client_q,
-							     list_node);
+	if (def_dev_ctx->tx_config.peers[peer_id].ps_state == NRF_WIFI_CLIENT_PS_MODE) {
+		return false;
 	}
 
-	return peer_id;
+	pend_q = def_dev_ctx->tx_config.data_pending_txq[peer_id][ac];
+
+	return nrf_wifi_utils_q_len(fmac_dev_ctx->fpriv->opriv,
+				    pend_q) != 0;
 }
 
 
-int tx_curr_peer_opp_get(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
-			 unsigned int ac)
+static int tx_rr_peer_get(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+			  unsigned int ac)
 {
 	unsigned int i = 0;
 	unsigned int curr_peer_opp = 0;
 	unsigned int init_peer_opp = 0;
-	unsigned int pend_q_len;
-	void *pend_q = NULL;
 	int peer_id = -1;
-	unsigned char ps_state = 0;
 	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
 
 	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 
-	if (ac == NRF_WIFI_FMAC_AC_MC) {
-		return MAX_PEERS;
-	}
+	init_peer_opp = def_dev_ctx->tx_config.curr_peer_opp[ac];
 
-	peer_id = get_peer_from_wakeup_q(fmac_dev_ctx, ac);
+	for (i = 0; i < MAX_PEERS; i++) {
+		curr_peer_opp = (init_peer_opp + i) % MAX_PEERS;
 
-	if (peer_id != -1) {
-		return peer_id;
+		if (tx_peer_has_pending(fmac_dev_ctx, curr_peer_opp, ac)) {
+			def_dev_ctx->tx_config.curr_peer_opp[ac] =
+				(curr_peer_opp + 1) % MAX_PEERS;
+			peer_id = curr_peer_opp;
+			break;
+		}
 	}
 
+	return peer_id;
+}
+
+
+static int tx_airtime_peer_get(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+			       unsigned int ac)
+{
+	unsigned int i = 0;
+	unsigned int curr_peer_opp = 0;
+	unsigned int init_peer_opp = 0;
+	int peer_id = -1;
+	int max_deficit_peer = -1;
+	int *airtime_deficit = NULL;
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
 	init_peer_opp = def_dev_ctx->tx_config.curr_peer_opp[ac];
 
 	for (i = 0; i < MAX_PEERS; i++) {
 		curr_peer_opp = (init_peer_opp + i) % MAX_PEERS;
 
-		ps_state = def_dev_ctx->tx_config.peers[curr_peer_opp].ps_state;
-
-		if (ps_state == NRF_WIFI_CLIENT_PS_MODE) {
+		if (!tx_peer_has_pending(fmac_dev_ctx, curr_peer_opp, ac)) {
 			continue;
 		}
 
-		pend_q = def_dev_ctx->tx_config.data_pending_txq[curr_peer_opp][ac];
-		pend_q_len = nrf_wifi_utils_q_len(fmac_dev_ctx->fpriv->opriv,
-						  pend_q);
+		airtime_deficit = &def_dev_ctx->tx_config.airtime_deficit[curr_peer_opp][ac];
 
-		if (pend_q_len) {
-			def_dev_ctx->tx_config.curr_peer_opp[ac] =
-				(curr_peer_opp + 1) % MAX_PEERS;
+		if (*airtime_deficit >= 0) {
+			peer_id = curr_peer_opp;
 			break;
 		}
+
+		/* Peer has used up its airtime, credit it for the next round
+		 * and move on to the next peer.
+		 */
+		*airtime_deficit += TX_AIRTIME_QUANTUM_US;
+
+		if ((max_deficit_peer == -1) ||
+		    (*airtime_deficit >
+		     def_dev_ctx->tx_config.airtime_deficit[max_deficit_peer][ac])) {
+			max_deficit_peer = curr_peer_opp;
+		}
+	}
+
+	/* All peers with pending frames are still in debt, rather than
+	 * leaving the descriptor idle serve the one closest to its share.
+	 */
+	if (peer_id == -1) {
+		peer_id = max_deficit_peer;
+	}
+
+	/* The peer keeps the TX opportunity until its airtime runs out */
+	if (peer_id != -1) {
+		def_dev_ctx->tx_config.curr_peer_opp[ac] = peer_id;
+	}
+
+	return peer_id;
+}
+
+
+int tx_curr_peer_opp_get(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+			 unsigned int ac)
+{
+	int peer_id = -1;
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	if (ac == NRF_WIFI_FMAC_AC_MC) {
+		return MAX_PEERS;
+	}
+
+	peer_id = get_peer_from_wakeup_q(fmac_dev_ctx, ac);
+
+	if (peer_id != -1) {
+		return peer_id;
 	}
 
-	if (i != MAX_PEERS) {
-		peer_id = curr_peer_opp;
+	if (def_dev_ctx->tx_config.sched_policy == NRF_WIFI_FMAC_TX_SCHED_AIRTIME) {
+		peer_id = tx_airtime_peer_get(fmac_dev_ctx, ac);
+	} else {
+		peer_id = tx_rr_peer_get(fmac_dev_ctx, ac);
 	}
 
 	return peer_id;
@@ -451,7 +705,7 @@ size_t _tx_pending_process(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 	def_priv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
 
-	max_txq_len = def_priv->data_config.max_tx_aggregation;
+	max_txq_len = def_dev_ctx->tx_config.agg_limit[ac];
 	avail_ampdu_len_per_token = def_priv->avail_ampdu_len_per_token;
 
 	peer_id = tx_curr_peer_opp_get(fmac_dev_ctx, ac);
@@ -512,13 +766,14 @@ size_t _tx_pending_process(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 	 * pend_q is empty, send only 1
 	 */
 	if (!nrf_wifi_utils_q_len(fmac_dev_ctx->fpriv->opriv, txq)) {
-		nwb = nrf_wifi_utils_q_dequeue(fmac_dev_ctx->fpriv->opriv,
-					       pend_pkt_q);
-
-		if (!can_xmit(fmac_dev_ctx, nwb)) {
+		/* Hold the frame until it can go out rather than losing it */
+		if (!can_xmit(fmac_dev_ctx, first_nwb)) {
 			return 0;
 		}
 
+		nwb = nrf_wifi_utils_q_dequeue(fmac_dev_ctx->fpriv->opriv,
+					       pend_pkt_q);
+
 		nrf_wifi_utils_list_add_tail(fmac_dev_ctx->fpriv->opriv,
 					     txq,
 					     nwb);
@@ -528,6 +783,7 @@ size_t _tx_pending_process(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 
 	if (len > 0) {
 		def_dev_ctx->tx_config.pkt_info_p[desc].peer_id = peer_id;
+		def_dev_ctx->tx_config.pkt_info_p[desc].ac = ac;
 	}
 
 	update_pend_q_bmp(fmac_dev_ctx, ac, peer_id);
@@ -609,6 +865,8 @@ enum nrf_wifi_status tx_cmd_prep_callbk_fn(void *callbk_data,
 	config->tx_buff_info[frame_indx].pkt_length = buf_len;
 	config->num_tx_pkts++;
 
+	def_dev_ctx->tx_config.pkt_info_p[config->tx_desc_num].bytes += buf_len;
+
 	status = NRF_WIFI_STATUS_SUCCESS;
 out:
 	return status;
@@ -666,7 +924,7 @@ enum nrf_wifi_status tx_cmd_prepare(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 
 	config->umac_head.cmd = NRF_WIFI_CMD_TX_BUFF;
 
-	config->umac_head.len += sizeof(struct nrf_wifi_tx_buff);
+	config->umac_head.len = sizeof(struct nrf_wifi_tx_buff);
 	config->umac_head.len += sizeof(struct nrf_wifi_tx_buff_info) * txq_len;
 
 	config->tx_desc_num = desc;
@@ -695,6 +953,7 @@ enum nrf_wifi_status tx_cmd_prepare(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 	}
 
 	config->num_tx_pkts = 0;
+	def_dev_ctx->tx_config.pkt_info_p[desc].bytes = 0;
 
 	info.fmac_dev_ctx = fmac_dev_ctx;
 	info.config = config;
@@ -719,8 +978,13 @@ enum nrf_wifi_status tx_cmd_prepare(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 	    vif_ctx->if_type == NRF_WIFI_IFTYPE_MESH_POINT) &&
 		pending_frames_count(fmac_dev_ctx, peer_id) != 0) {
 		config->mac_hdr_info.more_data = 1;
+	} else {
+		config->mac_hdr_info.more_data = 0;
 	}
 
+	nrf_wifi_osal_spinlock_take(fmac_dev_ctx->fpriv->opriv,
+				    def_dev_ctx->tx_config.ps_lock);
+
 	if (def_dev_ctx->tx_config.peers[peer_id].ps_token_count == 0) {
 		nrf_wifi_utils_list_del_node(fmac_dev_ctx->fpriv->opriv,
 					     def_dev_ctx->tx_config.wakeup_client_q,
@@ -732,29 +996,90 @@ enum nrf_wifi_status tx_cmd_prepare(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 		config->mac_hdr_info.eosp = 0;
 	}
 
+	nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->fpriv->opriv,
+				   def_dev_ctx->tx_config.ps_lock);
+
 	return NRF_WIFI_STATUS_SUCCESS;
 err:
 	return NRF_WIFI_STATUS_FAIL;
 }
 
 
+/* Get the preformatted TX command of a desc, only the per-frame fields
+ * need to be filled by tx_cmd_prepare.
+ */
+static struct host_rpu_msg *tx_cmd_pool_get(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+					    int desc,
+					    unsigned int len)
+{
+	struct host_rpu_msg *umac_cmd = NULL;
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	if (!def_dev_ctx->tx_config.tx_cmd_pool) {
+		goto out;
+	}
+
+	if ((sizeof(*umac_cmd) + len) > def_dev_ctx->tx_config.tx_cmd_pool_buf_size) {
+		goto out;
+	}
+
+	umac_cmd = (struct host_rpu_msg *)(def_dev_ctx->tx_config.tx_cmd_pool +
+					   (desc * def_dev_ctx->tx_config.tx_cmd_pool_buf_size));
+
+	umac_cmd->hdr.len = sizeof(*umac_cmd) + len;
+out:
+	return umac_cmd;
+}
+
+
 enum nrf_wifi_status tx_cmd_init(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 				 void *txq,
 				 int desc,
-				 int peer_id)
+				 int peer_id,
+				 bool batch)
 {
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 	struct host_rpu_msg *umac_cmd = NULL;
 	unsigned int len = 0;
+	bool pool_cmd = false;
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 
 	len += sizeof(struct nrf_wifi_tx_buff_info);
 	len *= nrf_wifi_utils_list_len(fmac_dev_ctx->fpriv->opriv, txq);
 
 	len += sizeof(struct nrf_wifi_tx_buff);
 
-	umac_cmd = umac_cmd_alloc(fmac_dev_ctx,
-				  NRF_WIFI_HOST_RPU_MSG_TYPE_DATA,
-				  len);
+	/* Frames of a command are laid out back to back in the packet RAM,
+	 * so commands for different ACs can't be built in parallel.
+	 */
+	nrf_wifi_osal_spinlock_take(fmac_dev_ctx->fpriv->opriv,
+				    def_dev_ctx->tx_config.tx_cmd_lock);
+
+	umac_cmd = tx_cmd_pool_get(fmac_dev_ctx,
+				   desc,
+				   len);
+
+	if (umac_cmd) {
+		pool_cmd = true;
+		def_dev_ctx->host_stats.tx_cmd_pool_hits++;
+	} else {
+		def_dev_ctx->host_stats.tx_cmd_pool_misses++;
+
+		umac_cmd = umac_cmd_alloc(fmac_dev_ctx,
+					  NRF_WIFI_HOST_RPU_MSG_TYPE_DATA,
+					  len);
+
+		if (!umac_cmd) {
+			nrf_wifi_osal_log_err(fmac_dev_ctx->fpriv->opriv,
+					      "%s: umac_cmd_alloc failed\n",
+					      __func__);
+			goto out;
+		}
+	}
 
 	status = tx_cmd_prepare(fmac_dev_ctx,
 				umac_cmd,
@@ -767,19 +1092,29 @@ enum nrf_wifi_status tx_cmd_init(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 				      "%s: tx_cmd_prepare failed\n",
 				      __func__);
 
-		goto out;
+		goto cmd_free;
 	}
 
+	def_dev_ctx->tx_config.pkt_info_p[desc].submit_time_us =
+		nrf_wifi_osal_time_get_curr_us(fmac_dev_ctx->fpriv->opriv);
+
 	status = nrf_wifi_hal_data_cmd_send(fmac_dev_ctx->hal_dev_ctx,
 					    NRF_WIFI_HAL_MSG_TYPE_CMD_DATA_TX,
 					    umac_cmd,
 					    sizeof(*umac_cmd) + len,
 					    desc,
-					    0);
+					    0,
+					    batch);
 
-	nrf_wifi_osal_mem_free(fmac_dev_ctx->fpriv->opriv,
-			       umac_cmd);
+cmd_free:
+	if (!pool_cmd) {
+		nrf_wifi_osal_mem_free(fmac_dev_ctx->fpriv->opriv,
+				       umac_cmd);
+	}
 out:
+	nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->fpriv->opriv,
+				   def_dev_ctx->tx_config.tx_cmd_lock);
+
 	return status;
 }
 
@@ -804,7 +1139,8 @@ enum nrf_wifi_status tx_pending_process(struct nrf_wifi_fmac_dev_ctx *fmac_dev_c
 		status = tx_cmd_init(fmac_dev_ctx,
 				     def_dev_ctx->tx_config.pkt_info_p[desc].pkt,
 				     desc,
-				     def_dev_ctx->tx_config.pkt_info_p[desc].peer_id);
+				     def_dev_ctx->tx_config.pkt_info_p[desc].peer_id,
+				     false);
 	} else {
 		tx_desc_free(fmac_dev_ctx,
 			     desc,
@@ -862,8 +1198,136 @@ out:
 }
 
 
-enum nrf_wifi_fmac_tx_status tx_process(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
-				unsigned char if_idx,
+static void tx_flow_ctrl_stop(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+			      unsigned char if_idx,
+			      unsigned int ac,
+			      unsigned int peer_id)
+{
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+	struct nrf_wifi_fmac_priv_def *def_priv = NULL;
+	struct nrf_wifi_fmac_vif_ctx *vif_ctx = NULL;
+	int qlen = 0;
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	def_priv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
+
+	/* Multicast frames share the BE queue of the OS */
+	if (ac >= NRF_WIFI_FMAC_AC_MC || if_idx >= MAX_NUM_VIFS) {
+		return;
+	}
+
+	vif_ctx = def_dev_ctx->vif_ctx[if_idx];
+
+	if (!vif_ctx ||
+	    vif_ctx->txq_stopped[ac] ||
+	    !def_priv->callbk_fns.tx_flow_ctrl_callbk_fn) {
+		return;
+	}
+
+	/* Frames for a sleeping client are held until it wakes up, its
+	 * backlog must not stop the AC for every other peer of the VIF.
+	 */
+	if (def_dev_ctx->tx_config.peers[peer_id].ps_state == NRF_WIFI_CLIENT_PS_MODE) {
+		return;
+	}
+
+	qlen = nrf_wifi_utils_q_len(fmac_dev_ctx->fpriv->opriv,
+				    def_dev_ctx->tx_config.data_pending_txq[peer_id][ac]);
+
+	if (qlen < TX_PENDING_QLEN_HIGH_WM) {
+		return;
+	}
+
+	vif_ctx->txq_stopped[ac] = true;
+
+	def_priv->callbk_fns.tx_flow_ctrl_callbk_fn(vif_ctx->os_vif_ctx,
+						    ac,
+						    true);
+}
+
+
+static bool tx_flow_ctrl_can_resume(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+				    unsigned char if_idx,
+				    unsigned int ac)
+{
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+	struct peers_info *peer = NULL;
+	int peer_id = 0;
+	int qlen = 0;
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	for (peer_id = 0; peer_id < MAX_PEERS; peer_id++) {
+		peer = &def_dev_ctx->tx_config.peers[peer_id];
+
+		if (peer->peer_id == -1 ||
+		    peer->if_idx != if_idx ||
+		    peer->ps_state == NRF_WIFI_CLIENT_PS_MODE) {
+			continue;
+		}
+
+		qlen = nrf_wifi_utils_q_len(fmac_dev_ctx->fpriv->opriv,
+					    def_dev_ctx->tx_config.data_pending_txq[peer_id][ac]);
+
+		if (qlen > TX_PENDING_QLEN_LOW_WM) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+void tx_flow_ctrl_resume(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+	struct nrf_wifi_fmac_priv_def *def_priv = NULL;
+	struct nrf_wifi_fmac_vif_ctx *vif_ctx = NULL;
+	unsigned int ac = 0;
+	unsigned char if_idx = 0;
+	bool wake = false;
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	def_priv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
+
+	if (!def_priv->callbk_fns.tx_flow_ctrl_callbk_fn) {
+		return;
+	}
+
+	for (ac = 0; ac < NRF_WIFI_FMAC_AC_MC; ac++) {
+		for (if_idx = 0; if_idx < MAX_NUM_VIFS; if_idx++) {
+			vif_ctx = def_dev_ctx->vif_ctx[if_idx];
+
+			/* Unlocked hint, rechecked under the AC lock */
+			if (!vif_ctx || !vif_ctx->txq_stopped[ac]) {
+				continue;
+			}
+
+			nrf_wifi_osal_spinlock_take(fmac_dev_ctx->fpriv->opriv,
+						    def_dev_ctx->tx_config.ac_lock[ac]);
+
+			wake = vif_ctx->txq_stopped[ac] &&
+				tx_flow_ctrl_can_resume(fmac_dev_ctx, if_idx, ac);
+
+			if (wake) {
+				vif_ctx->txq_stopped[ac] = false;
+			}
+
+			nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->fpriv->opriv,
+						   def_dev_ctx->tx_config.ac_lock[ac]);
+
+			if (wake) {
+				def_priv->callbk_fns.tx_flow_ctrl_callbk_fn(vif_ctx->os_vif_ctx,
+									    ac,
+									    false);
+			}
+		}
+	}
+}
+
+
+enum nrf_wifi_fmac_tx_status tx_process(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+				unsigned char if_idx,
 				void *nbuf,
 				unsigned int ac,
 				unsigned int peer_id)
@@ -891,6 +1355,11 @@ enum nrf_wifi_fmac_tx_status tx_process(struct nrf_wifi_fmac_dev_ctx *fmac_dev_c
 		goto err;
 	}
 
+	tx_flow_ctrl_stop(fmac_dev_ctx,
+			  if_idx,
+			  ac,
+			  peer_id);
+
 	ps_state = def_dev_ctx->tx_config.peers[peer_id].ps_state;
 
 	if (ps_state == NRF_WIFI_CLIENT_PS_MODE) {
@@ -930,7 +1399,7 @@ enum nrf_wifi_fmac_tx_status tx_process(struct nrf_wifi_fmac_dev_ctx *fmac_dev_c
 		}
 
 		if (aggr_status) {
-			max_cmds = def_priv->data_config.max_tx_aggregation;
+			max_cmds = def_dev_ctx->tx_config.agg_limit[ac];
 
 			if (nrf_wifi_utils_q_len(fmac_dev_ctx->fpriv->opriv,
 						 pend_pkt_q) < max_cmds) {
@@ -952,7 +1421,7 @@ unsigned int tx_buff_req_free(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 {
 	unsigned int pkts_pend = 0;
 	unsigned int desc = tx_desc_num;
-	int tx_done_q = 0, start_ac, end_ac, cnt = 0;
+	int tx_done_q = 0, start_ac, end_ac, cnt = 0, last_ac = 0;
 	unsigned short tx_done_spare_desc_q_map = 0;
 	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
 	struct nrf_wifi_fmac_priv_def *def_priv = NULL;
@@ -968,8 +1437,14 @@ unsigned int tx_buff_req_free(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 	} else {
 		/* Derive the queue here as it is not given by UMAC. */
 		if (desc >= (def_priv->num_tx_tokens_per_ac * NRF_WIFI_FMAC_AC_MAX)) {
+			nrf_wifi_osal_spinlock_take(fmac_dev_ctx->fpriv->opriv,
+						    def_dev_ctx->tx_config.spare_desc_lock);
+
 			tx_done_spare_desc_q_map = get_spare_desc_q_map(fmac_dev_ctx, desc);
 
+			nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->fpriv->opriv,
+						   def_dev_ctx->tx_config.spare_desc_lock);
+
 			if (tx_done_spare_desc_q_map & (1 << NRF_WIFI_FMAC_AC_BK))
 				tx_done_q = NRF_WIFI_FMAC_AC_BK;
 			else if (tx_done_spare_desc_q_map & (1 << NRF_WIFI_FMAC_AC_BE))
@@ -987,7 +1462,16 @@ unsigned int tx_buff_req_free(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 		end_ac = NRF_WIFI_FMAC_AC_BK;
 	}
 
+	/* The AC locks are kept as the ACs are walked, so that a frame
+	 * queued to an AC already looked at can't miss the desc which is
+	 * about to be freed.
+	 */
 	for (cnt = start_ac; cnt >= end_ac; cnt--) {
+		nrf_wifi_osal_spinlock_take(fmac_dev_ctx->fpriv->opriv,
+					    def_dev_ctx->tx_config.ac_lock[cnt]);
+
+		last_ac = cnt;
+
 		pkts_pend = _tx_pending_process(fmac_dev_ctx, desc, cnt);
 
 		if (pkts_pend) {
@@ -996,30 +1480,159 @@ unsigned int tx_buff_req_free(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 			/* Spare Token Case*/
 			if (tx_done_q != *ac) {
 				/* Adjust the counters */
+				if (tx_done_q < *ac) {
+					nrf_wifi_osal_spinlock_take(fmac_dev_ctx->fpriv->opriv,
+								    def_dev_ctx->tx_config.ac_lock[tx_done_q]);
+				}
+
 				def_dev_ctx->tx_config.outstanding_descs[tx_done_q]--;
+
+				if (tx_done_q < *ac) {
+					nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->fpriv->opriv,
+								   def_dev_ctx->tx_config.ac_lock[tx_done_q]);
+				}
+
 				def_dev_ctx->tx_config.outstanding_descs[*ac]++;
 
+				nrf_wifi_osal_spinlock_take(fmac_dev_ctx->fpriv->opriv,
+							    def_dev_ctx->tx_config.spare_desc_lock);
+
 				/* Update the queue_map */
 				/* Clear the last access category. */
 				clear_spare_desc_q_map(fmac_dev_ctx, desc, tx_done_q);
 				/* Set the new access category. */
 				set_spare_desc_q_map(fmac_dev_ctx, desc, *ac);
+
+				nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->fpriv->opriv,
+							   def_dev_ctx->tx_config.spare_desc_lock);
 			}
 			break;
 		}
 	}
 
 	if (!pkts_pend) {
-		/* Mark the desc as available */
+		/* Mark the desc as available, the lock of tx_done_q is
+		 * held at this point as all the ACs have been walked.
+		 */
 		tx_desc_free(fmac_dev_ctx,
 			     desc,
 			     tx_done_q);
 	}
 
+	for (cnt = last_ac; cnt <= start_ac; cnt++) {
+		nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->fpriv->opriv,
+					   def_dev_ctx->tx_config.ac_lock[cnt]);
+	}
+
 	return pkts_pend;
 }
 
 
+static unsigned int tx_airtime_get(struct nrf_wifi_tx_buff_done *config,
+				   unsigned int bytes)
+{
+	unsigned long long start = 0;
+	unsigned long long end = 0;
+	int i = 0;
+
+	for (i = sizeof(config->timestamp_t1) - 1; i >= 0; i--) {
+		start = (start << 8) | config->timestamp_t1[i];
+		end = (end << 8) | config->timestamp_t4[i];
+	}
+
+	if (start && (end > start) && ((end - start) <= TX_AIRTIME_MAX_US)) {
+		return (unsigned int)(end - start);
+	}
+
+	/* Timestamps not usable, estimate from the size of the frames */
+	return (bytes * 8) / TX_AIRTIME_DEF_RATE_MBPS;
+}
+
+
+static void tx_airtime_charge(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+			      struct nrf_wifi_tx_buff_done *config,
+			      struct tx_pkt_info *pkt_info,
+			      unsigned int bytes)
+{
+	unsigned int ac = pkt_info->ac;
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	if ((pkt_info->peer_id >= MAX_PEERS) || (ac >= NRF_WIFI_FMAC_AC_MC)) {
+		return;
+	}
+
+	nrf_wifi_osal_spinlock_take(fmac_dev_ctx->fpriv->opriv,
+				    def_dev_ctx->tx_config.ac_lock[ac]);
+
+	def_dev_ctx->tx_config.airtime_deficit[pkt_info->peer_id][ac] -=
+		tx_airtime_get(config, bytes);
+
+	nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->fpriv->opriv,
+				   def_dev_ctx->tx_config.ac_lock[ac]);
+}
+
+
+static void tx_agg_update(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+			  struct tx_pkt_info *pkt_info,
+			  unsigned int pkts)
+{
+	unsigned int ac = pkt_info->ac;
+	unsigned int latency_us = 0;
+	unsigned int backlog = 0;
+	unsigned int step = 0;
+	unsigned int *agg_limit = NULL;
+	unsigned int *avg_latency_us = NULL;
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	if ((ac >= NRF_WIFI_FMAC_AC_MAX) || (pkt_info->peer_id >= MAX_SW_PEERS)) {
+		return;
+	}
+
+	latency_us = nrf_wifi_osal_time_elapsed_us(fmac_dev_ctx->fpriv->opriv,
+						   pkt_info->submit_time_us);
+
+	nrf_wifi_osal_spinlock_take(fmac_dev_ctx->fpriv->opriv,
+				    def_dev_ctx->tx_config.ac_lock[ac]);
+
+	agg_limit = &def_dev_ctx->tx_config.agg_limit[ac];
+	avg_latency_us = &def_dev_ctx->tx_config.tx_done_latency_us[ac];
+
+	if (*avg_latency_us) {
+		*avg_latency_us = ((*avg_latency_us * 7) + latency_us) / 8;
+	} else {
+		*avg_latency_us = latency_us;
+	}
+
+	backlog = nrf_wifi_utils_q_len(fmac_dev_ctx->fpriv->opriv,
+				       def_dev_ctx->tx_config.data_pending_txq[pkt_info->peer_id][ac]);
+
+	if (*avg_latency_us > tx_agg_latency_target_us[ac]) {
+		/* Completions take too long for this AC, back off quickly */
+		step = (*agg_limit / 4) ? (*agg_limit / 4) : 1;
+
+		if (*agg_limit > def_dev_ctx->tx_config.agg_min + step) {
+			*agg_limit -= step;
+		} else {
+			*agg_limit = def_dev_ctx->tx_config.agg_min;
+		}
+	} else if ((pkts >= *agg_limit) &&
+		   (backlog >= *agg_limit) &&
+		   (*agg_limit < def_dev_ctx->tx_config.agg_max)) {
+		/* The aggregate was limited by the frame count rather than the
+		 * AMPDU length and frames are piling up, batch more of them.
+		 */
+		(*agg_limit)++;
+	}
+
+	nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->fpriv->opriv,
+				   def_dev_ctx->tx_config.ac_lock[ac]);
+}
+
+
 enum nrf_wifi_status tx_done_process(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 				     struct nrf_wifi_tx_buff_done *config)
 {
@@ -1034,9 +1647,11 @@ enum nrf_wifi_status tx_done_process(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 	struct nrf_wifi_fmac_buf_map_info *tx_buf_info = NULL;
 	struct tx_pkt_info *pkt_info = NULL;
 	unsigned int pkt = 0;
+	unsigned int bytes = 0;
 	unsigned int pkts_pending = 0;
 	unsigned char queue = 0;
 	void *txq = NULL;
+	bool unmap_err = false;
 	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
 	struct nrf_wifi_fmac_priv_def *def_priv = NULL;
 
@@ -1047,7 +1662,7 @@ enum nrf_wifi_status tx_done_process(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 
 	desc = config->tx_desc_num;
 
-	if (desc > def_priv->num_tx_tokens) {
+	if (desc >= def_priv->num_tx_tokens) {
 		nrf_wifi_osal_log_err(fmac_dev_ctx->fpriv->opriv,
 				      "Invalid desc\n");
 		goto out;
@@ -1063,13 +1678,16 @@ enum nrf_wifi_status tx_done_process(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 
 		tx_buf_info = &def_dev_ctx->tx_buf_info[desc_id];
 
+		/* The frames of the desc are still completed below on an
+		 * error, so that they are not lost to the OS.
+		 */
 		if (!tx_buf_info->mapped) {
 			nrf_wifi_osal_log_err(fmac_dev_ctx->fpriv->opriv,
 					      "%s: Deinit_TX cmd called for unmapped TX buf(%d)\n",
 					      __func__,
 					      desc_id);
-			status = NRF_WIFI_STATUS_FAIL;
-			goto out;
+			unmap_err = true;
+			continue;
 		}
 
 		virt_addr = nrf_wifi_hal_buf_unmap_tx(fmac_dev_ctx->hal_dev_ctx,
@@ -1079,8 +1697,7 @@ enum nrf_wifi_status tx_done_process(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 			nrf_wifi_osal_log_err(fmac_dev_ctx->fpriv->opriv,
 					      "%s: nrf_wifi_hal_buf_unmap_tx failed\n",
 					      __func__);
-			status = NRF_WIFI_STATUS_FAIL;
-			goto out;
+			unmap_err = true;
 		}
 
 		/* TODO: See why we can't free the nwb here itself instead of
@@ -1091,6 +1708,7 @@ enum nrf_wifi_status tx_done_process(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 	}
 
 	pkt = 0;
+	bytes = pkt_info->bytes;
 
 	while (nrf_wifi_utils_q_len(fpriv->opriv,
 				    nwb_list)) {
@@ -1108,6 +1726,23 @@ enum nrf_wifi_status tx_done_process(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 
 	def_dev_ctx->host_stats.total_tx_done_pkts += pkt;
 
+	if (def_dev_ctx->tx_config.sched_policy == NRF_WIFI_FMAC_TX_SCHED_AIRTIME) {
+		tx_airtime_charge(fmac_dev_ctx,
+				  config,
+				  pkt_info,
+				  bytes);
+	}
+
+	tx_agg_update(fmac_dev_ctx,
+		      pkt_info,
+		      pkt);
+
+	tx_done_notify(fmac_dev_ctx,
+		       pkt_info->peer_id,
+		       pkt_info->ac,
+		       pkt,
+		       bytes);
+
 	pkts_pending = tx_buff_req_free(fmac_dev_ctx, config->tx_desc_num, &queue);
 
 	if (pkts_pending) {
@@ -1118,10 +1753,14 @@ enum nrf_wifi_status tx_done_process(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 
 			txq = pkt_info->pkt;
 
+			/* Called from the event tasklet, which batches the
+			 * TX commands it sends.
+			 */
 			status = tx_cmd_init(fmac_dev_ctx,
 					     txq,
 					     desc,
-					     pkt_info->peer_id);
+					     pkt_info->peer_id,
+					     true);
 		} else {
 			status = NRF_WIFI_STATUS_SUCCESS;
 		}
@@ -1129,6 +1768,10 @@ enum nrf_wifi_status tx_done_process(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 	} else {
 		status = NRF_WIFI_STATUS_SUCCESS;
 	}
+
+	if (unmap_err) {
+		status = NRF_WIFI_STATUS_FAIL;
+	}
 out:
 	return status;
 }
@@ -1164,7 +1807,6 @@ enum nrf_wifi_status (nrf_wifi_fmac_tx_done_event_process)(
 	struct nrf_wifi_tx_buff_done *config)
 {
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
-	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 
 	if (!fmac_dev_ctx) {
 		goto out;
@@ -1178,15 +1820,15 @@ enum nrf_wifi_status (nrf_wifi_fmac_tx_done_event_process)(
 		goto out;
 	}
 
-	nrf_wifi_osal_spinlock_take(fmac_dev_ctx->fpriv->opriv,
-				    def_dev_ctx->tx_config.tx_lock);
-
+	/* The desc is owned by this completion until it is handed back in
+	 * tx_buff_req_free, which takes the locks it needs.
+	 */
 	status = tx_done_process(fmac_dev_ctx,
 				 config);
 
-	nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->fpriv->opriv,
-				   def_dev_ctx->tx_config.tx_lock);
+	flush_pend_q_bmp(fmac_dev_ctx);
 
+	tx_flow_ctrl_resume(fmac_dev_ctx);
 out:
 	if (status != NRF_WIFI_STATUS_SUCCESS) {
 		nrf_wifi_osal_log_err(fmac_dev_ctx->fpriv->opriv,
@@ -1215,7 +1857,7 @@ enum nrf_wifi_fmac_tx_status nrf_wifi_fmac_tx(struct nrf_wifi_fmac_dev_ctx *fmac
 	def_priv = wifi_fmac_priv(fpriv);
 
 	nrf_wifi_osal_spinlock_take(fmac_dev_ctx->fpriv->opriv,
-				    def_dev_ctx->tx_config.tx_lock);
+				    def_dev_ctx->tx_config.ac_lock[ac]);
 
 
 	if (def_priv->num_tx_tokens == 0) {
@@ -1244,17 +1886,198 @@ enum nrf_wifi_fmac_tx_status nrf_wifi_fmac_tx(struct nrf_wifi_fmac_dev_ctx *fmac
 		goto out;
 	}
 
-	status = tx_pending_process(fmac_dev_ctx,
-				    desc,
-				    ac);
+	/* The frame is queued and no longer ours to hand back to the OS,
+	 * even if the command for it could not be sent.
+	 */
+	if (tx_pending_process(fmac_dev_ctx,
+			       desc,
+			       ac) == NRF_WIFI_STATUS_SUCCESS) {
+		status = NRF_WIFI_FMAC_TX_STATUS_SUCCESS;
+	}
 out:
 	nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->fpriv->opriv,
-				   def_dev_ctx->tx_config.tx_lock);
+				   def_dev_ctx->tx_config.ac_lock[ac]);
+
+	flush_pend_q_bmp(fmac_dev_ctx);
 
 	return status;
 }
 
 
+static enum nrf_wifi_status tx_cmd_pool_init(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+	struct nrf_wifi_fmac_priv_def *def_priv = NULL;
+	struct host_rpu_msg *umac_cmd = NULL;
+	struct nrf_wifi_tx_buff *config = NULL;
+	unsigned int buf_size = 0;
+	unsigned int i = 0;
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	def_priv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
+
+	/* Large enough for a fully aggregated command, rounded up to keep
+	 * every command word aligned.
+	 */
+	buf_size = sizeof(*umac_cmd) + sizeof(*config) +
+		(sizeof(struct nrf_wifi_tx_buff_info) *
+		 def_priv->data_config.max_tx_aggregation);
+	buf_size = (buf_size + 3) & ~3;
+
+	def_dev_ctx->tx_config.tx_cmd_pool =
+		nrf_wifi_osal_mem_zalloc(fmac_dev_ctx->fpriv->opriv,
+					 buf_size * def_priv->num_tx_tokens);
+
+	if (!def_dev_ctx->tx_config.tx_cmd_pool) {
+		return NRF_WIFI_STATUS_FAIL;
+	}
+
+	def_dev_ctx->tx_config.tx_cmd_pool_buf_size = buf_size;
+
+	/* Fill in the fields which don't change from frame to frame */
+	for (i = 0; i < def_priv->num_tx_tokens; i++) {
+		umac_cmd = (struct host_rpu_msg *)(def_dev_ctx->tx_config.tx_cmd_pool +
+						   (i * buf_size));
+		umac_cmd->type = NRF_WIFI_HOST_RPU_MSG_TYPE_DATA;
+
+		config = (struct nrf_wifi_tx_buff *)(umac_cmd->msg);
+		config->umac_head.cmd = NRF_WIFI_CMD_TX_BUFF;
+		config->tx_desc_num = i;
+	}
+
+	return NRF_WIFI_STATUS_SUCCESS;
+}
+
+
+static void tx_cmd_pool_deinit(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	nrf_wifi_osal_mem_free(fmac_dev_ctx->fpriv->opriv,
+			       def_dev_ctx->tx_config.tx_cmd_pool);
+
+	def_dev_ctx->tx_config.tx_cmd_pool = NULL;
+	def_dev_ctx->tx_config.tx_cmd_pool_buf_size = 0;
+}
+
+
+static void *tx_lock_alloc(struct nrf_wifi_osal_priv *opriv)
+{
+	void *lock = NULL;
+
+	lock = nrf_wifi_osal_spinlock_alloc(opriv);
+
+	if (lock) {
+		nrf_wifi_osal_spinlock_init(opriv,
+					    lock);
+	}
+
+	return lock;
+}
+
+
+static void tx_locks_free(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	struct nrf_wifi_osal_priv *opriv = NULL;
+	struct tx_config *tx_config = NULL;
+	unsigned int i = 0;
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+
+	opriv = fmac_dev_ctx->fpriv->opriv;
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	tx_config = &def_dev_ctx->tx_config;
+
+	for (i = 0; i < NRF_WIFI_FMAC_AC_MAX; i++) {
+		if (tx_config->ac_lock[i]) {
+			nrf_wifi_osal_spinlock_free(opriv,
+						    tx_config->ac_lock[i]);
+			tx_config->ac_lock[i] = NULL;
+		}
+	}
+
+	for (i = 0; i < MAX_SW_PEERS; i++) {
+		if (tx_config->peer_lock[i]) {
+			nrf_wifi_osal_spinlock_free(opriv,
+						    tx_config->peer_lock[i]);
+			tx_config->peer_lock[i] = NULL;
+		}
+	}
+
+	if (tx_config->tx_cmd_lock) {
+		nrf_wifi_osal_spinlock_free(opriv,
+					    tx_config->tx_cmd_lock);
+		tx_config->tx_cmd_lock = NULL;
+	}
+
+	if (tx_config->ps_lock) {
+		nrf_wifi_osal_spinlock_free(opriv,
+					    tx_config->ps_lock);
+		tx_config->ps_lock = NULL;
+	}
+
+	if (tx_config->spare_desc_lock) {
+		nrf_wifi_osal_spinlock_free(opriv,
+					    tx_config->spare_desc_lock);
+		tx_config->spare_desc_lock = NULL;
+	}
+}
+
+
+static enum nrf_wifi_status tx_locks_alloc(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	struct nrf_wifi_osal_priv *opriv = NULL;
+	struct tx_config *tx_config = NULL;
+	unsigned int i = 0;
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+
+	opriv = fmac_dev_ctx->fpriv->opriv;
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	tx_config = &def_dev_ctx->tx_config;
+
+	for (i = 0; i < NRF_WIFI_FMAC_AC_MAX; i++) {
+		tx_config->ac_lock[i] = tx_lock_alloc(opriv);
+
+		if (!tx_config->ac_lock[i]) {
+			goto err;
+		}
+	}
+
+	for (i = 0; i < MAX_SW_PEERS; i++) {
+		tx_config->peer_lock[i] = tx_lock_alloc(opriv);
+
+		if (!tx_config->peer_lock[i]) {
+			goto err;
+		}
+	}
+
+	tx_config->tx_cmd_lock = tx_lock_alloc(opriv);
+
+	if (!tx_config->tx_cmd_lock) {
+		goto err;
+	}
+
+	tx_config->ps_lock = tx_lock_alloc(opriv);
+
+	if (!tx_config->ps_lock) {
+		goto err;
+	}
+
+	tx_config->spare_desc_lock = tx_lock_alloc(opriv);
+
+	if (!tx_config->spare_desc_lock) {
+		goto err;
+	}
+
+	return NRF_WIFI_STATUS_SUCCESS;
+err:
+	tx_locks_free(fmac_dev_ctx);
+
+	return NRF_WIFI_STATUS_FAIL;
+}
+
+
 enum nrf_wifi_status tx_init(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
 {
 	struct nrf_wifi_fmac_priv *fpriv = NULL;
@@ -1329,39 +2152,60 @@ enum nrf_wifi_status tx_init(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
 		def_dev_ctx->tx_config.curr_peer_opp[j] = 0;
 	}
 
-	def_dev_ctx->tx_config.buf_pool_bmp_p =
-		nrf_wifi_osal_mem_zalloc(fmac_dev_ctx->fpriv->opriv,
-					 (sizeof(unsigned long) *
-					  (def_priv->num_tx_tokens/TX_DESC_BUCKET_BOUND) + 1));
+	def_dev_ctx->tx_config.agg_max = def_priv->data_config.max_tx_aggregation;
+	def_dev_ctx->tx_config.agg_min = TX_AGG_MIN_DEF;
+
+	if (def_dev_ctx->tx_config.agg_min > def_dev_ctx->tx_config.agg_max) {
+		def_dev_ctx->tx_config.agg_min = def_dev_ctx->tx_config.agg_max;
+	}
+
+	for (j = 0; j < NRF_WIFI_FMAC_AC_MAX; j++) {
+		def_dev_ctx->tx_config.agg_limit[j] = def_dev_ctx->tx_config.agg_max;
+		def_dev_ctx->tx_config.tx_done_latency_us[j] = 0;
+	}
+
+#ifdef CONFIG_NRF700X_TX_SCHED_AIRTIME
+	def_dev_ctx->tx_config.sched_policy = NRF_WIFI_FMAC_TX_SCHED_AIRTIME;
+#else
+	def_dev_ctx->tx_config.sched_policy = NRF_WIFI_FMAC_TX_SCHED_RR;
+#endif /* CONFIG_NRF700X_TX_SCHED_AIRTIME */
 
-	if (!def_dev_ctx->tx_config.buf_pool_bmp_p) {
+	if (tx_cmd_pool_init(fmac_dev_ctx) != NRF_WIFI_STATUS_SUCCESS) {
 		nrf_wifi_osal_log_err(fmac_dev_ctx->fpriv->opriv,
-				      "%s: Unable to allocate buf_pool_bmp_p\n",
+				      "%s: Unable to allocate TX command pool\n",
 				      __func__);
 		goto tx_pkt_info_free;
 	}
 
-	nrf_wifi_osal_mem_set(fmac_dev_ctx->fpriv->opriv,
-			      def_dev_ctx->tx_config.buf_pool_bmp_p,
-			      0,
-			      sizeof(long)*((def_priv->num_tx_tokens/TX_DESC_BUCKET_BOUND) + 1));
+	if (def_priv->num_tx_tokens_per_ac > TX_DESC_BMP_BITS ||
+	    def_priv->num_tx_tokens_spare > TX_DESC_BMP_BITS) {
+		nrf_wifi_osal_log_err(fmac_dev_ctx->fpriv->opriv,
+				      "%s: Too many TX tokens (%d)\n",
+				      __func__,
+				      def_priv->num_tx_tokens);
+		goto tx_cmd_pool_free;
+	}
+
+	/* All descriptors start out free */
+	for (j = 0; j < NRF_WIFI_FMAC_AC_MAX; j++) {
+		def_dev_ctx->tx_config.desc_free_bmp[j] =
+			TX_DESC_BMP_MASK(def_priv->num_tx_tokens_per_ac);
+	}
+
+	def_dev_ctx->tx_config.spare_desc_free_bmp =
+		TX_DESC_BMP_MASK(def_priv->num_tx_tokens_spare);
 
 	for (i = 0; i < MAX_PEERS; i++) {
 		def_dev_ctx->tx_config.peers[i].peer_id = -1;
 	}
 
-	def_dev_ctx->tx_config.tx_lock = nrf_wifi_osal_spinlock_alloc(fmac_dev_ctx->fpriv->opriv);
-
-	if (!def_dev_ctx->tx_config.tx_lock) {
+	if (tx_locks_alloc(fmac_dev_ctx) != NRF_WIFI_STATUS_SUCCESS) {
 		nrf_wifi_osal_log_err(fmac_dev_ctx->fpriv->opriv,
-				      "%s: Unable to allocate TX lock\n",
+				      "%s: Unable to allocate TX locks\n",
 				      __func__);
-		goto tx_buff_map_free;
+		goto tx_cmd_pool_free;
 	}
 
-	nrf_wifi_osal_spinlock_init(fmac_dev_ctx->fpriv->opriv,
-				    def_dev_ctx->tx_config.tx_lock);
-
 	def_dev_ctx->tx_config.wakeup_client_q = nrf_wifi_utils_q_alloc(fpriv->opriv);
 
 	if (!def_dev_ctx->tx_config.wakeup_client_q) {
@@ -1404,11 +2248,9 @@ wakeup_client_q_free:
 	nrf_wifi_utils_q_free(fpriv->opriv, def_dev_ctx->tx_config.wakeup_client_q);
 #endif /* CONFIG_NRF700X_TX_DONE_WQ_ENABLED */
 tx_spin_lock_free:
-	nrf_wifi_osal_spinlock_free(fmac_dev_ctx->fpriv->opriv,
-					def_dev_ctx->tx_config.tx_lock);
-tx_buff_map_free:
-	nrf_wifi_osal_mem_free(fmac_dev_ctx->fpriv->opriv,
-					def_dev_ctx->tx_config.buf_pool_bmp_p);
+	tx_locks_free(fmac_dev_ctx);
+tx_cmd_pool_free:
+	tx_cmd_pool_deinit(fmac_dev_ctx);
 tx_pkt_info_free:
 	for (i = 0; i < def_priv->num_tx_tokens; i++) {
 		nrf_wifi_utils_list_free(fpriv->opriv,
@@ -1457,11 +2299,9 @@ void tx_deinit(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
 	nrf_wifi_utils_q_free(fpriv->opriv,
 			      def_dev_ctx->tx_config.wakeup_client_q);
 
-	nrf_wifi_osal_spinlock_free(fmac_dev_ctx->fpriv->opriv,
-				    def_dev_ctx->tx_config.tx_lock);
+	tx_locks_free(fmac_dev_ctx);
 
-	nrf_wifi_osal_mem_free(fmac_dev_ctx->fpriv->opriv,
-			       def_dev_ctx->tx_config.buf_pool_bmp_p);
+	tx_cmd_pool_deinit(fmac_dev_ctx);
 
 	for (i = 0; i < def_priv->num_tx_tokens; i++) {
 		if (def_dev_ctx->tx_config.pkt_info_p) {
@@ -1518,6 +2358,68 @@ static int get_ac(unsigned int tid,
 }
 
 
+static int tx_peer_ac_get(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+			  void *nbuf,
+			  unsigned char *ra,
+			  int peer_id)
+{
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+	int tid = 0;
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	if (peer_id == MAX_PEERS) {
+		return NRF_WIFI_FMAC_AC_MC;
+	}
+
+	if (!def_dev_ctx->tx_config.peers[peer_id].qos_supported) {
+		return NRF_WIFI_FMAC_AC_BE;
+	}
+
+	tid = nrf_wifi_util_get_tid(fmac_dev_ctx, nbuf);
+
+	return get_ac(tid, ra);
+}
+
+
+int nrf_wifi_fmac_get_tx_ac(void *dev_ctx,
+			    unsigned char if_idx,
+			    void *nbuf)
+{
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+	unsigned char *ra = NULL;
+	int peer_id = -1;
+
+	fmac_dev_ctx = dev_ctx;
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	if (!nbuf ||
+	    if_idx >= MAX_NUM_VIFS ||
+	    !def_dev_ctx->vif_ctx[if_idx]) {
+		return NRF_WIFI_FMAC_AC_BE;
+	}
+
+	if (nrf_wifi_osal_nbuf_data_size(fmac_dev_ctx->fpriv->opriv,
+					 nbuf) < NRF_WIFI_FMAC_ETH_HDR_LEN) {
+		return NRF_WIFI_FMAC_AC_BE;
+	}
+
+	ra = nrf_wifi_util_get_ra(def_dev_ctx->vif_ctx[if_idx], nbuf);
+
+	peer_id = nrf_wifi_fmac_peer_get_id(fmac_dev_ctx, ra);
+
+	if (peer_id == -1) {
+		return NRF_WIFI_FMAC_AC_BE;
+	}
+
+	return tx_peer_ac_get(fmac_dev_ctx,
+			      nbuf,
+			      ra,
+			      peer_id);
+}
+
+
 enum nrf_wifi_status nrf_wifi_fmac_start_xmit(void *dev_ctx,
 					      unsigned char if_idx,
 					      void *nbuf)
@@ -1527,7 +2429,6 @@ enum nrf_wifi_status nrf_wifi_fmac_start_xmit(void *dev_ctx,
 	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
 	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
 	unsigned char *ra = NULL;
-	int tid = 0;
 	int ac = 0;
 	int peer_id = -1;
 
@@ -1553,17 +2454,13 @@ enum nrf_wifi_status nrf_wifi_fmac_start_xmit(void *dev_ctx,
 				      __func__);
 
 		goto out;
-	} else if (peer_id == MAX_PEERS) {
-		ac = NRF_WIFI_FMAC_AC_MC;
-	} else {
-		if (def_dev_ctx->tx_config.peers[peer_id].qos_supported) {
-			tid = nrf_wifi_util_get_tid(fmac_dev_ctx, nbuf);
-			ac = get_ac(tid, ra);
-		} else {
-			ac = NRF_WIFI_FMAC_AC_BE;
-		}
 	}
 
+	ac = tx_peer_ac_get(fmac_dev_ctx,
+			    nbuf,
+			    ra,
+			    peer_id);
+
 	tx_status = nrf_wifi_fmac_tx(fmac_dev_ctx,
 				  if_idx,
 				  nbuf,
@@ -1585,3 +2482,107 @@ out:
 	}
 	return status;
 }
+
+
+enum nrf_wifi_status nrf_wifi_fmac_set_tx_sched_policy(void *dev_ctx,
+						       enum nrf_wifi_fmac_tx_sched_policy policy)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+	int ac = 0;
+
+	if (!dev_ctx) {
+		goto out;
+	}
+
+	fmac_dev_ctx = dev_ctx;
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	if ((policy != NRF_WIFI_FMAC_TX_SCHED_RR) &&
+	    (policy != NRF_WIFI_FMAC_TX_SCHED_AIRTIME)) {
+		nrf_wifi_osal_log_err(fmac_dev_ctx->fpriv->opriv,
+				      "%s: Invalid policy %d\n",
+				      __func__,
+				      policy);
+		goto out;
+	}
+
+	for (ac = NRF_WIFI_FMAC_AC_MAX - 1; ac >= 0; ac--) {
+		nrf_wifi_osal_spinlock_take(fmac_dev_ctx->fpriv->opriv,
+					    def_dev_ctx->tx_config.ac_lock[ac]);
+	}
+
+	nrf_wifi_osal_mem_set(fmac_dev_ctx->fpriv->opriv,
+			      def_dev_ctx->tx_config.airtime_deficit,
+			      0,
+			      sizeof(def_dev_ctx->tx_config.airtime_deficit));
+
+	def_dev_ctx->tx_config.sched_policy = policy;
+
+	for (ac = 0; ac < NRF_WIFI_FMAC_AC_MAX; ac++) {
+		nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->fpriv->opriv,
+					   def_dev_ctx->tx_config.ac_lock[ac]);
+	}
+
+	status = NRF_WIFI_STATUS_SUCCESS;
+out:
+	return status;
+}
+
+
+enum nrf_wifi_status nrf_wifi_fmac_set_tx_agg_limits(void *dev_ctx,
+						     unsigned int agg_min,
+						     unsigned int agg_max)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+	struct nrf_wifi_fmac_priv_def *def_priv = NULL;
+	unsigned int *agg_limit = NULL;
+	int ac = 0;
+
+	if (!dev_ctx) {
+		goto out;
+	}
+
+	fmac_dev_ctx = dev_ctx;
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	def_priv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
+
+	if ((agg_min == 0) ||
+	    (agg_min > agg_max) ||
+	    (agg_max > def_priv->data_config.max_tx_aggregation)) {
+		nrf_wifi_osal_log_err(fmac_dev_ctx->fpriv->opriv,
+				      "%s: Invalid limits %d - %d\n",
+				      __func__,
+				      agg_min,
+				      agg_max);
+		goto out;
+	}
+
+	for (ac = NRF_WIFI_FMAC_AC_MAX - 1; ac >= 0; ac--) {
+		nrf_wifi_osal_spinlock_take(fmac_dev_ctx->fpriv->opriv,
+					    def_dev_ctx->tx_config.ac_lock[ac]);
+	}
+
+	def_dev_ctx->tx_config.agg_min = agg_min;
+	def_dev_ctx->tx_config.agg_max = agg_max;
+
+	for (ac = 0; ac < NRF_WIFI_FMAC_AC_MAX; ac++) {
+		agg_limit = &def_dev_ctx->tx_config.agg_limit[ac];
+
+		if (*agg_limit < agg_min) {
+			*agg_limit = agg_min;
+		} else if (*agg_limit > agg_max) {
+			*agg_limit = agg_max;
+		}
+
+		nrf_wifi_osal_spinlock_rel(fmac_dev_ctx->fpriv->opriv,
+					   def_dev_ctx->tx_config.ac_lock[ac]);
+	}
+
+	status = NRF_WIFI_STATUS_SUCCESS;
+out:
+	return status;
+}
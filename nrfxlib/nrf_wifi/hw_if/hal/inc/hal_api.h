@@ -117,11 +117,16 @@ enum nrf_wifi_status nrf_wifi_hal_ctrl_cmd_send(struct nrf_wifi_hal_dev_ctx *hal
  * @data_cmd_size: Size of the data command to be sent to the RPU.
  * @desc_id: Descriptor ID of the buffer being submitted to RPU.
  * @pool_id: Pool ID to which the buffer being submitted to RPU belongs.
+ * @batch: The caller owns the ongoing TX batch, if any.
  *
  * This function programs the relevant information about a data command,
  * to the RPU. These buffers are needed by the RPU to receive data and
  * management frames as well as to transmit data frames.
  *
+ * A TX data command is only held back by an ongoing batch when @batch is
+ * set, i.e. when it is sent from the context which started the batch.
+ * Commands from other contexts are signalled to the RPU straight away.
+ *
  * Return: Status
  *		Pass : %NRF_WIFI_STATUS_SUCCESS
  *		Error: %NRF_WIFI_STATUS_FAIL
@@ -131,7 +136,34 @@ enum nrf_wifi_status nrf_wifi_hal_data_cmd_send(struct nrf_wifi_hal_dev_ctx *hal
 						void *data_cmd,
 						unsigned int data_cmd_size,
 						unsigned int desc_id,
-						unsigned int pool_id);
+						unsigned int pool_id,
+						bool batch);
+
+/**
+ * nrf_wifi_hal_data_cmd_batch_start() - Start a batch of TX data commands.
+ * @hal_ctx: Pointer to HAL context.
+ *
+ * TX data commands sent by the batch owner (with the batch flag of
+ * nrf_wifi_hal_data_cmd_send() set) after this are written to the RPU but
+ * not signalled to it, until the matching nrf_wifi_hal_data_cmd_batch_end()
+ * is called.
+ * Batches can nest, the RPU is signalled when the outermost one ends.
+ */
+void nrf_wifi_hal_data_cmd_batch_start(struct nrf_wifi_hal_dev_ctx *hal_ctx);
+
+/**
+ * nrf_wifi_hal_data_cmd_batch_end() - End a batch of TX data commands.
+ * @hal_ctx: Pointer to HAL context.
+ *
+ * Ends a batch started with nrf_wifi_hal_data_cmd_batch_start(). If this is
+ * the outermost batch, all the TX data commands posted during the batch are
+ * signalled to the RPU with a single index update and doorbell.
+ *
+ * Return: Status
+ *		Pass : %NRF_WIFI_STATUS_SUCCESS
+ *		Error: %NRF_WIFI_STATUS_FAIL
+ */
+enum nrf_wifi_status nrf_wifi_hal_data_cmd_batch_end(struct nrf_wifi_hal_dev_ctx *hal_ctx);
 
 /**
  * hal_rpu_eventq_process() - Process events from the RPU.
@@ -202,6 +234,46 @@ enum nrf_wifi_status nrf_wifi_hal_set_wicr(struct nrf_wifi_hal_dev_ctx *hal_dev_
 enum nrf_wifi_status nrf_wifi_hal_fw_chk_boot(struct nrf_wifi_hal_dev_ctx *hal_ctx,
 					      enum RPU_PROC_TYPE rpu_proc);
 
+/**
+ * nrf_wifi_hal_irq_mod_set() - Configure moderation of the RPU interrupt.
+ * @hal_dev_ctx: Pointer to HAL context.
+ * @poll_thresh: Number of events fetched in a single interrupt at which the
+ *               RPU interrupt is masked and the HAL switches to polling for
+ *               events from the event tasklet, 0 to disable polling.
+ * @poll_budget: Maximum number of consecutive polls before the RPU
+ *               interrupt is unmasked again.
+ * @poll_usecs: Time to keep polling for after the last poll which found
+ *              events, 0 to unmask the RPU interrupt on the first poll
+ *              which finds none.
+ *
+ * Return: Status
+ *		Pass : %NRF_WIFI_STATUS_SUCCESS
+ *		Error: %NRF_WIFI_STATUS_FAIL
+ */
+enum nrf_wifi_status nrf_wifi_hal_irq_mod_set(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
+					      unsigned int poll_thresh,
+					      unsigned int poll_budget,
+					      unsigned int poll_usecs);
+
+
+/**
+ * nrf_wifi_hal_irq_threaded_set() - Configure threaded handling of the RPU
+ *                                   interrupt.
+ * @hal_dev_ctx: Pointer to HAL context.
+ * @threaded: Whether the OS invokes the interrupt handler of the HAL from a
+ *            thread rather than from the hard interrupt context.
+ *
+ * This function should only be set to true when the OS never invokes the
+ * interrupt handler from the hard interrupt context, since the RX lock is
+ * then no longer taken with interrupts disabled.
+ *
+ * Return: Status
+ *		Pass : %NRF_WIFI_STATUS_SUCCESS
+ *		Error: %NRF_WIFI_STATUS_FAIL
+ */
+enum nrf_wifi_status nrf_wifi_hal_irq_threaded_set(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
+						   bool threaded);
+
 
 #ifdef CONFIG_NRF_WIFI_LOW_POWER
 enum nrf_wifi_status hal_rpu_ps_wake(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx);
@@ -58,4 +58,39 @@ enum nrf_wifi_status hal_rpu_irq_disable(struct nrf_wifi_hal_dev_ctx *hal_dev_ct
  *		Error: %NRF_WIFI_STATUS_FAIL
  */
 enum nrf_wifi_status hal_rpu_irq_process(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx);
+
+
+/**
+ * hal_rpu_irq_poll() - Polls for events from the RPU.
+ * @hal_dev_ctx: Pointer to HAL context.
+ *
+ * This function is called after the events have been processed, while the
+ * RPU interrupt is masked due to a high event rate. It fetches the events
+ * pending in the RPU, and asks to be called again as long as events keep
+ * coming in. Once they stop (or the poll budget is exhausted) it unmasks the
+ * RPU interrupt and checks for events one final time, so that no event which
+ * came in while the interrupt was masked goes unnoticed.
+ *
+ * It does not schedule anything itself, the caller processes the fetched
+ * events and polls again in the context the events are processed in.
+ *
+ * Return: True if events were fetched or the polling goes on, in which case
+ *         the events are to be processed and this function called again.
+ */
+bool hal_rpu_irq_poll(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx);
+
+
+/**
+ * hal_rpu_event_msg_free() - Frees an event received from the RPU.
+ * @hal_dev_ctx: Pointer to HAL context.
+ * @event: Event to be freed.
+ *
+ * This function returns the slot holding the event to the event ring of the
+ * device, or frees the event if it did not fit in a slot. Needs to be called
+ * with the RX lock of the device held.
+ *
+ * Return: None
+ */
+void hal_rpu_event_msg_free(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
+			    struct nrf_wifi_hal_msg *event);
 #endif /* __HAL_INTERRUPT_H__ */
@@ -20,9 +20,34 @@
 
 #define MAX_HAL_RPU_READY_WAIT (1 * 1000 * 1000) /* 1 sec */
 
+/* Number of preallocated slots events from the RPU are read into */
+#define HAL_EVENT_RING_SLOTS 32
+
+#ifdef HAL_CMD_ASYNC
+/* Interval at which queued commands are retried when no event comes */
+#define HAL_CMD_RETRY_INTERVAL_MS 1
+#endif /* HAL_CMD_ASYNC */
+
 #ifdef CONFIG_NRF_WIFI_LOW_POWER
 #define RPU_PS_WAKE_INTERVAL_MS 1
 #define RPU_PS_WAKE_TIMEOUT_S 1
+/* Delay after a wake request before the PS state is first polled, to avoid a
+ * race condition in the RPU.
+ * TODO: Reduce once sleep has been stabilized.
+ */
+#ifdef CONFIG_NRF700X_RPU_PS_WAKE_SETTLE_US
+#define RPU_PS_WAKE_SETTLE_US CONFIG_NRF700X_RPU_PS_WAKE_SETTLE_US
+#else
+#define RPU_PS_WAKE_SETTLE_US 200
+#endif /* CONFIG_NRF700X_RPU_PS_WAKE_SETTLE_US */
+/* Interval at which the PS state is polled again after a wake found the RPU
+ * not ready yet, doubled on every poll up to RPU_PS_WAKE_INTERVAL_MS.
+ */
+#define RPU_PS_WAKE_POLL_MIN_US 10
+/* Idle gaps are tracked in power of 2 buckets of 1 ms to 2^(N - 1) ms */
+#define RPU_PS_IDLE_HIST_BUCKETS 8
+/* Number of idle gaps after which the idle timeout is recomputed */
+#define RPU_PS_IDLE_HIST_SAMPLES 32
 #endif /* CONFIG_NRF_WIFI_LOW_POWER */
 
 
@@ -135,6 +160,16 @@ struct nrf_wifi_hal_priv {
  * @hpqm_info: HPQM queue(s) related information.
  * @rx_cmd_base: The base address for posting RX commands.
  * @tx_cmd_base: The base address for posting TX commands.
+ * @host_cmd_free_index: Host copy of the host owned index into the command
+ *                       buffer rings.
+ * @host_event_busy_index: Host copy of the host owned index into the event
+ *                         buffer rings.
+ * @host_tx_cmd_busy_index: Host copy of the host owned index into the TX
+ *                          command ring.
+ * @host_tx_done_busy_index: Host copy of the host owned index into the TX
+ *                           done ring.
+ * @cmd_free_addr: Free command buffer already read from the RPU and yet to
+ *                 be used, 0 if none.
  *
  * This structure contains RPU related information needed by the
  * HAL layer.
@@ -142,6 +177,14 @@ struct nrf_wifi_hal_priv {
 struct nrf_wifi_hal_info {
 #ifdef SOFT_HPQM
 	struct soft_hpqm_info *soft_hpq;
+	/* Only the host updates these indices, so the RPU copies are only
+	 * ever written to and never read back.
+	 */
+	unsigned int host_cmd_free_index;
+	unsigned int host_event_busy_index;
+	unsigned int host_tx_cmd_busy_index;
+	unsigned int host_tx_done_busy_index;
+	unsigned int cmd_free_addr;
 #endif /* SOFT_HPQM */
 	struct host_rpu_hpqm_info hpqm_info;
 	unsigned int rx_cmd_base;
@@ -169,9 +212,33 @@ struct nrf_wifi_hal_buf_map_info {
  * @rpu_info: RPU specific information necessary for the operation
  *            of the HAL.
  * @num_cmds: Debug counter for number of commands sent by the host to the RPU.
- * @cmd_q: Queue to hold commands before they are sent to the RPU.
+ * @cmd_q: Queue to hold commands before they are sent to the RPU. With
+ *         HAL_CMD_ASYNC commands stay here until the RPU has a free command
+ *         buffer for them.
+ * @cmd_retry_timer: With HAL_CMD_ASYNC, retries the commands left in @cmd_q
+ *                   in case no event comes to do it.
  * @event_q: Queue to hold events received from the RPU before they are
  *           processed by the host.
+ * @event_ring: Preallocated slots, each able to hold an unfragmented event,
+ *              which events from the RPU are read into.
+ * @event_ring_slot_sz: Size of a slot in @event_ring.
+ * @event_ring_head: Index of the next slot in @event_ring to be used.
+ * @event_ring_busy: Slots in @event_ring which hold events yet to be
+ *                   processed.
+ * @irq_poll_thresh: Number of events fetched in an interrupt at which the
+ *                   RPU interrupt is masked and events are polled for from
+ *                   the event tasklet (or the interrupt thread) instead, 0
+ *                   to never poll.
+ * @irq_poll_budget: Maximum number of consecutive polls before the RPU
+ *                   interrupt is unmasked again.
+ * @irq_poll_usecs: Time to keep polling for after the last event was seen.
+ * @irq_polling: Whether the RPU interrupt is masked and events are polled for.
+ * @irq_poll_cnt: Number of polls done since the RPU interrupt was masked.
+ * @irq_poll_last_us: Time at which a poll last found events.
+ * @irq_threaded: Whether the OS runs the interrupt handler in a thread, in
+ *                which case the RX lock is taken without disabling
+ *                interrupts and the events are processed and polled for
+ *                right away instead of in the event tasklet.
  * @curr_proc: The RPU MCU whose context is active for a given HAL operation.
  *             This is needed only during FW loading and not necessary during
  *             the regular operation after the FW has been loaded.
@@ -182,6 +249,20 @@ struct nrf_wifi_hal_buf_map_info {
  * @rpu_ps_timer: Inactivity timer used to put RPU back to sleep after
  *                waking it up.
  * @rpu_ps_lock: Lock to be used for atomic RPU PS operations.
+ * @rpu_ps_idle_timeout_ms: Current inactivity period after which the RPU is
+ *                          put back to sleep.
+ * @rpu_ps_last_access_us: Time of the last access to the RPU.
+ * @rpu_ps_idle_hist: Histogram of the gaps between accesses to the RPU which
+ *                    were long enough to let it go to sleep with the
+ *                    default idle timeout.
+ * @rpu_ps_idle_hist_cnt: Number of gaps added to @rpu_ps_idle_hist since the
+ *                        idle timeout was last recomputed.
+ * @rom_access_reg_offset: Host offset of the ROM access register, resolved
+ *                         once since every RAM/ROM access goes through it.
+ * @rom_access_reg_val: Value last written to the ROM access register.
+ * @rom_access_reg_valid: Whether @rom_access_reg_val reflects the register,
+ *                        cleared whenever the RPU could have lost its state
+ *                        (reset, sleep).
  * @num_isrs: Debug counter for number of interrupts received from the RPU.
  * @num_events: Debug counter for number of events received from the RPU.
  * @num_events_resubmit: Debug counter for number of event pointers
@@ -202,9 +283,32 @@ struct nrf_wifi_hal_dev_ctx {
 
 	unsigned int num_cmds;
 
+	/* While tx_batch_depth is non zero, TX data commands sent by the batch
+	 * owner are only queued and the RPU is told about them (busy index
+	 * update and doorbell) once, when the outermost batch ends.
+	 */
+	unsigned int tx_batch_depth;
+	unsigned int tx_batch_pending;
+
 	void *cmd_q;
+#ifdef HAL_CMD_ASYNC
+	void *cmd_retry_timer;
+#endif /* HAL_CMD_ASYNC */
 	void *event_q;
 
+	char *event_ring;
+	unsigned int event_ring_slot_sz;
+	unsigned int event_ring_head;
+	bool event_ring_busy[HAL_EVENT_RING_SLOTS];
+
+	unsigned int irq_poll_thresh;
+	unsigned int irq_poll_budget;
+	unsigned int irq_poll_usecs;
+	bool irq_polling;
+	unsigned int irq_poll_cnt;
+	unsigned long irq_poll_last_us;
+	bool irq_threaded;
+
 	/* This is only used during FW loading where we need the information
 	 * about the processor whose core memory the code/data needs to be
 	 * loaded into (since the FW image parser does not have the processor
@@ -228,15 +332,24 @@ struct nrf_wifi_hal_dev_ctx {
 #ifdef INLINE_RX
 	unsigned long addr_rpu_host_ram_base;
 #endif
+#ifdef SOC_WEZEN
+	unsigned long rom_access_reg_offset;
+	unsigned int rom_access_reg_val;
+	bool rom_access_reg_valid;
+#endif /* SOC_WEZEN */
 #ifdef CONFIG_NRF_WIFI_LOW_POWER
 	enum RPU_PS_STATE rpu_ps_state;
 	void *rpu_ps_timer;
 	void *rpu_ps_lock;
+	unsigned int rpu_ps_idle_timeout_ms;
+	unsigned long rpu_ps_last_access_us;
+	unsigned int rpu_ps_idle_hist[RPU_PS_IDLE_HIST_BUCKETS];
+	unsigned int rpu_ps_idle_hist_cnt;
 	bool dbg_enable;
 	bool irq_ctx;
 	bool rpu_fw_booted;
 #endif /* CONFIG_NRF_WIFI_LOW_POWER */
-	char *event_data;
+	struct nrf_wifi_hal_msg *event;
 	char *event_data_curr;
 	unsigned int event_data_len;
 	unsigned int event_data_pending;
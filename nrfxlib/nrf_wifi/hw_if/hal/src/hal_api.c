@@ -36,6 +36,8 @@ static enum nrf_wifi_status hal_rpu_hard_rst(struct nrf_wifi_hal_dev_ctx *hal_de
                                         hard_rst_reg_offset,
                                         hard_rst_val);
 
+                hal_dev_ctx->rom_access_reg_valid = false;
+
                 nrf_wifi_osal_sleep_ms(hal_dev_ctx->hpriv->opriv,
                                       500);
 		status = NRF_WIFI_STATUS_SUCCESS;
@@ -295,6 +297,30 @@ unsigned long nrf_wifi_hal_buf_map_rx(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
 		goto out;
 	}
 
+#ifdef INLINE_RX_ZERO_COPY
+	/* The RPU writes the frame straight into the host buffer past the
+	 * headroom (which already carries the descriptor ID), so there is no
+	 * bounce buffer to stage the headroom in or to copy the frame out of.
+	 * The whole buffer is mapped, as the headroom is read by the RPU, and
+	 * the RPU is given the address of the frame in it.
+	 */
+	addr_to_map = nrf_wifi_bal_dma_map(hal_dev_ctx->bal_dev_ctx,
+					   buf,
+					   buf_len,
+					   NRF_WIFI_OSAL_DMA_DIR_BIDI);
+
+	if (!addr_to_map) {
+		nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
+				      "%s: DMA map failed\n",
+				      __func__);
+		goto out;
+	}
+
+	rx_buf_info->phy_addr = addr_to_map + hal_dev_ctx->hpriv->cfg_params.rx_buf_headroom_sz;
+
+	goto out;
+#endif /* INLINE_RX_ZERO_COPY */
+
 	bounce_buf_addr = hal_dev_ctx->addr_rpu_pktram_base_rx_pool[pool_id] +
 		(buf_id * buf_len);
 #ifdef SOC_WEZEN
@@ -374,6 +400,26 @@ unsigned long nrf_wifi_hal_buf_unmap_rx(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx
 		goto out;
 	}
 
+#ifdef INLINE_RX_ZERO_COPY
+	/* The frame is already in place in the host buffer, only the
+	 * mapping needs to be torn down before the buffer is handed over.
+	 */
+	unmapped_addr = nrf_wifi_bal_dma_unmap(hal_dev_ctx->bal_dev_ctx,
+					       rx_buf_info->phy_addr -
+					       hal_dev_ctx->hpriv->cfg_params.rx_buf_headroom_sz,
+					       rx_buf_info->buf_len,
+					       NRF_WIFI_OSAL_DMA_DIR_BIDI);
+
+	if (!unmapped_addr) {
+		nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
+				      "%s: DMA unmap failed\n",
+				      __func__);
+		goto out;
+	}
+
+	goto unmapped;
+#endif /* INLINE_RX_ZERO_COPY */
+
 #ifdef SOC_WEZEN
 #ifdef INLINE_RX
 	unmapped_addr = nrf_wifi_bal_dma_unmap_inline_rx(hal_dev_ctx->bal_dev_ctx,
@@ -421,6 +467,9 @@ unsigned long nrf_wifi_hal_buf_unmap_rx(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx
 #endif
 	}
 
+#ifdef INLINE_RX_ZERO_COPY
+unmapped:
+#endif /* INLINE_RX_ZERO_COPY */
 	virt_addr = rx_buf_info->virt_addr;
 
 	nrf_wifi_osal_mem_set(hal_dev_ctx->hpriv->opriv,
@@ -562,13 +611,72 @@ out:
 
 
 #ifdef CONFIG_NRF_WIFI_LOW_POWER
+static void hal_rpu_ps_idle_update(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
+{
+	unsigned long curr_time_us = 0;
+	unsigned long gap_ms = 0;
+	unsigned int bucket = 0;
+	unsigned int cnt = 0;
+	unsigned int i = 0;
+
+	curr_time_us = nrf_wifi_osal_time_get_curr_us(hal_dev_ctx->hpriv->opriv);
+
+	gap_ms = (curr_time_us - hal_dev_ctx->rpu_ps_last_access_us) / 1000;
+
+	hal_dev_ctx->rpu_ps_last_access_us = curr_time_us;
+
+	/* Gaps within a burst do not let the RPU sleep with the default
+	 * timeout either, so they have no say in the idle timeout.
+	 */
+	if (gap_ms < CONFIG_NRF700X_RPU_PS_IDLE_TIMEOUT_MS) {
+		return;
+	}
+
+	while ((bucket < (RPU_PS_IDLE_HIST_BUCKETS - 1)) &&
+	       (gap_ms >= (1UL << bucket))) {
+		bucket++;
+	}
+
+	hal_dev_ctx->rpu_ps_idle_hist[bucket]++;
+
+	if (++hal_dev_ctx->rpu_ps_idle_hist_cnt < RPU_PS_IDLE_HIST_SAMPLES) {
+		return;
+	}
+
+	/* Stay awake across 7/8th of the gaps seen, unless most of them are
+	 * beyond the histogram in which case sleeping early saves more power.
+	 */
+	for (i = 0; i < RPU_PS_IDLE_HIST_BUCKETS; i++) {
+		cnt += hal_dev_ctx->rpu_ps_idle_hist[i];
+
+		if (cnt >= ((hal_dev_ctx->rpu_ps_idle_hist_cnt * 7) / 8)) {
+			break;
+		}
+	}
+
+	if ((i < (RPU_PS_IDLE_HIST_BUCKETS - 1)) &&
+	    ((1U << i) > CONFIG_NRF700X_RPU_PS_IDLE_TIMEOUT_MS)) {
+		hal_dev_ctx->rpu_ps_idle_timeout_ms = (1U << i);
+	} else {
+		hal_dev_ctx->rpu_ps_idle_timeout_ms = CONFIG_NRF700X_RPU_PS_IDLE_TIMEOUT_MS;
+	}
+
+	/* Age the history so that the timeout follows changes in traffic */
+	hal_dev_ctx->rpu_ps_idle_hist_cnt = 0;
+
+	for (i = 0; i < RPU_PS_IDLE_HIST_BUCKETS; i++) {
+		hal_dev_ctx->rpu_ps_idle_hist[i] /= 2;
+		hal_dev_ctx->rpu_ps_idle_hist_cnt += hal_dev_ctx->rpu_ps_idle_hist[i];
+	}
+}
+
+
 enum nrf_wifi_status hal_rpu_ps_wake(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
 {
 	unsigned int reg_val = 0;
 	unsigned int rpu_ps_state_mask = 0;
 	unsigned long start_time_us = 0;
-	unsigned long idle_time_start_us = 0;
-	unsigned long idle_time_us = 0;
+	unsigned long poll_us = RPU_PS_WAKE_POLL_MIN_US;
 	unsigned long elapsed_time_sec = 0;
 	unsigned long elapsed_time_usec = 0;
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
@@ -601,9 +709,8 @@ enum nrf_wifi_status hal_rpu_ps_wake(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
 			     (1 << RPU_REG_BIT_READY_STATE));
 
 	/* Add a delay to avoid a race condition in the RPU */
-	/* TODO: Reduce to 200 us after sleep has been stabilized */
 	nrf_wifi_osal_delay_us(hal_dev_ctx->hpriv->opriv,
-			       1000);
+			       RPU_PS_WAKE_SETTLE_US);
 
 	do {
 		/* Poll the RPU PS state */
@@ -614,12 +721,17 @@ enum nrf_wifi_status hal_rpu_ps_wake(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
 			break;
 		}
 
-		idle_time_start_us = nrf_wifi_osal_time_get_curr_us(hal_dev_ctx->hpriv->opriv);
+		/* Back off exponentially so that a quick wake is seen early
+		 * without hammering the bus during a slow one. This is a busy
+		 * wait, the callers hold spinlocks, so the overshoot past the
+		 * wake is kept to the last step.
+		 */
+		nrf_wifi_osal_delay_us(hal_dev_ctx->hpriv->opriv,
+				       poll_us);
 
-		do {
-			idle_time_us = nrf_wifi_osal_time_elapsed_us(hal_dev_ctx->hpriv->opriv,
-								     idle_time_start_us);
-		} while ((idle_time_us / 1000) < RPU_PS_WAKE_INTERVAL_MS);
+		if (poll_us < (RPU_PS_WAKE_INTERVAL_MS * 1000)) {
+			poll_us *= 2;
+		}
 
 		elapsed_time_usec = nrf_wifi_osal_time_elapsed_us(hal_dev_ctx->hpriv->opriv,
 								  start_time_us);
@@ -639,10 +751,12 @@ enum nrf_wifi_status hal_rpu_ps_wake(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
 	hal_dev_ctx->rpu_ps_state = RPU_PS_STATE_AWAKE;
 
 out:
+	hal_rpu_ps_idle_update(hal_dev_ctx);
+
 	if (!hal_dev_ctx->irq_ctx) {
 		nrf_wifi_osal_timer_schedule(hal_dev_ctx->hpriv->opriv,
 					     hal_dev_ctx->rpu_ps_timer,
-					     CONFIG_NRF700X_RPU_PS_IDLE_TIMEOUT_MS);
+					     hal_dev_ctx->rpu_ps_idle_timeout_ms);
 	}
 	return status;
 }
@@ -662,6 +776,9 @@ static void hal_rpu_ps_sleep(unsigned long data)
 	nrf_wifi_bal_rpu_ps_sleep(hal_dev_ctx->bal_dev_ctx);
 
 	hal_dev_ctx->rpu_ps_state = RPU_PS_STATE_ASLEEP;
+#ifdef SOC_WEZEN
+	hal_dev_ctx->rom_access_reg_valid = false;
+#endif /* SOC_WEZEN */
 
 	nrf_wifi_osal_spinlock_irq_rel(hal_dev_ctx->hpriv->opriv,
 				       hal_dev_ctx->rpu_ps_lock,
@@ -702,6 +819,8 @@ static enum nrf_wifi_status hal_rpu_ps_init(struct nrf_wifi_hal_dev_ctx *hal_dev
 				 (unsigned long)hal_dev_ctx);
 
 	hal_dev_ctx->rpu_ps_state = RPU_PS_STATE_ASLEEP;
+	hal_dev_ctx->rpu_ps_idle_timeout_ms = CONFIG_NRF700X_RPU_PS_IDLE_TIMEOUT_MS;
+	hal_dev_ctx->rpu_ps_last_access_us = nrf_wifi_osal_time_get_curr_us(hal_dev_ctx->hpriv->opriv);
 	hal_dev_ctx->dbg_enable = true;
 
 	status = NRF_WIFI_STATUS_SUCCESS;
@@ -755,42 +874,89 @@ out:
 static bool hal_rpu_soft_hpq_is_empty(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
 {
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
-	unsigned int val = 0;
 	unsigned int current_index = 0;
 
-	status = hal_rpu_mem_read(hal_dev_ctx,
-                                  &current_index,
-                                  &hal_dev_ctx->rpu_info.soft_hpq->host_cmd_free_index,
-				  sizeof(unsigned int));
+	/* A free command buffer seen earlier has not been used yet */
+	if (hal_dev_ctx->rpu_info.cmd_free_addr) {
+		return false;
+	}
 
-        if (status != NRF_WIFI_STATUS_SUCCESS) {
-                nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
-                                      "%s: Read from the host_event_busy_index = %x address failed, val (0x%X)\n",
-                                       __func__,
-                                       &hal_dev_ctx->rpu_info.soft_hpq->host_cmd_free_index,
-                                       current_index);
-                return true;
-        }
+	current_index = hal_dev_ctx->rpu_info.host_cmd_free_index;
 
 	status = hal_rpu_mem_read(hal_dev_ctx,
-				  &val,
+				  &hal_dev_ctx->rpu_info.cmd_free_addr,
 				  &hal_dev_ctx->rpu_info.soft_hpq->cmd_free_buffs[current_index],
 				  sizeof(unsigned int));
 
 	if (status != NRF_WIFI_STATUS_SUCCESS) {
 		nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
-				      "%s: Read from dequeue address failed, val (0x%X)\n",
+				      "%s: Read from cmd_free_buffs[%d] failed\n",
 				      __func__,
-				      val);
+				      current_index);
+		hal_dev_ctx->rpu_info.cmd_free_addr = 0;
 		return true;
 	}
-	if (val) {
+
+	if (hal_dev_ctx->rpu_info.cmd_free_addr) {
 		return false;
 	}
 
 	return true;
 }
 
+
+static enum nrf_wifi_status hal_rpu_soft_hpq_idx_sync(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	struct soft_hpqm_info *soft_hpq = hal_dev_ctx->rpu_info.soft_hpq;
+
+	status = hal_rpu_mem_read(hal_dev_ctx,
+				  &hal_dev_ctx->rpu_info.host_cmd_free_index,
+				  &soft_hpq->host_cmd_free_index,
+				  sizeof(unsigned int));
+
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		goto out;
+	}
+
+	status = hal_rpu_mem_read(hal_dev_ctx,
+				  &hal_dev_ctx->rpu_info.host_event_busy_index,
+				  &soft_hpq->host_event_busy_index,
+				  sizeof(unsigned int));
+
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		goto out;
+	}
+
+	status = hal_rpu_mem_read(hal_dev_ctx,
+				  &hal_dev_ctx->rpu_info.host_tx_cmd_busy_index,
+				  &soft_hpq->host_tx_cmd_busy_index,
+				  sizeof(unsigned int));
+
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		goto out;
+	}
+
+	status = hal_rpu_mem_read(hal_dev_ctx,
+				  &hal_dev_ctx->rpu_info.host_tx_done_busy_index,
+				  &soft_hpq->host_tx_done_busy_index,
+				  sizeof(unsigned int));
+
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		goto out;
+	}
+
+	hal_dev_ctx->rpu_info.cmd_free_addr = 0;
+out:
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
+				      "%s: Reading of the SOFT HPQM indices failed\n",
+				      __func__);
+	}
+
+	return status;
+}
+
 static enum nrf_wifi_status hal_rpu_ready(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
 					  enum NRF_WIFI_HAL_MSG_TYPE msg_type)
 {
@@ -871,6 +1037,7 @@ static enum nrf_wifi_status hal_rpu_ready(struct nrf_wifi_hal_dev_ctx *hal_dev_c
 }
 #endif /* SOFT_HPQM */
 
+#ifndef HAL_CMD_ASYNC
 static enum nrf_wifi_status hal_rpu_ready_wait(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
 					       enum NRF_WIFI_HAL_MSG_TYPE msg_type)
 {
@@ -894,6 +1061,7 @@ static enum nrf_wifi_status hal_rpu_ready_wait(struct nrf_wifi_hal_dev_ctx *hal_
 out:
 	return status;
 }
+#endif /* !HAL_CMD_ASYNC */
 
 
 static enum nrf_wifi_status hal_rpu_msg_trigger(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
@@ -924,10 +1092,10 @@ out:
 static enum nrf_wifi_status hal_rpu_msg_post(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
 					     enum NRF_WIFI_HAL_MSG_TYPE msg_type,
 					     unsigned int queue_id,
-					     unsigned int msg_addr)
+					     unsigned int msg_addr,
+					     bool batch)
 {
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
-	struct host_rpu_hpq *busy_queue = NULL;
 	unsigned int current_index = 0;
 
 	if (queue_id >= MAX_NUM_OF_RX_QUEUES) {
@@ -939,24 +1107,11 @@ static enum nrf_wifi_status hal_rpu_msg_post(struct nrf_wifi_hal_dev_ctx *hal_de
 	}
 
 	if (msg_type == NRF_WIFI_HAL_MSG_TYPE_CMD_CTRL) {
-		status = hal_rpu_mem_read(hal_dev_ctx,
-                                          &current_index,
-                                          &hal_dev_ctx->rpu_info.soft_hpq->host_cmd_free_index,
-					  sizeof(unsigned int));
-
-                if (status != NRF_WIFI_STATUS_SUCCESS) {
-                        nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
-                                              "%s: Read from the host_cmd_free_index = %x address failed, val (0x%X)\n",
-                                              __func__,
-                                              &hal_dev_ctx->rpu_info.soft_hpq->host_cmd_free_index,
-                                              current_index);
-                        goto out;
-                }
-
+		current_index = hal_dev_ctx->rpu_info.host_cmd_free_index;
 
 		status = hal_rpu_mem_write(hal_dev_ctx,
 					   &hal_dev_ctx->rpu_info.soft_hpq->cmd_busy_buffs[current_index],
-					   msg_addr,
+					   &msg_addr,
 					   sizeof(unsigned int));
 
 		if (status != NRF_WIFI_STATUS_SUCCESS) {
@@ -975,7 +1130,7 @@ static enum nrf_wifi_status hal_rpu_msg_post(struct nrf_wifi_hal_dev_ctx *hal_de
 
 		status = hal_rpu_mem_write(hal_dev_ctx,
 					   &hal_dev_ctx->rpu_info.soft_hpq->host_cmd_free_index,
-					   current_index,
+					   &current_index,
 					   sizeof(unsigned int));
 
 		if (status != NRF_WIFI_STATUS_SUCCESS) {
@@ -986,23 +1141,17 @@ static enum nrf_wifi_status hal_rpu_msg_post(struct nrf_wifi_hal_dev_ctx *hal_de
 					      current_index);
 			goto out;
 		}
+
+		hal_dev_ctx->rpu_info.host_cmd_free_index = current_index;
 	} else if (msg_type == NRF_WIFI_HAL_MSG_TYPE_CMD_DATA_TX) {
-		status = hal_rpu_mem_read(hal_dev_ctx,
-					  &current_index,
-					  &hal_dev_ctx->rpu_info.soft_hpq->host_tx_cmd_busy_index,
-					  sizeof (unsigned int));
+		/* The host copy is current even when the RPU copy has not been
+		 * updated yet due to an ongoing batch.
+		 */
+		current_index = hal_dev_ctx->rpu_info.host_tx_cmd_busy_index;
 
-		if (status != NRF_WIFI_STATUS_SUCCESS) {
-                        nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
-                                              "%s: Read from the host_event_busy_index = %x address failed, val (0x%X)\n",
-                                               __func__,
-                                               &hal_dev_ctx->rpu_info.soft_hpq->host_tx_cmd_busy_index,
-                                               current_index);
-                        goto out;
-                }
 		status = hal_rpu_mem_write(hal_dev_ctx,
 					   &hal_dev_ctx->rpu_info.soft_hpq->tx_cmd_buffs[current_index],
-					   msg_addr,
+					   &msg_addr,
 					   sizeof(unsigned int));
 		if (status != NRF_WIFI_STATUS_SUCCESS) {
 			nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
@@ -1018,9 +1167,19 @@ static enum nrf_wifi_status hal_rpu_msg_post(struct nrf_wifi_hal_dev_ctx *hal_de
 		if (current_index == HOST_RPU_TX_DESC)
                         current_index = 0;
 
+		hal_dev_ctx->rpu_info.host_tx_cmd_busy_index = current_index;
+
+		if (batch && hal_dev_ctx->tx_batch_depth) {
+			hal_dev_ctx->tx_batch_pending++;
+			goto out;
+		}
+
+		/* The index covers the commands held back by the batch too */
+		hal_dev_ctx->tx_batch_pending = 0;
+
 		status = hal_rpu_mem_write(hal_dev_ctx,
 					   &hal_dev_ctx->rpu_info.soft_hpq->host_tx_cmd_busy_index,
-					   current_index,
+					   &current_index,
 					   sizeof(unsigned int));
 
 		if (status != NRF_WIFI_STATUS_SUCCESS) {
@@ -1032,7 +1191,7 @@ static enum nrf_wifi_status hal_rpu_msg_post(struct nrf_wifi_hal_dev_ctx *hal_de
 			goto out;
 		}
 	} else if (msg_type == NRF_WIFI_HAL_MSG_TYPE_CMD_DATA_RX) {
-		busy_queue = &hal_dev_ctx->rpu_info.hpqm_info.rx_buf_busy_queue[queue_id];
+		/* Nothing to post for RX buffers */
 	} else {
 		nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
 				      "%s: Invalid msg_type (%d)\n",
@@ -1063,36 +1222,7 @@ static enum nrf_wifi_status hal_rpu_msg_get_addr(struct nrf_wifi_hal_dev_ctx *ha
 	unsigned int val = 0;
         unsigned int current_index = 0;
 
-	if (msg_type == NRF_WIFI_HAL_MSG_TYPE_CMD_CTRL) {
-		status = hal_rpu_mem_read(hal_dev_ctx,
-					  &current_index,
-					  &hal_dev_ctx->rpu_info.soft_hpq->host_cmd_free_index,
-					  sizeof (unsigned int));
-
-		if (status != NRF_WIFI_STATUS_SUCCESS) {
-			nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
-					      "%s: Read from the host_event_busy_index = %x address failed, val (0x%X)\n",
-					      __func__,
-					      &hal_dev_ctx->rpu_info.soft_hpq->host_cmd_free_index,
-					      current_index);
-			goto out;
-		}
-
-		status = hal_rpu_mem_read(hal_dev_ctx,
-					  &val,
-					  &hal_dev_ctx->rpu_info.soft_hpq->cmd_free_buffs[current_index],
-					  sizeof (unsigned int));
-
-		if (status != NRF_WIFI_STATUS_SUCCESS) {
-			nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
-					      "%s: Read from the cmd_free_buffs[%d] = %x address failed, val (0x%X)\n",
-					      __func__,
-					      current_index,
-					      &hal_dev_ctx->rpu_info.soft_hpq->cmd_free_buffs[current_index],
-					      val);
-			goto out;
-		}
-	} else {
+	if (msg_type != NRF_WIFI_HAL_MSG_TYPE_CMD_CTRL) {
 		nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
 				      "%s: Invalid msg type %d\n",
 				      __func__,
@@ -1100,34 +1230,38 @@ static enum nrf_wifi_status hal_rpu_msg_get_addr(struct nrf_wifi_hal_dev_ctx *ha
 		return NRF_WIFI_STATUS_FAIL;
 	}
 
+	current_index = hal_dev_ctx->rpu_info.host_cmd_free_index;
 
-	if (!val) {
+	/* Usually the free buffer has already been read while waiting for
+	 * the RPU to be ready.
+	 */
+	if (hal_rpu_soft_hpq_is_empty(hal_dev_ctx)) {
 		nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
-				      "%s:No valid content avaialble in the expected index \n",
+				      "%s:No valid content avaialble in the expected index %d\n",
 				      __func__,
 				      current_index);
 		*msg_addr = 0;
 		status = NRF_WIFI_STATUS_FAIL;
 		goto out;
-	} else {
-		/* Valid address has been read. So write back 0 to same index address at cmd_free_buffs*/
-		status = hal_rpu_mem_write(hal_dev_ctx,
-					   &hal_dev_ctx->rpu_info.soft_hpq->cmd_free_buffs[current_index],
-					   0x0,
-					   sizeof(unsigned int));
+	}
 
-		if (status != NRF_WIFI_STATUS_SUCCESS) {
-			nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
-					      "%s: Write to address %xfailed, val (0x%X)\n",
-					      __func__,
-					      &hal_dev_ctx->rpu_info.soft_hpq->cmd_free_buffs[current_index],
-					      0x0);
-			return true;
-		}
+	/* Valid address has been read. So write back 0 to same index address at cmd_free_buffs*/
+	status = hal_rpu_mem_write(hal_dev_ctx,
+				   &hal_dev_ctx->rpu_info.soft_hpq->cmd_free_buffs[current_index],
+				   &val,
+				   sizeof(unsigned int));
 
-		*msg_addr = val; /* Assign the address read from cmd_free_buffs current_index */
-		status = NRF_WIFI_STATUS_SUCCESS;
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
+				      "%s: Write to address %xfailed, val (0x%X)\n",
+				      __func__,
+				      &hal_dev_ctx->rpu_info.soft_hpq->cmd_free_buffs[current_index],
+				      0x0);
+		goto out;
 	}
+
+	*msg_addr = hal_dev_ctx->rpu_info.cmd_free_addr; /* Assign the address read from cmd_free_buffs current_index */
+	hal_dev_ctx->rpu_info.cmd_free_addr = 0;
 out:
 	return status;
 }
@@ -1136,7 +1270,8 @@ out:
 static enum nrf_wifi_status hal_rpu_msg_post(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
 					     enum NRF_WIFI_HAL_MSG_TYPE msg_type,
 					     unsigned int queue_id,
-					     unsigned int msg_addr)
+					     unsigned int msg_addr,
+					     bool batch)
 {
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 	struct host_rpu_hpq *busy_queue = NULL;
@@ -1176,6 +1311,16 @@ static enum nrf_wifi_status hal_rpu_msg_post(struct nrf_wifi_hal_dev_ctx *hal_de
 		goto out;
 	}
 
+	if (msg_type == NRF_WIFI_HAL_MSG_TYPE_CMD_DATA_TX) {
+		if (batch && hal_dev_ctx->tx_batch_depth) {
+			hal_dev_ctx->tx_batch_pending++;
+			goto out;
+		}
+
+		/* The doorbell covers the commands held back by the batch too */
+		hal_dev_ctx->tx_batch_pending = 0;
+	}
+
 	if (msg_type != NRF_WIFI_HAL_MSG_TYPE_CMD_DATA_RX) {
 		/* Indicate to the RPU that the information has been posted */
 		status = hal_rpu_msg_trigger(hal_dev_ctx);
@@ -1266,7 +1411,8 @@ static enum nrf_wifi_status hal_rpu_msg_write(struct nrf_wifi_hal_dev_ctx *hal_d
 	status = hal_rpu_msg_post(hal_dev_ctx,
 				  msg_type,
 				  0,
-				  msg_addr);
+				  msg_addr,
+				  false);
 
 	if (status != NRF_WIFI_STATUS_SUCCESS) {
 		nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
@@ -1285,8 +1431,29 @@ static enum nrf_wifi_status hal_rpu_cmd_process_queue(struct nrf_wifi_hal_dev_ct
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 	struct nrf_wifi_hal_msg *cmd = NULL;
 
-	while ((cmd = nrf_wifi_utils_q_dequeue(hal_dev_ctx->hpriv->opriv,
-					       hal_dev_ctx->cmd_q))) {
+	while ((cmd = nrf_wifi_utils_q_peek(hal_dev_ctx->hpriv->opriv,
+					    hal_dev_ctx->cmd_q))) {
+#ifdef HAL_CMD_ASYNC
+		/* Instead of waiting for the RPU to free a command buffer leave
+		 * the command queued, the queue is processed again from the
+		 * event tasklet once the RPU has consumed earlier commands, on
+		 * the next send or from the retry timer, whichever comes first.
+		 */
+		if (hal_rpu_ready(hal_dev_ctx,
+				  NRF_WIFI_HAL_MSG_TYPE_CMD_CTRL) != NRF_WIFI_STATUS_SUCCESS) {
+			nrf_wifi_osal_timer_schedule(hal_dev_ctx->hpriv->opriv,
+						     hal_dev_ctx->cmd_retry_timer,
+						     HAL_CMD_RETRY_INTERVAL_MS);
+			status = NRF_WIFI_STATUS_SUCCESS;
+			break;
+		}
+
+		nrf_wifi_utils_q_dequeue(hal_dev_ctx->hpriv->opriv,
+					 hal_dev_ctx->cmd_q);
+#else
+		nrf_wifi_utils_q_dequeue(hal_dev_ctx->hpriv->opriv,
+					 hal_dev_ctx->cmd_q);
+
 		status = hal_rpu_ready_wait(hal_dev_ctx,
 					    NRF_WIFI_HAL_MSG_TYPE_CMD_CTRL);
 
@@ -1299,6 +1466,7 @@ static enum nrf_wifi_status hal_rpu_cmd_process_queue(struct nrf_wifi_hal_dev_ct
 			cmd = NULL;
 			continue;
 		}
+#endif /* HAL_CMD_ASYNC */
 
 		status = hal_rpu_msg_write(hal_dev_ctx,
 					   NRF_WIFI_HAL_MSG_TYPE_CMD_CTRL,
@@ -1325,6 +1493,29 @@ static enum nrf_wifi_status hal_rpu_cmd_process_queue(struct nrf_wifi_hal_dev_ct
 }
 
 
+#ifdef HAL_CMD_ASYNC
+static void hal_rpu_cmd_process_pending(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
+{
+	nrf_wifi_osal_spinlock_take(hal_dev_ctx->hpriv->opriv,
+				    hal_dev_ctx->lock_hal);
+
+	if (nrf_wifi_utils_q_len(hal_dev_ctx->hpriv->opriv,
+				 hal_dev_ctx->cmd_q)) {
+		hal_rpu_cmd_process_queue(hal_dev_ctx);
+	}
+
+	nrf_wifi_osal_spinlock_rel(hal_dev_ctx->hpriv->opriv,
+				   hal_dev_ctx->lock_hal);
+}
+
+
+static void hal_rpu_cmd_retry(unsigned long data)
+{
+	hal_rpu_cmd_process_pending((struct nrf_wifi_hal_dev_ctx *)data);
+}
+#endif /* HAL_CMD_ASYNC */
+
+
 static enum nrf_wifi_status hal_rpu_cmd_queue(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
 					      void *cmd,
 					      unsigned int cmd_size)
@@ -1453,7 +1644,8 @@ enum nrf_wifi_status nrf_wifi_hal_data_cmd_send(struct nrf_wifi_hal_dev_ctx *hal
 						void *cmd,
 						unsigned int cmd_size,
 						unsigned int desc_id,
-						unsigned int pool_id)
+						unsigned int pool_id,
+						bool batch)
 {
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 	unsigned int addr_base = 0;
@@ -1508,7 +1700,8 @@ enum nrf_wifi_status nrf_wifi_hal_data_cmd_send(struct nrf_wifi_hal_dev_ctx *hal
 	status = hal_rpu_msg_post(hal_dev_ctx,
 				  cmd_type,
 				  pool_id,
-				  addr);
+				  addr,
+				  batch);
 
 	if (status != NRF_WIFI_STATUS_SUCCESS) {
 		nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
@@ -1525,12 +1718,88 @@ out:
 }
 
 
-static void event_tasklet_fn(unsigned long data)
+static enum nrf_wifi_status hal_rpu_tx_batch_flush(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
 {
-	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
-	struct nrf_wifi_hal_dev_ctx *hal_dev_ctx = NULL;
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_SUCCESS;
 
-	hal_dev_ctx = (struct nrf_wifi_hal_dev_ctx *)data;
+	if (!hal_dev_ctx->tx_batch_pending) {
+		goto out;
+	}
+
+#ifdef SOFT_HPQM
+	status = hal_rpu_mem_write(hal_dev_ctx,
+				   &hal_dev_ctx->rpu_info.soft_hpq->host_tx_cmd_busy_index,
+				   &hal_dev_ctx->rpu_info.host_tx_cmd_busy_index,
+				   sizeof(unsigned int));
+
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
+				      "%s: Writing to host_tx_cmd_busy_index failed for val =%d\n",
+				      __func__,
+				      hal_dev_ctx->rpu_info.host_tx_cmd_busy_index);
+		goto out;
+	}
+#endif /* SOFT_HPQM */
+
+	hal_dev_ctx->tx_batch_pending = 0;
+
+	/* Indicate to the RPU that the information has been posted */
+	status = hal_rpu_msg_trigger(hal_dev_ctx);
+
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
+				      "%s: Posting command to RPU failed\n",
+				      __func__);
+		goto out;
+	}
+out:
+	return status;
+}
+
+
+void nrf_wifi_hal_data_cmd_batch_start(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
+{
+	nrf_wifi_osal_spinlock_take(hal_dev_ctx->hpriv->opriv,
+				    hal_dev_ctx->lock_hal);
+
+	hal_dev_ctx->tx_batch_depth++;
+
+	nrf_wifi_osal_spinlock_rel(hal_dev_ctx->hpriv->opriv,
+				   hal_dev_ctx->lock_hal);
+}
+
+
+enum nrf_wifi_status nrf_wifi_hal_data_cmd_batch_end(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_SUCCESS;
+
+	nrf_wifi_osal_spinlock_take(hal_dev_ctx->hpriv->opriv,
+				    hal_dev_ctx->lock_hal);
+
+	if (!hal_dev_ctx->tx_batch_depth) {
+		nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
+				      "%s: No batch in progress\n",
+				      __func__);
+		status = NRF_WIFI_STATUS_FAIL;
+		goto out;
+	}
+
+	hal_dev_ctx->tx_batch_depth--;
+
+	if (!hal_dev_ctx->tx_batch_depth) {
+		status = hal_rpu_tx_batch_flush(hal_dev_ctx);
+	}
+out:
+	nrf_wifi_osal_spinlock_rel(hal_dev_ctx->hpriv->opriv,
+				   hal_dev_ctx->lock_hal);
+
+	return status;
+}
+
+
+static void hal_rpu_events_dispatch(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 
 	status = hal_rpu_eventq_process(hal_dev_ctx);
 
@@ -1539,6 +1808,29 @@ static void event_tasklet_fn(unsigned long data)
 				      "%s: Event queue processing failed\n",
 				      __func__);
 	}
+
+#ifdef HAL_CMD_ASYNC
+	/* Events are a sign of the RPU having consumed commands, send any
+	 * commands which were waiting for a free command buffer.
+	 */
+	hal_rpu_cmd_process_pending(hal_dev_ctx);
+#endif /* HAL_CMD_ASYNC */
+}
+
+
+static void event_tasklet_fn(unsigned long data)
+{
+	struct nrf_wifi_hal_dev_ctx *hal_dev_ctx = NULL;
+
+	hal_dev_ctx = (struct nrf_wifi_hal_dev_ctx *)data;
+
+	hal_rpu_events_dispatch(hal_dev_ctx);
+
+	if (hal_dev_ctx->irq_polling &&
+	    hal_rpu_irq_poll(hal_dev_ctx)) {
+		nrf_wifi_osal_tasklet_schedule(hal_dev_ctx->hpriv->opriv,
+					       hal_dev_ctx->event_tasklet);
+	}
 }
 
 
@@ -1550,6 +1842,11 @@ enum nrf_wifi_status hal_rpu_eventq_process(struct nrf_wifi_hal_dev_ctx *hal_dev
 	void *event_data = NULL;
 	unsigned int event_len = 0;
 
+	/* TX done events usually refill the descriptor they free, signal all
+	 * the resulting TX commands to the RPU in one go.
+	 */
+	nrf_wifi_hal_data_cmd_batch_start(hal_dev_ctx);
+
 	while (1) {
 		nrf_wifi_osal_spinlock_irq_take(hal_dev_ctx->hpriv->opriv,
 						hal_dev_ctx->lock_rx,
@@ -1581,12 +1878,24 @@ enum nrf_wifi_status hal_rpu_eventq_process(struct nrf_wifi_hal_dev_ctx *hal_dev
 		}
 
 		/* Free up the local buffer */
-		nrf_wifi_osal_mem_free(hal_dev_ctx->hpriv->opriv,
+		nrf_wifi_osal_spinlock_irq_take(hal_dev_ctx->hpriv->opriv,
+						hal_dev_ctx->lock_rx,
+						&flags);
+
+		hal_rpu_event_msg_free(hal_dev_ctx,
 				       event);
+
+		nrf_wifi_osal_spinlock_irq_rel(hal_dev_ctx->hpriv->opriv,
+					       hal_dev_ctx->lock_rx,
+					       &flags);
 		event = NULL;
 	}
 
 out:
+	if (nrf_wifi_hal_data_cmd_batch_end(hal_dev_ctx) != NRF_WIFI_STATUS_SUCCESS) {
+		status = NRF_WIFI_STATUS_FAIL;
+	}
+
 	return status;
 }
 
@@ -1630,6 +1939,20 @@ struct nrf_wifi_hal_dev_ctx *nrf_wifi_hal_dev_add(struct nrf_wifi_hal_priv *hpri
 
 	hal_dev_ctx->num_cmds = RPU_CMD_START_MAGIC;
 
+#ifdef SOC_WEZEN
+	status = pal_rpu_addr_offset_get(hpriv->opriv,
+					 ROM_ACCESS_REG_ADDR,
+					 &hal_dev_ctx->rom_access_reg_offset,
+					 hal_dev_ctx->curr_proc);
+
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_osal_log_err(hpriv->opriv,
+				      "%s: pal_rpu_addr_offset_get failed\n",
+				      __func__);
+		goto hal_dev_free;
+	}
+#endif /* SOC_WEZEN */
+
 	hal_dev_ctx->cmd_q = nrf_wifi_utils_q_alloc(hpriv->opriv);
 
 	if (!hal_dev_ctx->cmd_q) {
@@ -1648,13 +1971,30 @@ struct nrf_wifi_hal_dev_ctx *nrf_wifi_hal_dev_add(struct nrf_wifi_hal_priv *hpri
 		goto cmd_q_free;
 	}
 
+	/* Each slot holds a HAL message with an unfragmented event */
+	hal_dev_ctx->event_ring_slot_sz = sizeof(struct nrf_wifi_hal_msg) +
+		((hpriv->cfg_params.max_event_size > RPU_EVENT_COMMON_SIZE_MAX) ?
+		 hpriv->cfg_params.max_event_size : RPU_EVENT_COMMON_SIZE_MAX);
+	hal_dev_ctx->event_ring_slot_sz = (hal_dev_ctx->event_ring_slot_sz + 3) & ~3;
+
+	hal_dev_ctx->event_ring = nrf_wifi_osal_mem_zalloc(hpriv->opriv,
+							   HAL_EVENT_RING_SLOTS *
+							   hal_dev_ctx->event_ring_slot_sz);
+
+	if (!hal_dev_ctx->event_ring) {
+		nrf_wifi_osal_log_err(hpriv->opriv,
+				      "%s: Unable to allocate event ring\n",
+				      __func__);
+		goto event_q_free;
+	}
+
 	hal_dev_ctx->lock_hal = nrf_wifi_osal_spinlock_alloc(hpriv->opriv);
 
 	if (!hal_dev_ctx->lock_hal) {
 		nrf_wifi_osal_log_err(hpriv->opriv,
 				      "%s: Unable to allocate HAL lock\n", __func__);
 		hal_dev_ctx = NULL;
-		goto event_q_free;
+		goto event_ring_free;
 	}
 
 	nrf_wifi_osal_spinlock_init(hpriv->opriv,
@@ -1687,6 +2027,22 @@ struct nrf_wifi_hal_dev_ctx *nrf_wifi_hal_dev_add(struct nrf_wifi_hal_priv *hpri
 				   event_tasklet_fn,
 				   (unsigned long)hal_dev_ctx);
 
+#ifdef HAL_CMD_ASYNC
+	hal_dev_ctx->cmd_retry_timer = nrf_wifi_osal_timer_alloc(hpriv->opriv);
+
+	if (!hal_dev_ctx->cmd_retry_timer) {
+		nrf_wifi_osal_log_err(hpriv->opriv,
+				      "%s: Unable to allocate command retry timer\n",
+				      __func__);
+		goto tasklet_free;
+	}
+
+	nrf_wifi_osal_timer_init(hpriv->opriv,
+				 hal_dev_ctx->cmd_retry_timer,
+				 hal_rpu_cmd_retry,
+				 (unsigned long)hal_dev_ctx);
+#endif /* HAL_CMD_ASYNC */
+
 #ifdef CONFIG_NRF_WIFI_LOW_POWER
 	status = hal_rpu_ps_init(hal_dev_ctx);
 
@@ -1694,7 +2050,11 @@ struct nrf_wifi_hal_dev_ctx *nrf_wifi_hal_dev_add(struct nrf_wifi_hal_priv *hpri
 		nrf_wifi_osal_log_err(hpriv->opriv,
 				      "%s: hal_rpu_ps_init failed\n",
 				      __func__);
+#ifdef HAL_CMD_ASYNC
+		goto cmd_retry_timer_free;
+#else
 		goto tasklet_free;
+#endif /* HAL_CMD_ASYNC */
 	}
 #endif /* CONFIG_NRF_WIFI_LOW_POWER */
 
@@ -1705,7 +2065,11 @@ struct nrf_wifi_hal_dev_ctx *nrf_wifi_hal_dev_add(struct nrf_wifi_hal_priv *hpri
 		nrf_wifi_osal_log_err(hpriv->opriv,
 				      "%s: nrf_wifi_bal_dev_add failed\n",
 				      __func__);
+#ifdef HAL_CMD_ASYNC
+		goto cmd_retry_timer_free;
+#else
 		goto tasklet_free;
+#endif /* HAL_CMD_ASYNC */
 	}
 
 #ifdef SOC_WEZEN
@@ -1822,6 +2186,11 @@ rx_buf_free:
 #endif /* !CONFIG_NRF700X_RADIO_TEST */
 bal_dev_free:
 	nrf_wifi_bal_dev_rem(hal_dev_ctx->bal_dev_ctx);
+#ifdef HAL_CMD_ASYNC
+cmd_retry_timer_free:
+	nrf_wifi_osal_timer_free(hpriv->opriv,
+				 hal_dev_ctx->cmd_retry_timer);
+#endif /* HAL_CMD_ASYNC */
 tasklet_free:
 	nrf_wifi_osal_tasklet_free(hpriv->opriv,
 					hal_dev_ctx->event_tasklet);
@@ -1831,6 +2200,9 @@ lock_rx_free:
 lock_hal_free:
 	nrf_wifi_osal_spinlock_free(hpriv->opriv,
 					hal_dev_ctx->lock_hal);
+event_ring_free:
+	nrf_wifi_osal_mem_free(hpriv->opriv,
+			       hal_dev_ctx->event_ring);
 event_q_free:
 	nrf_wifi_utils_q_free(hpriv->opriv,
 					hal_dev_ctx->event_q);
@@ -1849,6 +2221,9 @@ err:
 void nrf_wifi_hal_dev_rem(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
 {
 	unsigned int i = 0;
+#ifdef HAL_CMD_ASYNC
+	struct nrf_wifi_hal_msg *cmd = NULL;
+#endif /* HAL_CMD_ASYNC */
 #ifdef RPU_HARD_RESET_SUPPORT
         enum RPU_PROC_TYPE proc = RPU_PROC_TYPE_MAX;
 #endif /* RPU_HARD_RESET_SUPPORT */
@@ -1870,6 +2245,15 @@ void nrf_wifi_hal_dev_rem(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
 	nrf_wifi_osal_tasklet_free(hal_dev_ctx->hpriv->opriv,
 				   hal_dev_ctx->event_tasklet);
 
+#ifdef HAL_CMD_ASYNC
+	/* The tasklet is gone, nothing but the timer itself re-arms it */
+	nrf_wifi_osal_timer_kill(hal_dev_ctx->hpriv->opriv,
+				 hal_dev_ctx->cmd_retry_timer);
+
+	nrf_wifi_osal_timer_free(hal_dev_ctx->hpriv->opriv,
+				 hal_dev_ctx->cmd_retry_timer);
+#endif /* HAL_CMD_ASYNC */
+
 	nrf_wifi_osal_spinlock_free(hal_dev_ctx->hpriv->opriv,
 				    hal_dev_ctx->lock_hal);
 	nrf_wifi_osal_spinlock_free(hal_dev_ctx->hpriv->opriv,
@@ -1878,6 +2262,18 @@ void nrf_wifi_hal_dev_rem(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
 	nrf_wifi_utils_q_free(hal_dev_ctx->hpriv->opriv,
 			      hal_dev_ctx->event_q);
 
+	nrf_wifi_osal_mem_free(hal_dev_ctx->hpriv->opriv,
+			       hal_dev_ctx->event_ring);
+	hal_dev_ctx->event_ring = NULL;
+
+#ifdef HAL_CMD_ASYNC
+	while ((cmd = nrf_wifi_utils_q_dequeue(hal_dev_ctx->hpriv->opriv,
+					       hal_dev_ctx->cmd_q))) {
+		nrf_wifi_osal_mem_free(hal_dev_ctx->hpriv->opriv,
+				       cmd);
+	}
+#endif /* HAL_CMD_ASYNC */
+
 	nrf_wifi_utils_q_free(hal_dev_ctx->hpriv->opriv,
 			      hal_dev_ctx->cmd_q);
 
@@ -1922,6 +2318,11 @@ enum nrf_wifi_status nrf_wifi_hal_dev_init(struct nrf_wifi_hal_dev_ctx *hal_dev_
 #ifdef SOFT_HPQM
 	hal_dev_ctx->rpu_info.soft_hpq = (struct soft_hpqm_info *)HOST_RPU_GDRAM_START_ADDR;
 
+	/* Pick up the host owned indices once, from here on the host
+	 * copies are the reference.
+	 */
+	status = hal_rpu_soft_hpq_idx_sync(hal_dev_ctx);
+
 #else
 	/* Read the HPQM info for all the queues provided by the RPU
 	 * (like command, event, RX buf queues etc)
@@ -1968,15 +2369,26 @@ enum nrf_wifi_status nrf_wifi_hal_irq_handler(void *data)
 	struct nrf_wifi_hal_dev_ctx *hal_dev_ctx = NULL;
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 	unsigned long flags = 0;
+	bool threaded = false;
 #ifdef CONFIG_NRF_WIFI_LOW_POWER
 	enum RPU_PS_STATE ps_state = RPU_PS_STATE_ASLEEP;
 #endif /* CONFIG_NRF_WIFI_LOW_POWER */
 
 	hal_dev_ctx = (struct nrf_wifi_hal_dev_ctx *)data;
 
-	nrf_wifi_osal_spinlock_irq_take(hal_dev_ctx->hpriv->opriv,
-					hal_dev_ctx->lock_rx,
-					&flags);
+	/* In a threaded handler nothing takes the RX lock from the hard
+	 * interrupt context, so keep interrupts enabled during the event reads.
+	 */
+	threaded = hal_dev_ctx->irq_threaded;
+
+	if (threaded) {
+		nrf_wifi_osal_spinlock_take(hal_dev_ctx->hpriv->opriv,
+					    hal_dev_ctx->lock_rx);
+	} else {
+		nrf_wifi_osal_spinlock_irq_take(hal_dev_ctx->hpriv->opriv,
+						hal_dev_ctx->lock_rx,
+						&flags);
+	}
 
 #ifdef CONFIG_NRF_WIFI_LOW_POWER
 	ps_state = hal_dev_ctx->rpu_ps_state;
@@ -1997,22 +2409,83 @@ enum nrf_wifi_status nrf_wifi_hal_irq_handler(void *data)
 #endif /* CONFIG_NRF_WIFI_LOW_POWER_DBG */
 #endif /* CONFIG_NRF_WIFI_LOW_POWER */
 
-	nrf_wifi_osal_spinlock_irq_rel(hal_dev_ctx->hpriv->opriv,
-				       hal_dev_ctx->lock_rx,
-				       &flags);
+	if (threaded) {
+		nrf_wifi_osal_spinlock_rel(hal_dev_ctx->hpriv->opriv,
+					   hal_dev_ctx->lock_rx);
+	} else {
+		nrf_wifi_osal_spinlock_irq_rel(hal_dev_ctx->hpriv->opriv,
+					       hal_dev_ctx->lock_rx,
+					       &flags);
+	}
 
 	if (status != NRF_WIFI_STATUS_SUCCESS) {
 		goto out;
 	}
 
-	nrf_wifi_osal_tasklet_schedule(hal_dev_ctx->hpriv->opriv,
-				       hal_dev_ctx->event_tasklet);
+	if (threaded) {
+		/* Poll from the thread as well, a tasklet running on another CPU
+		 * would process events alongside the next run of the thread.
+		 * The poll budget bounds the loop.
+		 */
+		do {
+			hal_rpu_events_dispatch(hal_dev_ctx);
+		} while (hal_dev_ctx->irq_polling &&
+			 hal_rpu_irq_poll(hal_dev_ctx));
+	} else {
+		nrf_wifi_osal_tasklet_schedule(hal_dev_ctx->hpriv->opriv,
+					       hal_dev_ctx->event_tasklet);
+	}
 
 out:
 	return status;
 }
 
 
+enum nrf_wifi_status nrf_wifi_hal_irq_mod_set(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
+					      unsigned int poll_thresh,
+					      unsigned int poll_budget,
+					      unsigned int poll_usecs)
+{
+	unsigned long flags = 0;
+
+	nrf_wifi_osal_spinlock_irq_take(hal_dev_ctx->hpriv->opriv,
+					hal_dev_ctx->lock_rx,
+					&flags);
+
+	/* If polling is in progress, it ends on the next poll when it gets
+	 * disabled here.
+	 */
+	hal_dev_ctx->irq_poll_thresh = poll_thresh;
+	hal_dev_ctx->irq_poll_budget = poll_budget;
+	hal_dev_ctx->irq_poll_usecs = poll_usecs;
+
+	nrf_wifi_osal_spinlock_irq_rel(hal_dev_ctx->hpriv->opriv,
+				       hal_dev_ctx->lock_rx,
+				       &flags);
+
+	return NRF_WIFI_STATUS_SUCCESS;
+}
+
+
+enum nrf_wifi_status nrf_wifi_hal_irq_threaded_set(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
+						   bool threaded)
+{
+	unsigned long flags = 0;
+
+	nrf_wifi_osal_spinlock_irq_take(hal_dev_ctx->hpriv->opriv,
+					hal_dev_ctx->lock_rx,
+					&flags);
+
+	hal_dev_ctx->irq_threaded = threaded;
+
+	nrf_wifi_osal_spinlock_irq_rel(hal_dev_ctx->hpriv->opriv,
+				       hal_dev_ctx->lock_rx,
+				       &flags);
+
+	return NRF_WIFI_STATUS_SUCCESS;
+}
+
+
 static int nrf_wifi_hal_poll_reg(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
 				 unsigned int reg_addr,
 				 unsigned int mask,
@@ -2128,6 +2601,10 @@ enum nrf_wifi_status nrf_wifi_hal_proc_reset(struct nrf_wifi_hal_dev_ctx *hal_de
 		goto out;
 	}
 
+#ifdef SOC_WEZEN
+	hal_dev_ctx->rom_access_reg_valid = false;
+#endif /* SOC_WEZEN */
+
 	/* Perform pulsed soft reset of MIPS */
 	if (rpu_proc == RPU_PROC_TYPE_MCU_LMAC) {
 		status = hal_rpu_reg_write(hal_dev_ctx,
@@ -199,22 +199,11 @@ static enum nrf_wifi_status hal_rpu_event_free(struct nrf_wifi_hal_dev_ctx *hal_
 #ifdef SOFT_HPQM
 	unsigned int current_index = 0;
 
-	status = hal_rpu_mem_read(hal_dev_ctx,
-                                  &current_index,
-                                  &hal_dev_ctx->rpu_info.soft_hpq->host_event_busy_index,
-				  sizeof(unsigned int));
-
-        if (status != NRF_WIFI_STATUS_SUCCESS) {
-                nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
-                                      "%s: Read from the host_event_busy_index = %x address failed, val (0x%X)\n",
-                                       __func__,
-                                       &hal_dev_ctx->rpu_info.soft_hpq->host_event_busy_index,
-                                       current_index);
-                goto out;
-        }
+	current_index = hal_dev_ctx->rpu_info.host_event_busy_index;
+
 	status = hal_rpu_mem_write(hal_dev_ctx,
                                    &hal_dev_ctx->rpu_info.soft_hpq->event_free_buffs[current_index],
-				   event_addr,
+				   &event_addr,
 				   sizeof(unsigned int));
 
 	if (status != NRF_WIFI_STATUS_SUCCESS) {
@@ -234,7 +223,7 @@ static enum nrf_wifi_status hal_rpu_event_free(struct nrf_wifi_hal_dev_ctx *hal_
 
 	status = hal_rpu_mem_write(hal_dev_ctx,
                                    &hal_dev_ctx->rpu_info.soft_hpq->host_event_busy_index,
-				   current_index,
+				   &current_index,
 				   sizeof(unsigned int));
 
 	if (status != NRF_WIFI_STATUS_SUCCESS) {
@@ -246,6 +235,7 @@ static enum nrf_wifi_status hal_rpu_event_free(struct nrf_wifi_hal_dev_ctx *hal_
 		goto out;
 	}
 
+	hal_dev_ctx->rpu_info.host_event_busy_index = current_index;
 #else
 	status = hal_rpu_hpq_enqueue(hal_dev_ctx,
 				     &hal_dev_ctx->rpu_info.hpqm_info.event_avl_queue,
@@ -263,143 +253,149 @@ out:
 }
 
 
+/* Get a free slot from the event ring to read an event into, NULL if all the
+ * slots are still waiting to be processed.
+ */
+static struct nrf_wifi_hal_msg *hal_rpu_event_slot_get(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
+{
+	struct nrf_wifi_hal_msg *event = NULL;
+	unsigned int slot = 0;
+
+	slot = hal_dev_ctx->event_ring_head;
+
+	if (hal_dev_ctx->event_ring_busy[slot]) {
+		goto out;
+	}
+
+	event = (struct nrf_wifi_hal_msg *)(hal_dev_ctx->event_ring +
+					    (slot * hal_dev_ctx->event_ring_slot_sz));
+
+	hal_dev_ctx->event_ring_busy[slot] = true;
+	hal_dev_ctx->event_ring_head = (slot + 1) % HAL_EVENT_RING_SLOTS;
+out:
+	return event;
+}
+
+
+void hal_rpu_event_msg_free(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
+			    struct nrf_wifi_hal_msg *event)
+{
+	char *ring_start = hal_dev_ctx->event_ring;
+	char *ring_end = ring_start +
+		(HAL_EVENT_RING_SLOTS * hal_dev_ctx->event_ring_slot_sz);
+
+	if (((char *)event >= ring_start) && ((char *)event < ring_end)) {
+		hal_dev_ctx->event_ring_busy[((char *)event - ring_start) /
+					     hal_dev_ctx->event_ring_slot_sz] = false;
+	} else {
+		nrf_wifi_osal_mem_free(hal_dev_ctx->hpriv->opriv,
+				       event);
+	}
+}
+
+
 static enum nrf_wifi_status hal_rpu_event_get(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
 					      unsigned int event_addr)
 {
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 	struct nrf_wifi_hal_msg *event = NULL;
+	struct nrf_wifi_hal_msg *event_large = NULL;
 	struct host_rpu_msg_hdr *rpu_msg_hdr = NULL;
 	unsigned int rpu_msg_len = 0;
 	unsigned int event_data_size = 0;
+	unsigned char *event_data_typical = NULL;
 	/* QSPI : avoid global vars as they can be unaligned */
-	unsigned char event_data_typical[RPU_EVENT_COMMON_SIZE_MAX];
-
-	nrf_wifi_osal_mem_set(hal_dev_ctx->hpriv->opriv,
-			      event_data_typical,
-			      0,
-			      sizeof(event_data_typical));
+	unsigned char event_data_local[RPU_EVENT_COMMON_SIZE_MAX];
 
 	if (!hal_dev_ctx->event_data_pending) {
-		/* Copy data worth the maximum size of frequently occurring events from
-		 * the RPU to a local buffer
+		/* Copy data worth the maximum size of frequently occurring events
+		 * from the RPU straight into a slot of the event ring, so that the
+		 * typical event is read only once and never copied. Only if the
+		 * ring is full is it staged in a local buffer.
 		 */
+		event = hal_rpu_event_slot_get(hal_dev_ctx);
+
+		if (event) {
+			event_data_typical = (unsigned char *)event->data;
+		} else {
+			event_data_typical = event_data_local;
+		}
+
 		status = hal_rpu_mem_read(hal_dev_ctx,
 					  event_data_typical,
 					  event_addr,
-					  sizeof(event_data_typical));
+					  RPU_EVENT_COMMON_SIZE_MAX);
 
 		if (status != NRF_WIFI_STATUS_SUCCESS) {
 			nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
 					      "%s: Reading of the event failed\n",
 					      __func__);
-			goto out;
+			goto err;
 		}
 
 		rpu_msg_hdr = (struct host_rpu_msg_hdr *)event_data_typical;
 
 		rpu_msg_len = rpu_msg_hdr->len;
 
-		/* Allocate space to assemble the entire event */
-		hal_dev_ctx->event_data = nrf_wifi_osal_mem_zalloc(hal_dev_ctx->hpriv->opriv,
-								   rpu_msg_len);
+		/* Fragmented events (or any event when the ring is full) need
+		 * space to assemble the entire event in.
+		 */
+		if (!event || (rpu_msg_len > hal_dev_ctx->hpriv->cfg_params.max_event_size)) {
+			event_large = nrf_wifi_osal_mem_zalloc(hal_dev_ctx->hpriv->opriv,
+							       sizeof(*event_large) + rpu_msg_len);
 
-		if (!hal_dev_ctx->event_data) {
-			nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
-					      "%s: Unable to alloc buff for event data\n",
-					      __func__);
-			goto out;
-		} else {
-			hal_dev_ctx->event_data_curr = hal_dev_ctx->event_data;
+			if (!event_large) {
+				nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
+						      "%s: Unable to alloc buff for event data\n",
+						      __func__);
+				status = NRF_WIFI_STATUS_FAIL;
+				goto err;
+			}
+
+			nrf_wifi_osal_mem_cpy(hal_dev_ctx->hpriv->opriv,
+					      event_large->data,
+					      event_data_typical,
+					      (rpu_msg_len < RPU_EVENT_COMMON_SIZE_MAX) ?
+					      rpu_msg_len : RPU_EVENT_COMMON_SIZE_MAX);
+
+			if (event) {
+				hal_rpu_event_msg_free(hal_dev_ctx,
+						       event);
+			}
+
+			event = event_large;
 		}
 
+		hal_dev_ctx->event = event;
+		hal_dev_ctx->event_data_curr = event->data;
 		hal_dev_ctx->event_data_len = rpu_msg_len;
 		hal_dev_ctx->event_data_pending = rpu_msg_len;
 		hal_dev_ctx->event_resubmit = rpu_msg_hdr->resubmit;
 
-		/* Fragmented event */
-		if (rpu_msg_len > hal_dev_ctx->hpriv->cfg_params.max_event_size) {
-			status = hal_rpu_mem_read(hal_dev_ctx,
-						  hal_dev_ctx->event_data_curr,
-						  event_addr,
-						  hal_dev_ctx->hpriv->cfg_params.max_event_size);
+		/* Size of the whole event or of the first fragment of a
+		 * fragmented event.
+		 */
+		event_data_size = (rpu_msg_len >
+				   hal_dev_ctx->hpriv->cfg_params.max_event_size) ?
+				  hal_dev_ctx->hpriv->cfg_params.max_event_size :
+				  rpu_msg_len;
 
+		/* Corner case events of large size or fragmented events, read
+		 * the rest of the (first fragment of the) event.
+		 */
+		if (event_data_size > RPU_EVENT_COMMON_SIZE_MAX) {
+			status = hal_rpu_mem_read(hal_dev_ctx,
+						  hal_dev_ctx->event_data_curr +
+						  RPU_EVENT_COMMON_SIZE_MAX,
+						  event_addr + RPU_EVENT_COMMON_SIZE_MAX,
+						  event_data_size - RPU_EVENT_COMMON_SIZE_MAX);
 
 			if (status != NRF_WIFI_STATUS_SUCCESS) {
 				nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
-						      "%s: Reading of first fragment of event failed\n",
+						      "%s: Reading of large event failed\n",
 						      __func__);
-				nrf_wifi_osal_mem_free(hal_dev_ctx->hpriv->opriv,
-						       hal_dev_ctx->event_data);
-				hal_dev_ctx->event_data = NULL;
-				goto out;
+				goto err;
 			}
-
-			/* Free up the event in the RPU if necessary */
-			if (hal_dev_ctx->event_resubmit) {
-				status = hal_rpu_event_free(hal_dev_ctx,
-							    event_addr);
-
-				if (status != NRF_WIFI_STATUS_SUCCESS) {
-					nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
-							      "%s: Freeing up of the event failed\n",
-							      __func__);
-					nrf_wifi_osal_mem_free(hal_dev_ctx->hpriv->opriv,
-							       hal_dev_ctx->event_data);
-					hal_dev_ctx->event_data = NULL;
-					goto out;
-				}
-			}
-
-			hal_dev_ctx->event_data_pending -=
-			       hal_dev_ctx->hpriv->cfg_params.max_event_size;
-			hal_dev_ctx->event_data_curr +=
-			       hal_dev_ctx->hpriv->cfg_params.max_event_size;
-		} else {
-			/* If this is not part of a fragmented event check if we need to
-			 * copy any additional data i.e. if the event is a corner case
-			 * event of large size.
-			 */
-			if (rpu_msg_len > RPU_EVENT_COMMON_SIZE_MAX) {
-				status = hal_rpu_mem_read(hal_dev_ctx,
-							  hal_dev_ctx->event_data_curr,
-							  event_addr,
-							  rpu_msg_len);
-
-				if (status != NRF_WIFI_STATUS_SUCCESS) {
-					nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
-							      "%s: Reading of large event failed\n",
-							      __func__);
-					nrf_wifi_osal_mem_free(hal_dev_ctx->hpriv->opriv,
-							       hal_dev_ctx->event_data);
-					hal_dev_ctx->event_data = NULL;
-					goto out;
-				}
-			} else {
-				nrf_wifi_osal_mem_cpy(hal_dev_ctx->hpriv->opriv,
-						      hal_dev_ctx->event_data_curr,
-						      event_data_typical,
-						      rpu_msg_len);
-			}
-
-			/* Free up the event in the RPU if necessary */
-			if (hal_dev_ctx->event_resubmit) {
-				status = hal_rpu_event_free(hal_dev_ctx,
-							    event_addr);
-
-				if (status != NRF_WIFI_STATUS_SUCCESS) {
-					nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
-							      "%s: Freeing up of the event failed\n",
-							      __func__);
-					nrf_wifi_osal_mem_free(hal_dev_ctx->hpriv->opriv,
-							       hal_dev_ctx->event_data);
-					hal_dev_ctx->event_data = NULL;
-					goto out;
-				}
-			}
-
-			hal_dev_ctx->event_data_pending -= rpu_msg_len;
-			hal_dev_ctx->event_data_curr += rpu_msg_len;
-
 		}
 	} else {
 		event_data_size = (hal_dev_ctx->event_data_pending >
@@ -407,7 +403,9 @@ static enum nrf_wifi_status hal_rpu_event_get(struct nrf_wifi_hal_dev_ctx *hal_d
 				  hal_dev_ctx->hpriv->cfg_params.max_event_size :
 				  hal_dev_ctx->event_data_pending;
 
-		if (hal_dev_ctx->event_data) {
+		event = hal_dev_ctx->event;
+
+		if (event) {
 			status = hal_rpu_mem_read(hal_dev_ctx,
 						  hal_dev_ctx->event_data_curr,
 						  event_addr,
@@ -417,55 +415,31 @@ static enum nrf_wifi_status hal_rpu_event_get(struct nrf_wifi_hal_dev_ctx *hal_d
 				nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
 						      "%s: Reading of large event failed\n",
 						      __func__);
-				nrf_wifi_osal_mem_free(hal_dev_ctx->hpriv->opriv,
-						       hal_dev_ctx->event_data);
-				hal_dev_ctx->event_data = NULL;
-				goto out;
+				goto err;
 			}
 		}
-
-		/* Free up the event in the RPU if necessary */
-		if (hal_dev_ctx->event_resubmit) {
-			status = hal_rpu_event_free(hal_dev_ctx,
-						    event_addr);
-
-			if (status != NRF_WIFI_STATUS_SUCCESS) {
-				nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
-						      "%s: Freeing up of the event failed\n",
-						      __func__);
-				nrf_wifi_osal_mem_free(hal_dev_ctx->hpriv->opriv,
-						       hal_dev_ctx->event_data);
-				hal_dev_ctx->event_data = NULL;
-				goto out;
-			}
-		}
-
-		hal_dev_ctx->event_data_pending -= event_data_size;
-		hal_dev_ctx->event_data_curr += event_data_size;
 	}
 
-	/* This is either a unfragmented event or the last fragment of a
-	 * fragmented event
-	 */
-	if (!hal_dev_ctx->event_data_pending) {
-		event = nrf_wifi_osal_mem_zalloc(hal_dev_ctx->hpriv->opriv,
-						 sizeof(*event) + hal_dev_ctx->event_data_len);
+	/* Free up the event in the RPU if necessary */
+	if (hal_dev_ctx->event_resubmit) {
+		status = hal_rpu_event_free(hal_dev_ctx,
+					    event_addr);
 
-		if (!event) {
+		if (status != NRF_WIFI_STATUS_SUCCESS) {
 			nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
-					      "%s: Unable to alloc HAL msg for event\n",
+					      "%s: Freeing up of the event failed\n",
 					      __func__);
-			nrf_wifi_osal_mem_free(hal_dev_ctx->hpriv->opriv,
-					       hal_dev_ctx->event_data);
-			hal_dev_ctx->event_data = NULL;
-			goto out;
+			goto err;
 		}
+	}
 
-		nrf_wifi_osal_mem_cpy(hal_dev_ctx->hpriv->opriv,
-				      event->data,
-				      hal_dev_ctx->event_data,
-				      hal_dev_ctx->event_data_len);
+	hal_dev_ctx->event_data_pending -= event_data_size;
+	hal_dev_ctx->event_data_curr += event_data_size;
 
+	/* This is either a unfragmented event or the last fragment of a
+	 * fragmented event
+	 */
+	if (!hal_dev_ctx->event_data_pending && event) {
 		event->len = hal_dev_ctx->event_data_len;
 
 		status = nrf_wifi_utils_q_enqueue(hal_dev_ctx->hpriv->opriv,
@@ -476,28 +450,143 @@ static enum nrf_wifi_status hal_rpu_event_get(struct nrf_wifi_hal_dev_ctx *hal_d
 			nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
 					      "%s: Unable to queue event\n",
 					      __func__);
-			nrf_wifi_osal_mem_free(hal_dev_ctx->hpriv->opriv,
-					       event);
-			event = NULL;
-			nrf_wifi_osal_mem_free(hal_dev_ctx->hpriv->opriv,
-					       hal_dev_ctx->event_data);
-			hal_dev_ctx->event_data = NULL;
-			goto out;
+			goto err;
 		}
 
 		/* Reset the state variables */
-		nrf_wifi_osal_mem_free(hal_dev_ctx->hpriv->opriv,
-				       hal_dev_ctx->event_data);
-		hal_dev_ctx->event_data = NULL;
+		hal_dev_ctx->event = NULL;
 		hal_dev_ctx->event_data_curr = NULL;
 		hal_dev_ctx->event_data_len = 0;
 		hal_dev_ctx->event_resubmit = 0;
 	}
+
+	goto out;
+err:
+	if (event) {
+		hal_rpu_event_msg_free(hal_dev_ctx,
+				       event);
+	}
+
+	hal_dev_ctx->event = NULL;
 out:
 	return status;
 }
 
 
+#ifdef SOFT_HPQM
+/* Get all the TX done events posted by the RPU. The TX done ring is read in
+ * one go and walked from the last slot consumed by the host, instead of
+ * reading it a slot at a time.
+ */
+static unsigned int hal_rpu_tx_done_get_all(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
+{
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	unsigned int tx_done_buffs[HOST_RPU_TX_DESC];
+	unsigned int start_index = 0;
+	unsigned int current_index = 0;
+	unsigned int num_events = 0;
+	unsigned int num_slots = 0;
+	unsigned int event_addr = 0;
+
+	status = hal_rpu_mem_read(hal_dev_ctx,
+				  tx_done_buffs,
+				  &hal_dev_ctx->rpu_info.soft_hpq->tx_done_buffs[0],
+				  sizeof(tx_done_buffs));
+
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
+				      "%s: Read from tx_done_buffs failed\n",
+				      __func__);
+		goto out;
+	}
+
+	start_index = hal_dev_ctx->rpu_info.host_tx_done_busy_index;
+	current_index = start_index;
+
+	while (num_events < HOST_RPU_TX_DESC) {
+		event_addr = tx_done_buffs[current_index];
+
+		if (!event_addr || event_addr == 0xAAAAAAAA) {
+			break;
+		}
+
+		status = hal_rpu_event_get(hal_dev_ctx,
+					   event_addr);
+
+		if (status != NRF_WIFI_STATUS_SUCCESS) {
+			nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
+					      "%s: Failed to queue TX done event\n",
+					      __func__);
+			break;
+		}
+
+		num_events++;
+
+		current_index++;
+
+		if (current_index == HOST_RPU_TX_DESC)
+			current_index = 0;
+	}
+
+	if (!num_events) {
+		goto out;
+	}
+
+	/* The events are queued, move past them even if the RPU can't be
+	 * told below, else the next pass would queue them a second time.
+	 */
+	hal_dev_ctx->rpu_info.host_tx_done_busy_index = current_index;
+
+	/* Set the content of the consumed slots to 0, this takes two writes
+	 * when the consumed slots wrap around the end of the ring.
+	 */
+	nrf_wifi_osal_mem_set(hal_dev_ctx->hpriv->opriv,
+			      tx_done_buffs,
+			      0,
+			      sizeof(tx_done_buffs));
+
+	num_slots = HOST_RPU_TX_DESC - start_index;
+
+	if (num_slots > num_events)
+		num_slots = num_events;
+
+	status = hal_rpu_mem_write(hal_dev_ctx,
+				   &hal_dev_ctx->rpu_info.soft_hpq->tx_done_buffs[start_index],
+				   tx_done_buffs,
+				   num_slots * sizeof(unsigned int));
+
+	if ((status == NRF_WIFI_STATUS_SUCCESS) && (num_events > num_slots)) {
+		status = hal_rpu_mem_write(hal_dev_ctx,
+					   &hal_dev_ctx->rpu_info.soft_hpq->tx_done_buffs[0],
+					   tx_done_buffs,
+					   (num_events - num_slots) * sizeof(unsigned int));
+	}
+
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
+				      "%s: Clearing of tx_done_buffs failed\n",
+				      __func__);
+		goto out;
+	}
+
+	status = hal_rpu_mem_write(hal_dev_ctx,
+				   &hal_dev_ctx->rpu_info.soft_hpq->host_tx_done_busy_index,
+				   &current_index,
+				   sizeof(unsigned int));
+
+	if (status != NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
+				      "%s: Writing %d to host_tx_done_busy_index failed\n",
+				      __func__,
+				      current_index);
+		goto out;
+	}
+out:
+	return num_events;
+}
+#endif /* SOFT_HPQM */
+
+
 static unsigned int hal_rpu_event_get_all(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
 {
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
@@ -507,22 +596,11 @@ static unsigned int hal_rpu_event_get_all(struct nrf_wifi_hal_dev_ctx *hal_dev_c
 	while (1) {
 		event_addr = 0;
 #ifdef SOFT_HPQM
-		unsigned int desc_no = 0;
+		unsigned int num_tx_done = 0;
 		unsigned int current_index = 0;
+		unsigned int val = 0;
 
-		status = hal_rpu_mem_read(hal_dev_ctx,
-                                         &current_index,
-                                         &hal_dev_ctx->rpu_info.soft_hpq->host_event_busy_index,
-					 sizeof(unsigned int));
-
-		if (status != NRF_WIFI_STATUS_SUCCESS) {
-			nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
-					      "%s: Read from the host_event_busy_index = %x address failed, val (0x%X)\n",
-					      __func__,
-					      &hal_dev_ctx->rpu_info.soft_hpq->host_event_busy_index,
-					      current_index);
-			goto out;
-		}
+		current_index = hal_dev_ctx->rpu_info.host_event_busy_index;
 
 		status = hal_rpu_mem_read(hal_dev_ctx,
 					  &event_addr,
@@ -540,81 +618,22 @@ static unsigned int hal_rpu_event_get_all(struct nrf_wifi_hal_dev_ctx *hal_dev_c
 		}
 
 		if (!event_addr) {
-			for (desc_no = 0; desc_no < HOST_RPU_TX_DESC; desc_no++) {
-				/* There is no control events pending. Now check tx_done event */
-				status = hal_rpu_mem_read(hal_dev_ctx,
-							  &current_index,
-							  &hal_dev_ctx->rpu_info.soft_hpq->host_tx_done_busy_index,
-							  sizeof (unsigned int));
-
-				if (status != NRF_WIFI_STATUS_SUCCESS) {
-					nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
-							      "%s: Read from the host_tx_done_busy_index = %x address failed, val (0x%X)\n",
-							      __func__,
-							      &hal_dev_ctx->rpu_info.soft_hpq->host_tx_done_busy_index,
-							      current_index);
-					goto out;
-				}
-
-				status = hal_rpu_mem_read(hal_dev_ctx,
-							  &event_addr,
-							  &hal_dev_ctx->rpu_info.soft_hpq->tx_done_buffs[current_index],
-							  sizeof(unsigned int));
-
-				if (status != NRF_WIFI_STATUS_SUCCESS) {
-					nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
-							      "%s: Read from tx_done_buffs[%d] = %x address failed, val (0x%X)\n",
-							      __func__,
-							      current_index,
-							      &hal_dev_ctx->rpu_info.soft_hpq->tx_done_buffs[current_index],
-							      event_addr);
-					goto out;
-				}
-
-				if (!event_addr) {
-					continue;
-				} else {
-					/* Set the content to 0 */
-					status = hal_rpu_mem_write(hal_dev_ctx,
-								   &hal_dev_ctx->rpu_info.soft_hpq->tx_done_buffs[current_index],
-								   0x0,
-								   sizeof(unsigned int));
-
-					if (status != NRF_WIFI_STATUS_SUCCESS) {
-						nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
-								      "%s: Writing to tx_done_buffs[%d] = %x address failed \n",
-								      __func__,
-								      current_index,
-								      &hal_dev_ctx->rpu_info.soft_hpq->tx_done_buffs[current_index]);
-			                        goto out;
-					}
-
-					current_index++;
-
-					if (current_index == HOST_RPU_TX_DESC)
-						current_index = 0;
-
-					status = hal_rpu_mem_write(hal_dev_ctx,
-								   &hal_dev_ctx->rpu_info.soft_hpq->host_tx_done_busy_index,
-								   current_index,
-								   sizeof(unsigned int));
-
-					if (status != NRF_WIFI_STATUS_SUCCESS) {
-						nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
-								      "%s: Writing %d to host_tx_done_busy_index = %x address failed \n",
-								      __func__,
-								      current_index,
-								      &hal_dev_ctx->rpu_info.soft_hpq->host_tx_done_busy_index);
-			                        goto out;
-					}
-					break;
-				}
+			/* There are no control events pending, get all the
+			 * TX done events instead.
+			 */
+			num_tx_done = hal_rpu_tx_done_get_all(hal_dev_ctx);
+
+			if (!num_tx_done) {
+				break;
 			}
+
+			num_events += num_tx_done;
+			continue;
 		} else {
 			/* Set the content to 0 */
 			status = hal_rpu_mem_write(hal_dev_ctx,
 						   &hal_dev_ctx->rpu_info.soft_hpq->event_busy_buffs[current_index],
-						   0x0,
+						   &val,
 						   sizeof(unsigned int));
 
 			if (status != NRF_WIFI_STATUS_SUCCESS) {
@@ -698,6 +717,26 @@ enum nrf_wifi_status hal_rpu_irq_process(struct nrf_wifi_hal_dev_ctx *hal_dev_ct
 	 * scenarios and has to be taken care by the SOC designers.
 	 */
 	num_events = hal_rpu_event_get_all(hal_dev_ctx);
+
+	/* At high event rates stop taking an interrupt per event, mask the
+	 * interrupt and poll for events from where they are processed instead.
+	 */
+	if (hal_dev_ctx->irq_poll_thresh &&
+	    !hal_dev_ctx->irq_polling &&
+	    (num_events >= hal_dev_ctx->irq_poll_thresh)) {
+		status = hal_rpu_irq_disable(hal_dev_ctx);
+
+		if (status != NRF_WIFI_STATUS_SUCCESS) {
+			nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
+					      "%s: hal_rpu_irq_disable failed\n",
+					      __func__);
+			goto out;
+		}
+
+		hal_dev_ctx->irq_polling = true;
+		hal_dev_ctx->irq_poll_cnt = 0;
+		hal_dev_ctx->irq_poll_last_us = nrf_wifi_osal_time_get_curr_us(hal_dev_ctx->hpriv->opriv);
+	}
 #ifdef notyet
 	/* If we received an interrupt without any associated event(s) it is a
 	 * likely indication that the RPU is stuck and this interrupt has been
@@ -727,3 +766,63 @@ enum nrf_wifi_status hal_rpu_irq_process(struct nrf_wifi_hal_dev_ctx *hal_dev_ct
 out:
 	return status;
 }
+
+
+bool hal_rpu_irq_poll(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
+{
+	unsigned long flags = 0;
+	unsigned int num_events = 0;
+	bool poll_again = false;
+
+	nrf_wifi_osal_spinlock_irq_take(hal_dev_ctx->hpriv->opriv,
+					hal_dev_ctx->lock_rx,
+					&flags);
+
+	if (!hal_dev_ctx->irq_polling) {
+		goto out;
+	}
+
+	num_events = hal_rpu_event_get_all(hal_dev_ctx);
+
+	if (num_events) {
+		hal_dev_ctx->irq_poll_last_us = nrf_wifi_osal_time_get_curr_us(hal_dev_ctx->hpriv->opriv);
+	}
+
+	hal_dev_ctx->irq_poll_cnt++;
+
+	if (hal_dev_ctx->irq_poll_thresh &&
+	    (hal_dev_ctx->irq_poll_cnt < hal_dev_ctx->irq_poll_budget) &&
+	    (num_events ||
+	     (nrf_wifi_osal_time_elapsed_us(hal_dev_ctx->hpriv->opriv,
+					    hal_dev_ctx->irq_poll_last_us) <
+	      hal_dev_ctx->irq_poll_usecs))) {
+		poll_again = true;
+		goto out;
+	}
+
+	hal_dev_ctx->irq_polling = false;
+
+	/* Clear the interrupt raised while it was masked, any event behind it
+	 * is picked up by the final check below.
+	 */
+	if (hal_rpu_irq_ack(hal_dev_ctx) != NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
+				      "%s: hal_rpu_irq_ack failed\n",
+				      __func__);
+	}
+
+	if (hal_rpu_irq_enable(hal_dev_ctx) != NRF_WIFI_STATUS_SUCCESS) {
+		nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
+				      "%s: hal_rpu_irq_enable failed\n",
+				      __func__);
+	}
+
+	/* Events which came in before the interrupt was unmasked */
+	num_events += hal_rpu_event_get_all(hal_dev_ctx);
+out:
+	nrf_wifi_osal_spinlock_irq_rel(hal_dev_ctx->hpriv->opriv,
+				       hal_dev_ctx->lock_rx,
+				       &flags);
+
+	return (poll_again || num_events);
+}
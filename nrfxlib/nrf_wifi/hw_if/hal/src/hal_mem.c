@@ -144,6 +144,26 @@ static bool hal_rpu_is_mem_writable(enum RPU_PROC_TYPE proc,
 }
 
 
+#ifdef SOC_WEZEN
+static void hal_rpu_rom_access_set(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
+				   unsigned int val)
+{
+	/* Consecutive RAM accesses would otherwise all rewrite the same value */
+	if (hal_dev_ctx->rom_access_reg_valid &&
+	    (hal_dev_ctx->rom_access_reg_val == val)) {
+		return;
+	}
+
+	nrf_wifi_bal_write_word(hal_dev_ctx->bal_dev_ctx,
+				hal_dev_ctx->rom_access_reg_offset,
+				val);
+
+	hal_dev_ctx->rom_access_reg_val = val;
+	hal_dev_ctx->rom_access_reg_valid = true;
+}
+#endif /* SOC_WEZEN */
+
+
 static enum nrf_wifi_status rpu_mem_read_ram(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
 					     void *src_addr,
 					     unsigned int ram_addr_val,
@@ -154,9 +174,6 @@ static enum nrf_wifi_status rpu_mem_read_ram(struct nrf_wifi_hal_dev_ctx *hal_de
 #ifdef CONFIG_NRF_WIFI_LOW_POWER
 	unsigned long flags = 0;
 #endif /* CONFIG_NRF_WIFI_LOW_POWER */
-#ifdef SOC_WEZEN
-	unsigned long fpga_reg_addr_offset = 0;
-#endif
 	status = pal_rpu_addr_offset_get(hal_dev_ctx->hpriv->opriv,
 					 ram_addr_val,
 					 &addr_offset,
@@ -184,21 +201,8 @@ static enum nrf_wifi_status rpu_mem_read_ram(struct nrf_wifi_hal_dev_ctx *hal_de
 	/* First set the SOC_MMAP_ADDR_OFFSET_ROM_ACCESS_FPGA_REG to 0
 	 * for RAM access
 	 */
-	status = pal_rpu_addr_offset_get(hal_dev_ctx->hpriv->opriv,
-                                         ROM_ACCESS_REG_ADDR,
-                                         &fpga_reg_addr_offset,
-                                         hal_dev_ctx->curr_proc);
-
-	if (status != NRF_WIFI_STATUS_SUCCESS) {
-		nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
-				      "%s: pal_rpu_addr_offset_get failed\n",
-				      __func__);
-		return status;
-	}
-	
-	nrf_wifi_bal_write_word(hal_dev_ctx->bal_dev_ctx,
-                                fpga_reg_addr_offset,
-                                RPU_REG_BIT_ROM_ACCESS_DISABLE);
+	hal_rpu_rom_access_set(hal_dev_ctx,
+			       RPU_REG_BIT_ROM_ACCESS_DISABLE);
 	if (len == 4) {
 		*((unsigned int *)src_addr) = nrf_wifi_bal_read_word(hal_dev_ctx->bal_dev_ctx,
 								     addr_offset);
@@ -239,7 +243,6 @@ static enum nrf_wifi_status rpu_mem_write_rom(struct nrf_wifi_hal_dev_ctx *hal_d
 {
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 	unsigned long addr_offset = 0;
-	unsigned long fpga_reg_addr_offset = 0;
 
          status = pal_rpu_addr_offset_get(hal_dev_ctx->hpriv->opriv,
 					 rom_addr_val,
@@ -256,26 +259,13 @@ static enum nrf_wifi_status rpu_mem_write_rom(struct nrf_wifi_hal_dev_ctx *hal_d
 	/* First set the SOC_MMAP_ADDR_OFFSET_ROM_ACCESS_FPGA_REG to 1
          * for ROM access
          */
-        status = pal_rpu_addr_offset_get(hal_dev_ctx->hpriv->opriv,
-                                         ROM_ACCESS_REG_ADDR,
-                                         &fpga_reg_addr_offset,
-                                         hal_dev_ctx->curr_proc);
-
-        if (status != NRF_WIFI_STATUS_SUCCESS) {
-                nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
-                                      "%s: pal_rpu_addr_offset_get failed\n",
-                                      __func__);
-                return status;
-        }
-
-        nrf_wifi_bal_write_word(hal_dev_ctx->bal_dev_ctx,
-                                fpga_reg_addr_offset,
-                                RPU_REG_BIT_ROM_ACCESS_ENABLE);	
+	hal_rpu_rom_access_set(hal_dev_ctx,
+			       RPU_REG_BIT_ROM_ACCESS_ENABLE);
 
 	if (len == 4) {
 		nrf_wifi_bal_write_word(hal_dev_ctx->bal_dev_ctx,
         	                         addr_offset,
-                	                 src_addr);
+                	                 *((unsigned int *)src_addr));
 	} else { 
 		nrf_wifi_bal_write_block(hal_dev_ctx->bal_dev_ctx,
 					 addr_offset,
@@ -373,7 +363,7 @@ static enum nrf_wifi_status rpu_mem_write_code_ram(struct nrf_wifi_hal_dev_ctx *
 	if (len == 4) {
 		nrf_wifi_bal_write_word(hal_dev_ctx->bal_dev_ctx,
 					addr_offset,
-					src_addr);
+					*((unsigned int *)src_addr));
 	} else {
 		nrf_wifi_bal_write_block(hal_dev_ctx->bal_dev_ctx,
 					 addr_offset,
@@ -410,7 +400,7 @@ static enum nrf_wifi_status rpu_mem_write_data_ram(struct nrf_wifi_hal_dev_ctx *
 	if (len == 4) {
 		nrf_wifi_bal_write_word(hal_dev_ctx->bal_dev_ctx,
 					addr_offset,
-					src_addr);
+					*((unsigned int *)src_addr));
 	} else {
 		 nrf_wifi_bal_write_block(hal_dev_ctx->bal_dev_ctx,
         		                  addr_offset,
@@ -849,8 +839,6 @@ enum nrf_wifi_status hal_rpu_mem_clr(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
 	unsigned int mem_val = 0;
 #ifndef SOC_WEZEN
 	enum RPU_MCU_ADDR_REGIONS mcu_region = pal_mem_type_to_region(mem_type);
-#else
-	unsigned long fpga_reg_addr_offset = 0;
 #endif
 
 	if (!hal_dev_ctx) {
@@ -912,21 +900,8 @@ enum nrf_wifi_status hal_rpu_mem_clr(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
 	         /* First set the SOC_MMAP_ADDR_OFFSET_ROM_ACCESS_FPGA_REG to 1
         	  * for ROM access
 	          */
-		status = pal_rpu_addr_offset_get(hal_dev_ctx->hpriv->opriv,
-                	                         ROM_ACCESS_REG_ADDR,
-                        	                 &fpga_reg_addr_offset,
-                                	         hal_dev_ctx->curr_proc);
-
-		if (status != NRF_WIFI_STATUS_SUCCESS) {
-			nrf_wifi_osal_log_err(hal_dev_ctx->hpriv->opriv,
-					      "%s: pal_rpu_addr_offset_get failed\n",
-					      __func__);
-			goto out;
-		}
-
-		nrf_wifi_bal_write_word(hal_dev_ctx->bal_dev_ctx,
-					fpga_reg_addr_offset,
-                		        RPU_REG_BIT_ROM_ACCESS_ENABLE);
+		hal_rpu_rom_access_set(hal_dev_ctx,
+				       RPU_REG_BIT_ROM_ACCESS_ENABLE);
 	}
 #endif
 	for (mem_addr = start_addr;
@@ -949,9 +924,8 @@ enum nrf_wifi_status hal_rpu_mem_clr(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
 	    mem_type == HAL_RPU_MEM_TYPE_ROM_1) {
 	         /* Set Back SOC_MMAP_ADDR_OFFSET_ROM_ACCESS_FPGA_REG to 0 */
 
-		nrf_wifi_bal_write_word(hal_dev_ctx->bal_dev_ctx,
-					fpga_reg_addr_offset,
-                		        RPU_REG_BIT_ROM_ACCESS_ENABLE);
+		hal_rpu_rom_access_set(hal_dev_ctx,
+				       RPU_REG_BIT_ROM_ACCESS_ENABLE);
 	}
 #endif
 	status = NRF_WIFI_STATUS_SUCCESS;
@@ -11,6 +11,7 @@
 
 #include "pal.h"
 #include "hal_api.h"
+#include "util.h"
 
 bool pal_check_rpu_mcu_regions(enum RPU_PROC_TYPE proc, unsigned int addr_val)
 {
@@ -32,87 +33,157 @@ bool pal_check_rpu_mcu_regions(enum RPU_PROC_TYPE proc, unsigned int addr_val)
 	return false;
 }
 
+/**
+ * struct pal_rpu_mmap_region - Host mapping of a region of RPU addresses.
+ * @start: First RPU address in the region.
+ * @end: Last RPU address in the region.
+ * @rpu_base: RPU address subtracted before masking.
+ * @mask: Mask applied to the offset of the RPU address from @rpu_base.
+ * @host_base: Host offset the masked RPU address is added to.
+ */
+struct pal_rpu_mmap_region {
+	unsigned int start;
+	unsigned int end;
+	unsigned int rpu_base;
+	unsigned int mask;
+	unsigned long host_base;
+};
+
+/* Host view of the RPU address regions, the host offset of an RPU address in
+ * a region is host_base + ((rpu_addr - rpu_base) & mask).
+ */
+static const struct pal_rpu_mmap_region pal_rpu_mmap_regions[] = {
+#ifdef SOC_WEZEN
+	{RPU_ADDR_WIFI_MCU_REGS_START,
+	 RPU_ADDR_WIFI_MCU_REGS_START | RPU_ADDR_MASK_OFFSET,
+	 0,
+	 RPU_ADDR_MASK_OFFSET,
+	 SOC_MMAP_ADDR_OFFSET_WIFI_MCU_REGS},
+	{RPU_ADDR_RAM0_START,
+	 RPU_ADDR_RAM0_END,
+	 RPU_ADDR_RAM0_START,
+	 RPU_ADDR_RAM_ROM_MASK_OFFSET,
+	 SOC_MMAP_ADDR_OFFSET_RAM0_PKD},
+	{RPU_ADDR_RAM1_START,
+	 RPU_ADDR_RAM1_END,
+	 RPU_ADDR_RAM1_START,
+	 RPU_ADDR_RAM_ROM_MASK_OFFSET,
+	 SOC_MMAP_ADDR_OFFSET_RAM1_PKD},
+	{RPU_ADDR_ROM0_START,
+	 RPU_ADDR_ROM0_END,
+	 RPU_ADDR_ROM0_START,
+	 RPU_ADDR_RAM_ROM_MASK_OFFSET,
+	 SOC_MMAP_ADDR_OFFSET_ROM0_PKD},
+	{RPU_ADDR_ROM1_START,
+	 RPU_ADDR_ROM1_END,
+	 RPU_ADDR_ROM1_START,
+	 RPU_ADDR_RAM_ROM_MASK_OFFSET,
+	 SOC_MMAP_ADDR_OFFSET_ROM1_PKD},
+	/* Also covers RPU_ADDR_DATA_RAM_START - RPU_ADDR_DATA_RAM_END */
+	{RPU_ADDR_ACTUAL_DATA_RAM_START,
+	 RPU_ADDR_ACTUAL_DATA_RAM_END,
+	 0,
+	 RPU_ADDR_MASK_OFFSET,
+	 SOC_MMAP_ADDR_OFFSET_DATA_RAM_PKD},
+	{RPU_ADDR_CODE_RAM_START,
+	 RPU_ADDR_CODE_RAM_END,
+	 RPU_ADDR_CODE_RAM_START,
+	 RPU_ADDR_MASK_OFFSET,
+	 SOC_MMAP_ADDR_OFFSET_CODE_RAM_PKD},
+	{RPU_ADDR_BELLBOARD_APP_REGION,
+	 RPU_ADDR_BELLBOARD_APP_REGION | RPU_BELLBOARD_GRTC_ADDR_MASK_OFFSET,
+	 0,
+	 RPU_BELLBOARD_GRTC_ADDR_MASK_OFFSET,
+	 SOC_MMAP_ADDR_OFFSET_BELLBOARD_APP},
+	{RPU_ADDR_BELLBOARD_WIFI_REGION,
+	 RPU_ADDR_BELLBOARD_WIFI_REGION | RPU_BELLBOARD_GRTC_ADDR_MASK_OFFSET,
+	 0,
+	 RPU_BELLBOARD_GRTC_ADDR_MASK_OFFSET,
+	 SOC_MMAP_ADDR_OFFSET_BELLBOARD_WIFI},
+	{RPU_ADDR_GRTC_REGION,
+	 RPU_ADDR_GRTC_REGION | RPU_BELLBOARD_GRTC_ADDR_MASK_OFFSET,
+	 0,
+	 RPU_BELLBOARD_GRTC_ADDR_MASK_OFFSET,
+	 SOC_MMAP_ADDR_OFFSET_GRTC},
+	{RPU_ADDR_FPGA_REGS_REGION,
+	 RPU_ADDR_FPGA_REGS_REGION | RPU_ADDR_MASK_OFFSET,
+	 0,
+	 RPU_ADDR_MASK_OFFSET,
+	 SOC_MMAP_ADDR_OFFSET_FPGA_REGS},
+	{RPU_ADDR_WICR_REGS_REGION,
+	 RPU_ADDR_WICR_REGS_REGION | RPU_ADDR_MASK_OFFSET,
+	 0,
+	 RPU_WICR_ADDR_MASK_OFFSET,
+	 SOC_MMAP_ADDR_OFFSET_WICR_REGS},
+#ifdef SOC_WEZEN_SECURE_DOMAIN
+	{RPU_ADDR_SECURERAM_REGION,
+	 RPU_ADDR_SECURERAM_REGION | RPU_ADDR_MASK_OFFSET,
+	 0,
+	 RPU_ADDR_MASK_OFFSET,
+	 SOC_MAMP_ADDR_OFFSET_SECURERAM},
+#endif /* SOC_WEZEN_SECURE_DOMAIN */
+#else
+	{RPU_ADDR_SBUS_START,
+	 RPU_ADDR_SBUS_START | RPU_ADDR_MASK_OFFSET,
+	 0,
+	 RPU_ADDR_MASK_OFFSET,
+	 SOC_MMAP_ADDR_OFFSET_SYSBUS},
+	{RPU_ADDR_GRAM_START,
+	 RPU_ADDR_GRAM_END,
+	 0,
+	 RPU_ADDR_MASK_OFFSET,
+	 SOC_MMAP_ADDR_OFFSET_GRAM_PKD},
+	{RPU_ADDR_PBUS_START,
+	 RPU_ADDR_PBUS_START | RPU_ADDR_MASK_OFFSET,
+	 0,
+	 RPU_ADDR_MASK_OFFSET,
+	 SOC_MMAP_ADDR_OFFSET_PBUS},
+	{RPU_ADDR_GDRAM_START,
+	 RPU_ADDR_GDRAM_END,
+	 0,
+	 RPU_ADDR_MASK_OFFSET,
+	 SOC_MMAP_ADDR_OFFSET_GDRAM_PKD},
+	{RPU_ADDR_PKTRAM_START,
+	 RPU_ADDR_PKTRAM_START | RPU_ADDR_MASK_OFFSET,
+	 0,
+	 RPU_ADDR_MASK_OFFSET,
+	 SOC_MMAP_ADDR_OFFSET_PKTRAM_HOST_VIEW},
+#endif /* SOC_WEZEN */
+};
+
+static const struct pal_rpu_mmap_region *pal_rpu_mmap_region_get(unsigned int rpu_addr)
+{
+	const struct pal_rpu_mmap_region *region = NULL;
+	unsigned int i = 0;
+
+	for (i = 0; i < ARRAY_SIZE(pal_rpu_mmap_regions); i++) {
+		region = &pal_rpu_mmap_regions[i];
+
+		if ((rpu_addr >= region->start) && (rpu_addr <= region->end)) {
+			return region;
+		}
+	}
+
+	return NULL;
+}
+
+
 enum nrf_wifi_status pal_rpu_addr_offset_get(struct nrf_wifi_osal_priv *opriv,
 					     unsigned int rpu_addr,
 					     unsigned long *addr,
 						 enum RPU_PROC_TYPE proc)
 {
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
-	unsigned int addr_base = (rpu_addr & RPU_ADDR_MASK_BASE);
-	unsigned long region_offset = 0;
-
-#ifdef SOC_WEZEN
-	unsigned int bellboard_grtc_addr_base = 0;
+	const struct pal_rpu_mmap_region *region = NULL;
 
-	if (addr_base == RPU_ADDR_WIFI_MCU_REGS_START) {
-		region_offset = SOC_MMAP_ADDR_OFFSET_WIFI_MCU_REGS;
-	} else if ((rpu_addr >= RPU_ADDR_RAM0_START) &&
-		   (rpu_addr <= RPU_ADDR_RAM0_END)) {
-		region_offset = SOC_MMAP_ADDR_OFFSET_RAM0_PKD;
-		*addr = region_offset + ((rpu_addr - RPU_ADDR_RAM0_START) & RPU_ADDR_RAM_ROM_MASK_OFFSET);
-		status = NRF_WIFI_STATUS_SUCCESS;
-		goto out;
-	} else if ((rpu_addr >= RPU_ADDR_RAM1_START) &&
-		   (rpu_addr <= RPU_ADDR_RAM1_END)) {
-		region_offset = SOC_MMAP_ADDR_OFFSET_RAM1_PKD;
-		*addr = region_offset + ((rpu_addr - RPU_ADDR_RAM1_START) & RPU_ADDR_RAM_ROM_MASK_OFFSET);
-		status = NRF_WIFI_STATUS_SUCCESS;
-		goto out;
-	} else if ((rpu_addr >= RPU_ADDR_ROM0_START) &&
-		   (rpu_addr <= RPU_ADDR_ROM0_END)) {
-		region_offset = SOC_MMAP_ADDR_OFFSET_ROM0_PKD;
-		*addr = region_offset + ((rpu_addr - RPU_ADDR_ROM0_START) & RPU_ADDR_RAM_ROM_MASK_OFFSET);
-		status = NRF_WIFI_STATUS_SUCCESS;
-		goto out;
-	} else if ((rpu_addr >= RPU_ADDR_ROM1_START) &&
-		   (rpu_addr <= RPU_ADDR_ROM1_END)) {
-		region_offset = SOC_MMAP_ADDR_OFFSET_ROM1_PKD;
-		*addr = region_offset + ((rpu_addr - RPU_ADDR_ROM1_START) & RPU_ADDR_RAM_ROM_MASK_OFFSET);
-		status = NRF_WIFI_STATUS_SUCCESS;
-		goto out;
-	} else if ((rpu_addr >= RPU_ADDR_DATA_RAM_START) &&
-		   (rpu_addr <= RPU_ADDR_DATA_RAM_END)) {
-		region_offset = SOC_MMAP_ADDR_OFFSET_DATA_RAM_PKD;
-	} else if ((rpu_addr >= RPU_ADDR_ACTUAL_DATA_RAM_START) &&
-		   (rpu_addr <= RPU_ADDR_ACTUAL_DATA_RAM_END)) {
-		region_offset = SOC_MMAP_ADDR_OFFSET_DATA_RAM_PKD;
-	} else if ((rpu_addr >= RPU_ADDR_CODE_RAM_START) &&
-		   (rpu_addr <= RPU_ADDR_CODE_RAM_END)) {
-		region_offset = SOC_MMAP_ADDR_OFFSET_CODE_RAM_PKD;
-        } else if (addr_base == RPU_ADDR_BELLBOARD_GRTC_REGION) {
-		bellboard_grtc_addr_base = (rpu_addr & RPU_ADDR_BELLBOARD_GRTC_MASK_BASE);
+	region = pal_rpu_mmap_region_get(rpu_addr);
 
-		if (bellboard_grtc_addr_base == RPU_ADDR_BELLBOARD_APP_REGION)
-			region_offset = SOC_MMAP_ADDR_OFFSET_BELLBOARD_APP;
-		else if (bellboard_grtc_addr_base == RPU_ADDR_BELLBOARD_WIFI_REGION)
-			region_offset = SOC_MMAP_ADDR_OFFSET_BELLBOARD_WIFI;
-		else if (bellboard_grtc_addr_base == RPU_ADDR_GRTC_REGION)
-	                region_offset = SOC_MMAP_ADDR_OFFSET_GRTC;
-        } else if (addr_base == RPU_ADDR_FPGA_REGS_REGION) {
-                region_offset = SOC_MMAP_ADDR_OFFSET_FPGA_REGS;
-	} else if (addr_base == RPU_ADDR_WICR_REGS_REGION) {
-		region_offset = SOC_MMAP_ADDR_OFFSET_WICR_REGS;
-#ifdef SOC_WEZEN_SECURE_DOMAIN
-        } else if (addr_base == RPU_ADDR_SECURERAM_REGION) {
-                region_offset = SOC_MAMP_ADDR_OFFSET_SECURERAM;
-#endif
-#else
-	if (addr_base == RPU_ADDR_SBUS_START) {
-		region_offset = SOC_MMAP_ADDR_OFFSET_SYSBUS;
-	} else if ((rpu_addr >= RPU_ADDR_GRAM_START) &&
-		   (rpu_addr <= RPU_ADDR_GRAM_END)) {
-		region_offset = SOC_MMAP_ADDR_OFFSET_GRAM_PKD;
-	} else if (addr_base == RPU_ADDR_PBUS_START) {
-		region_offset = SOC_MMAP_ADDR_OFFSET_PBUS;
-	} else if ((rpu_addr >= RPU_ADDR_GDRAM_START) &&
-			(rpu_addr <= RPU_ADDR_GDRAM_END)) {
-		region_offset = SOC_MMAP_ADDR_OFFSET_GDRAM_PKD;
-	} else if (addr_base == RPU_ADDR_PKTRAM_START) {
-		region_offset = SOC_MMAP_ADDR_OFFSET_PKTRAM_HOST_VIEW;
-	}
-	else if (pal_check_rpu_mcu_regions(proc, rpu_addr)) {
-		region_offset = SOC_MMAP_ADDR_OFFSETS_MCU[proc];
-#endif
+	if (region) {
+		*addr = region->host_base + ((rpu_addr - region->rpu_base) & region->mask);
+#ifndef SOC_WEZEN
+	} else if (pal_check_rpu_mcu_regions(proc, rpu_addr)) {
+		*addr = SOC_MMAP_ADDR_OFFSETS_MCU[proc] + (rpu_addr & RPU_ADDR_MASK_OFFSET);
+#endif /* !SOC_WEZEN */
 	} else {
 		nrf_wifi_osal_log_err(opriv,
 				      "%s: Invalid rpu_addr 0x%X\n",
@@ -120,16 +191,6 @@ enum nrf_wifi_status pal_rpu_addr_offset_get(struct nrf_wifi_osal_priv *opriv,
 				      rpu_addr);
 		goto out;
 	}
-#ifdef SOC_WEZEN
-	if (addr_base == RPU_ADDR_BELLBOARD_GRTC_REGION)
-		*addr = region_offset + (rpu_addr & RPU_BELLBOARD_GRTC_ADDR_MASK_OFFSET);
-	else if (addr_base == RPU_ADDR_CODE_RAM_REGION)
-		*addr = region_offset + ((rpu_addr - RPU_ADDR_CODE_RAM_START) & RPU_ADDR_MASK_OFFSET);
-	else if (addr_base == RPU_ADDR_WICR_REGS_REGION)
-		*addr = region_offset + (rpu_addr & RPU_WICR_ADDR_MASK_OFFSET);
-	else
-#endif
-	*addr = region_offset + (rpu_addr & RPU_ADDR_MASK_OFFSET);
 
 	status = NRF_WIFI_STATUS_SUCCESS;
 out:
@@ -605,6 +605,21 @@ void nrf_wifi_osal_nbuf_free(struct nrf_wifi_osal_priv *opriv,
 			      void *nbuf);
 
 
+/**
+ * nrf_wifi_osal_nbuf_reset() - Reset a network buffer for reuse.
+ * @opriv: Pointer to the OSAL context returned by the @nrf_wifi_osal_init API.
+ * @nbuf: Pointer to a network buffer.
+ *
+ * Resets a network buffer(@nbuf) which was allocated by
+ * @nrf_wifi_osal_nbuf_alloc to an empty data area with no headroom reserved,
+ * as it was when it was allocated.
+ *
+ * Return: None.
+ */
+void nrf_wifi_osal_nbuf_reset(struct nrf_wifi_osal_priv *opriv,
+			      void *nbuf);
+
+
 /**
  * nrf_wifi_osal_nbuf_headroom_res() - Reserve headroom space in a network buffer.
  * @opriv: Pointer to the OSAL context returned by the @nrf_wifi_osal_init API.
@@ -1458,7 +1473,7 @@ void nrf_wifi_osal_spi_cpy_to(struct nrf_wifi_osal_priv *opriv,
 				size_t count);
 
 
-#ifdef CONFIG_NRF_WIFI_LOW_POWER
+#if defined(CONFIG_NRF_WIFI_LOW_POWER) || defined(HAL_CMD_ASYNC)
 /**
  * nrf_wifi_osal_timer_alloc() - Allocate a timer.
  * @opriv: Pointer to the OSAL context returned by the @nrf_wifi_osal_init API.
@@ -1530,9 +1545,9 @@ void nrf_wifi_osal_timer_schedule(struct nrf_wifi_osal_priv *opriv,
  */
 void nrf_wifi_osal_timer_kill(struct nrf_wifi_osal_priv *opriv,
 			       void *timer);
+#endif /* CONFIG_NRF_WIFI_LOW_POWER || HAL_CMD_ASYNC */
 
-
-
+#ifdef CONFIG_NRF_WIFI_LOW_POWER
 int nrf_wifi_osal_bus_qspi_ps_sleep(struct nrf_wifi_osal_priv *opriv,
 				    void *os_qspi_priv);
 
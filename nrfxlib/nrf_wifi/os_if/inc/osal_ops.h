@@ -88,6 +88,8 @@
  *
  * @nbuf_alloc: Allocate a network buffer of size @size.
  * @nbuf_free: Free a network buffer(@nbuf) which was allocated by @nbuf_alloc.
+ * @nbuf_reset: Reset a network buffer(@nbuf) to the state it was in when it
+ *              was returned by @nbuf_alloc, so that it can be reused.
  * @nbuf_headroom_res: Reserve headroom at the beginning of the data area of a
  *                     network buffer(@nbuf).
  * @nbuf_headroom_get: Get the size of the reserved headroom at the beginning
@@ -236,6 +238,7 @@ struct nrf_wifi_osal_ops {
 
 	void *(*nbuf_alloc)(unsigned int size);
 	void (*nbuf_free)(void *nbuf);
+	void (*nbuf_reset)(void *nbuf);
 	void (*nbuf_headroom_res)(void *nbuf, unsigned int size);
 	unsigned int (*nbuf_headroom_get)(void *nbuf);
 	unsigned int (*nbuf_data_size)(void *nbuf);
@@ -320,7 +323,7 @@ struct nrf_wifi_osal_ops {
 	void (*bus_spi_dev_intr_unreg)(void *os_spi_dev_ctx);
 	void (*bus_spi_dev_host_map_get)(void *os_spi_dev_ctx,
 					  struct nrf_wifi_osal_host_map *host_map);
-#ifdef CONFIG_NRF_WIFI_LOW_POWER
+#if defined(CONFIG_NRF_WIFI_LOW_POWER) || defined(HAL_CMD_ASYNC)
 	void *(*timer_alloc)(void);
 	void (*timer_free)(void *timer);
 	void (*timer_init)(void *timer,
@@ -328,6 +331,8 @@ struct nrf_wifi_osal_ops {
 			   unsigned long data);
 	void (*timer_schedule)(void *timer, unsigned long duration);
 	void (*timer_kill)(void *timer);
+#endif /* CONFIG_NRF_WIFI_LOW_POWER || HAL_CMD_ASYNC */
+#ifdef CONFIG_NRF_WIFI_LOW_POWER
 	int (*bus_qspi_ps_sleep)(void *os_qspi_priv);
 	int (*bus_qspi_ps_wake)(void *os_qspi_priv);
 	int (*bus_qspi_ps_status)(void *os_qspi_priv);
@@ -383,6 +383,13 @@ void nrf_wifi_osal_nbuf_free(struct nrf_wifi_osal_priv *opriv,
 }
 
 
+void nrf_wifi_osal_nbuf_reset(struct nrf_wifi_osal_priv *opriv,
+			      void *nbuf)
+{
+	opriv->ops->nbuf_reset(nbuf);
+}
+
+
 void nrf_wifi_osal_nbuf_headroom_res(struct nrf_wifi_osal_priv *opriv,
 				     void *nbuf,
 				     unsigned int size)
@@ -847,7 +854,7 @@ void nrf_wifi_osal_spi_cpy_to(struct nrf_wifi_osal_priv *opriv,
 								count);
 }
 
-#ifdef CONFIG_NRF_WIFI_LOW_POWER
+#if defined(CONFIG_NRF_WIFI_LOW_POWER) || defined(HAL_CMD_ASYNC)
 void *nrf_wifi_osal_timer_alloc(struct nrf_wifi_osal_priv *opriv)
 {
 	return opriv->ops->timer_alloc();
@@ -886,9 +893,9 @@ void nrf_wifi_osal_timer_kill(struct nrf_wifi_osal_priv *opriv,
 {
 	opriv->ops->timer_kill(timer);
 }
+#endif /* CONFIG_NRF_WIFI_LOW_POWER || HAL_CMD_ASYNC */
 
-
-
+#ifdef CONFIG_NRF_WIFI_LOW_POWER
 int nrf_wifi_osal_bus_qspi_ps_sleep(struct nrf_wifi_osal_priv *opriv,
 				    void *os_qspi_priv)
 {
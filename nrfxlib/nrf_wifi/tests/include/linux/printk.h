@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief Host build stand-in for the kernel printk header used by some of
+ * the library sources.
+ */
+
+#ifndef __LINUX_PRINTK_H__
+#define __LINUX_PRINTK_H__
+
+int mock_osal_printk(const char *fmt, ...);
+
+#define pr_err(...) mock_osal_printk(__VA_ARGS__)
+#define pr_info(...) mock_osal_printk(__VA_ARGS__)
+#define pr_debug(...) mock_osal_printk(__VA_ARGS__)
+
+#endif /* __LINUX_PRINTK_H__ */
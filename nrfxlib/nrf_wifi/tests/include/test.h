@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief Minimal test helpers shared by the host unit tests.
+ */
+
+#ifndef __TEST_H__
+#define __TEST_H__
+
+#include <stdio.h>
+#include <time.h>
+
+static unsigned int test_failures;
+
+#define TEST_CHECK(cond)						\
+	do {								\
+		if (!(cond)) {						\
+			fprintf(stderr, "%s:%d: check failed: %s\n",	\
+				__FILE__, __LINE__, #cond);		\
+			test_failures++;				\
+		}							\
+	} while (0)
+
+#define TEST_CHECK_EQ(a, b)						\
+	do {								\
+		unsigned long long __a = (a);				\
+		unsigned long long __b = (b);				\
+									\
+		if (__a != __b) {					\
+			fprintf(stderr, "%s:%d: %s == %s failed: %llu != %llu\n", \
+				__FILE__, __LINE__, #a, #b, __a, __b);	\
+			test_failures++;				\
+		}							\
+	} while (0)
+
+#define TEST_RUN(fn)							\
+	do {								\
+		unsigned int __failures = test_failures;		\
+									\
+		fn();							\
+		printf("%-40s %s\n", #fn,				\
+		       (test_failures == __failures) ? "ok" : "FAIL");	\
+	} while (0)
+
+#define TEST_EXIT() (test_failures ? 1 : 0)
+
+/* Wall clock for the benchmarks, in ns */
+static inline unsigned long long test_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (ts.tv_sec * 1000000000ULL) + ts.tv_nsec;
+}
+
+#endif /* __TEST_H__ */
@@ -0,0 +1,710 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief Simulated bus and RPU for the HAL tests.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hal_api.h"
+#include "pal.h"
+#include "mock_osal.h"
+#include "mock_bal.h"
+
+#define MOCK_BAL_HPQ_LEN 64
+#define MOCK_BAL_RX_CMD_BASE 0x200B0000
+
+struct mock_bal_stats mock_bal_stats;
+
+unsigned long mock_bal_ps_wake_latency_us;
+
+bool mock_bal_dma_unmap_fail;
+
+void (*mock_bal_write_hook)(unsigned long addr_offset, unsigned int val);
+
+static unsigned char mem[MOCK_BAL_MEM_SZ];
+/* Bus reads and writes per word of mem */
+static unsigned int mem_reads[MOCK_BAL_MEM_SZ / 4];
+static unsigned int mem_writes[MOCK_BAL_MEM_SZ / 4];
+
+static struct {
+	unsigned int vals[MOCK_BAL_HPQ_LEN];
+	unsigned int head;
+	unsigned int tail;
+	struct host_rpu_hpq regs;
+} hpqs[MOCK_BAL_HPQ_MAX];
+
+static struct {
+	unsigned long virt_addr;
+	size_t len;
+	bool mapped;
+} dma_slots[MOCK_BAL_DMA_SLOTS];
+
+static bool ps_wake_req;
+static unsigned long ps_wake_req_us;
+static bool fw_booted;
+
+static struct nrf_wifi_osal_priv *mock_opriv;
+static enum nrf_wifi_status (*mock_isr)(void *ctx);
+static void *mock_bal_dev_ctx;
+
+static pthread_mutex_t mock_bal_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+
+unsigned long mock_bal_rpu_offset(unsigned int rpu_addr)
+{
+	unsigned long offset = 0;
+
+	if ((pal_rpu_addr_offset_get(mock_opriv,
+				     rpu_addr,
+				     &offset,
+				     RPU_PROC_TYPE_MCU_LMAC) != NRF_WIFI_STATUS_SUCCESS) ||
+	    (offset > (MOCK_BAL_MEM_SZ - 4))) {
+		fprintf(stderr, "%s: Unmapped RPU address 0x%X\n", __func__, rpu_addr);
+		abort();
+	}
+
+	return offset;
+}
+
+
+static bool ps_ready(void)
+{
+	return ps_wake_req &&
+		((mock_osal_time_us() - ps_wake_req_us) >= mock_bal_ps_wake_latency_us);
+}
+
+
+/* Called with mock_bal_mutex held */
+static void access_check(unsigned long offset)
+{
+	if (fw_booted && (offset != SOC_MMAP_ADDR_RPU_PS_CTRL) && !ps_ready()) {
+		mock_bal_stats.asleep_accesses++;
+	}
+}
+
+
+/* Called with mock_bal_mutex held, returns true if offset is a HPQ register */
+static bool hpq_reg_read(unsigned long offset, unsigned int *val)
+{
+	unsigned int i = 0;
+
+	for (i = 0; i < MOCK_BAL_HPQ_MAX; i++) {
+		if (offset == mock_bal_rpu_offset(hpqs[i].regs.dequeue_addr)) {
+			*val = (hpqs[i].head == hpqs[i].tail) ? 0 :
+				hpqs[i].vals[hpqs[i].head % MOCK_BAL_HPQ_LEN];
+			return true;
+		}
+
+		if (offset == mock_bal_rpu_offset(hpqs[i].regs.enqueue_addr)) {
+			*val = 0;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+/* Called with mock_bal_mutex held, returns true if offset is a HPQ register */
+static bool hpq_reg_write(unsigned long offset, unsigned int val)
+{
+	unsigned int i = 0;
+
+	for (i = 0; i < MOCK_BAL_HPQ_MAX; i++) {
+		if (offset == mock_bal_rpu_offset(hpqs[i].regs.enqueue_addr)) {
+			if ((hpqs[i].tail - hpqs[i].head) == MOCK_BAL_HPQ_LEN) {
+				fprintf(stderr, "%s: HPQ %u full\n", __func__, i);
+				abort();
+			}
+
+			hpqs[i].vals[hpqs[i].tail++ % MOCK_BAL_HPQ_LEN] = val;
+			return true;
+		}
+
+		if (offset == mock_bal_rpu_offset(hpqs[i].regs.dequeue_addr)) {
+			/* Pops the head, if it is the value written */
+			if ((hpqs[i].head != hpqs[i].tail) &&
+			    (hpqs[i].vals[hpqs[i].head % MOCK_BAL_HPQ_LEN] == val)) {
+				hpqs[i].head++;
+			}
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+void mock_bal_reset(void)
+{
+	unsigned int i = 0;
+
+	pthread_mutex_lock(&mock_bal_mutex);
+
+	memset(&mock_bal_stats, 0, sizeof(mock_bal_stats));
+	memset(mem, 0, sizeof(mem));
+	memset(mem_reads, 0, sizeof(mem_reads));
+	memset(mem_writes, 0, sizeof(mem_writes));
+	memset(dma_slots, 0, sizeof(dma_slots));
+
+	for (i = 0; i < MOCK_BAL_HPQ_MAX; i++) {
+		hpqs[i].head = 0;
+		hpqs[i].tail = 0;
+		hpqs[i].regs.enqueue_addr = MOCK_BAL_HPQ_REG_BASE + (i * 8);
+		hpqs[i].regs.dequeue_addr = MOCK_BAL_HPQ_REG_BASE + (i * 8) + 4;
+	}
+
+	ps_wake_req = false;
+	ps_wake_req_us = 0;
+	fw_booted = false;
+	mock_bal_ps_wake_latency_us = 0;
+	mock_bal_dma_unmap_fail = false;
+	mock_bal_write_hook = NULL;
+
+	pthread_mutex_unlock(&mock_bal_mutex);
+}
+
+
+unsigned int mock_bal_rpu_read(unsigned int rpu_addr)
+{
+	unsigned int val = 0;
+
+	pthread_mutex_lock(&mock_bal_mutex);
+	memcpy(&val, &mem[mock_bal_rpu_offset(rpu_addr)], sizeof(val));
+	pthread_mutex_unlock(&mock_bal_mutex);
+
+	return val;
+}
+
+
+void mock_bal_rpu_write(unsigned int rpu_addr, unsigned int val)
+{
+	pthread_mutex_lock(&mock_bal_mutex);
+	memcpy(&mem[mock_bal_rpu_offset(rpu_addr)], &val, sizeof(val));
+	pthread_mutex_unlock(&mock_bal_mutex);
+}
+
+
+unsigned long mock_bal_rpu_read_count(unsigned int rpu_addr)
+{
+	unsigned long count = 0;
+
+	pthread_mutex_lock(&mock_bal_mutex);
+	count = mem_reads[mock_bal_rpu_offset(rpu_addr) / 4];
+	pthread_mutex_unlock(&mock_bal_mutex);
+
+	return count;
+}
+
+
+unsigned long mock_bal_rpu_write_count(unsigned int rpu_addr)
+{
+	unsigned long count = 0;
+
+	pthread_mutex_lock(&mock_bal_mutex);
+	count = mem_writes[mock_bal_rpu_offset(rpu_addr) / 4];
+	pthread_mutex_unlock(&mock_bal_mutex);
+
+	return count;
+}
+
+
+void mock_bal_hpq_push(enum mock_bal_hpq hpq, unsigned int val)
+{
+	pthread_mutex_lock(&mock_bal_mutex);
+	hpq_reg_write(mock_bal_rpu_offset(hpqs[hpq].regs.enqueue_addr), val);
+	pthread_mutex_unlock(&mock_bal_mutex);
+}
+
+
+unsigned int mock_bal_hpq_pop(enum mock_bal_hpq hpq)
+{
+	unsigned int val = 0;
+
+	pthread_mutex_lock(&mock_bal_mutex);
+
+	if (hpqs[hpq].head != hpqs[hpq].tail) {
+		val = hpqs[hpq].vals[hpqs[hpq].head++ % MOCK_BAL_HPQ_LEN];
+	}
+
+	pthread_mutex_unlock(&mock_bal_mutex);
+
+	return val;
+}
+
+
+unsigned int mock_bal_hpq_len(enum mock_bal_hpq hpq)
+{
+	unsigned int len = 0;
+
+	pthread_mutex_lock(&mock_bal_mutex);
+	len = hpqs[hpq].tail - hpqs[hpq].head;
+	pthread_mutex_unlock(&mock_bal_mutex);
+
+	return len;
+}
+
+
+const struct host_rpu_hpq *mock_bal_hpq_regs(enum mock_bal_hpq hpq)
+{
+	return &hpqs[hpq].regs;
+}
+
+
+bool mock_bal_rpu_awake(void)
+{
+	bool awake = false;
+
+	pthread_mutex_lock(&mock_bal_mutex);
+	awake = ps_ready();
+	pthread_mutex_unlock(&mock_bal_mutex);
+
+	return awake;
+}
+
+
+enum nrf_wifi_status mock_bal_irq(void)
+{
+	return mock_isr(mock_bal_dev_ctx);
+}
+
+
+unsigned int mock_bal_dma_mapped(void)
+{
+	unsigned int mapped = 0;
+	unsigned int i = 0;
+
+	pthread_mutex_lock(&mock_bal_mutex);
+
+	for (i = 0; i < MOCK_BAL_DMA_SLOTS; i++) {
+		if (dma_slots[i].mapped) {
+			mapped++;
+		}
+	}
+
+	pthread_mutex_unlock(&mock_bal_mutex);
+
+	return mapped;
+}
+
+
+bool mock_bal_dma_write(unsigned long phy_addr, const void *data, size_t len)
+{
+	unsigned long slot_addr = 0;
+	bool written = false;
+	unsigned int i = 0;
+
+	pthread_mutex_lock(&mock_bal_mutex);
+
+	for (i = 0; i < MOCK_BAL_DMA_SLOTS; i++) {
+		slot_addr = MOCK_BAL_DMA_BASE + (i * MOCK_BAL_DMA_SLOT_SZ);
+
+		if (dma_slots[i].mapped &&
+		    (phy_addr >= slot_addr) &&
+		    ((phy_addr + len) <= (slot_addr + dma_slots[i].len))) {
+			memcpy((void *)(dma_slots[i].virt_addr + (phy_addr - slot_addr)),
+			       data,
+			       len);
+			written = true;
+			break;
+		}
+	}
+
+	pthread_mutex_unlock(&mock_bal_mutex);
+
+	return written;
+}
+
+
+static void *mock_bus_init(struct nrf_wifi_osal_priv *opriv,
+			   void *cfg_params,
+			   enum nrf_wifi_status (*intr_callbk_fn)(void *hal_ctx))
+{
+	mock_opriv = opriv;
+	mock_isr = intr_callbk_fn;
+
+	return mem;
+}
+
+
+static void mock_bus_deinit(void *bus_priv)
+{
+	mock_isr = NULL;
+}
+
+
+static void *mock_bus_dev_add(void *bus_priv,
+			      void *bal_dev_ctx)
+{
+	mock_bal_dev_ctx = bal_dev_ctx;
+
+	return mem;
+}
+
+
+static void mock_bus_dev_rem(void *bus_dev_ctx)
+{
+	mock_bal_dev_ctx = NULL;
+}
+
+
+static enum nrf_wifi_status mock_bus_dev_init(void *bus_dev_ctx)
+{
+	pthread_mutex_lock(&mock_bal_mutex);
+	fw_booted = true;
+	pthread_mutex_unlock(&mock_bal_mutex);
+
+	return NRF_WIFI_STATUS_SUCCESS;
+}
+
+
+static void mock_bus_dev_deinit(void *bus_dev_ctx)
+{
+	pthread_mutex_lock(&mock_bal_mutex);
+	fw_booted = false;
+	pthread_mutex_unlock(&mock_bal_mutex);
+}
+
+
+static unsigned int mock_bus_read_word(void *bus_dev_ctx,
+				       unsigned long addr_offset)
+{
+	unsigned int val = 0;
+
+	pthread_mutex_lock(&mock_bal_mutex);
+
+	mock_bal_stats.word_reads++;
+	access_check(addr_offset);
+	mem_reads[addr_offset / 4]++;
+
+	if (!hpq_reg_read(addr_offset, &val)) {
+		memcpy(&val, &mem[addr_offset], sizeof(val));
+	}
+
+	pthread_mutex_unlock(&mock_bal_mutex);
+
+	return val;
+}
+
+
+static void mock_bus_write_word(void *bus_dev_ctx,
+				unsigned long addr_offset,
+				unsigned int val)
+{
+	pthread_mutex_lock(&mock_bal_mutex);
+
+	mock_bal_stats.word_writes++;
+	access_check(addr_offset);
+	mem_writes[addr_offset / 4]++;
+
+	if (!hpq_reg_write(addr_offset, val)) {
+		memcpy(&mem[addr_offset], &val, sizeof(val));
+	}
+
+	pthread_mutex_unlock(&mock_bal_mutex);
+
+	if (mock_bal_write_hook) {
+		mock_bal_write_hook(addr_offset, val);
+	}
+}
+
+
+static void mock_bus_read_block(void *bus_dev_ctx,
+				void *dest_addr,
+				unsigned long src_addr_offset,
+				size_t len)
+{
+	unsigned long i = 0;
+
+	pthread_mutex_lock(&mock_bal_mutex);
+
+	mock_bal_stats.block_reads++;
+	access_check(src_addr_offset);
+	memcpy(dest_addr, &mem[src_addr_offset], len);
+
+	for (i = src_addr_offset / 4; i < (src_addr_offset + len + 3) / 4; i++) {
+		mem_reads[i]++;
+	}
+
+	pthread_mutex_unlock(&mock_bal_mutex);
+}
+
+
+static void mock_bus_write_block(void *bus_dev_ctx,
+				 unsigned long dest_addr_offset,
+				 const void *src_addr,
+				 size_t len)
+{
+	unsigned long i = 0;
+
+	pthread_mutex_lock(&mock_bal_mutex);
+
+	mock_bal_stats.block_writes++;
+	access_check(dest_addr_offset);
+	memcpy(&mem[dest_addr_offset], src_addr, len);
+
+	for (i = dest_addr_offset / 4; i < (dest_addr_offset + len + 3) / 4; i++) {
+		mem_writes[i]++;
+	}
+
+	pthread_mutex_unlock(&mock_bal_mutex);
+}
+
+
+static unsigned long mock_bus_dma_map(void *bus_dev_ctx,
+				      unsigned long virt_addr,
+				      size_t len,
+				      enum nrf_wifi_osal_dma_dir dma_dir)
+{
+	unsigned long phy_addr = 0;
+	unsigned int i = 0;
+
+	if (len > MOCK_BAL_DMA_SLOT_SZ) {
+		return 0;
+	}
+
+	pthread_mutex_lock(&mock_bal_mutex);
+
+	for (i = 0; i < MOCK_BAL_DMA_SLOTS; i++) {
+		if (!dma_slots[i].mapped) {
+			dma_slots[i].virt_addr = virt_addr;
+			dma_slots[i].len = len;
+			dma_slots[i].mapped = true;
+			phy_addr = MOCK_BAL_DMA_BASE + (i * MOCK_BAL_DMA_SLOT_SZ);
+			mock_bal_stats.dma_maps++;
+			break;
+		}
+	}
+
+	pthread_mutex_unlock(&mock_bal_mutex);
+
+	return phy_addr;
+}
+
+
+static unsigned long mock_bus_dma_unmap(void *bus_dev_ctx,
+					unsigned long phy_addr,
+					size_t len,
+					enum nrf_wifi_osal_dma_dir dma_dir)
+{
+	unsigned long virt_addr = 0;
+	unsigned long i = 0;
+
+	pthread_mutex_lock(&mock_bal_mutex);
+
+	i = (phy_addr - MOCK_BAL_DMA_BASE) / MOCK_BAL_DMA_SLOT_SZ;
+
+	if (mock_bal_dma_unmap_fail) {
+		goto out;
+	}
+
+	if ((phy_addr < MOCK_BAL_DMA_BASE) ||
+	    (phy_addr != (MOCK_BAL_DMA_BASE + (i * MOCK_BAL_DMA_SLOT_SZ))) ||
+	    (i >= MOCK_BAL_DMA_SLOTS) ||
+	    !dma_slots[i].mapped ||
+	    (dma_slots[i].len != len)) {
+		mock_bal_stats.dma_bad_unmaps++;
+		goto out;
+	}
+
+	virt_addr = dma_slots[i].virt_addr;
+	dma_slots[i].mapped = false;
+	mock_bal_stats.dma_unmaps++;
+out:
+	pthread_mutex_unlock(&mock_bal_mutex);
+
+	return virt_addr;
+}
+
+
+#ifdef CONFIG_NRF_WIFI_LOW_POWER
+static void mock_bus_rpu_ps_sleep(void *bus_dev_ctx)
+{
+	pthread_mutex_lock(&mock_bal_mutex);
+
+	mock_bal_stats.ps_sleeps++;
+	ps_wake_req = false;
+
+	pthread_mutex_unlock(&mock_bal_mutex);
+}
+
+
+static void mock_bus_rpu_ps_wake(void *bus_dev_ctx)
+{
+	pthread_mutex_lock(&mock_bal_mutex);
+
+	mock_bal_stats.ps_wakes++;
+
+	if (!ps_wake_req) {
+		ps_wake_req = true;
+		ps_wake_req_us = mock_osal_time_us();
+	}
+
+	pthread_mutex_unlock(&mock_bal_mutex);
+}
+
+
+static int mock_bus_rpu_ps_status(void *bus_dev_ctx)
+{
+	int val = 0;
+
+	pthread_mutex_lock(&mock_bal_mutex);
+
+	mock_bal_stats.ps_status_reads++;
+
+	if (ps_wake_req) {
+		val |= (1 << RPU_REG_BIT_PS_CTRL);
+	}
+
+	if (ps_ready()) {
+		val |= (1 << RPU_REG_BIT_PS_STATE) | (1 << RPU_REG_BIT_READY_STATE);
+	}
+
+	pthread_mutex_unlock(&mock_bal_mutex);
+
+	return val;
+}
+#endif /* CONFIG_NRF_WIFI_LOW_POWER */
+
+
+static struct nrf_wifi_bal_ops mock_bal_ops = {
+	.init = mock_bus_init,
+	.deinit = mock_bus_deinit,
+	.dev_add = mock_bus_dev_add,
+	.dev_rem = mock_bus_dev_rem,
+	.dev_init = mock_bus_dev_init,
+	.dev_deinit = mock_bus_dev_deinit,
+	.read_word = mock_bus_read_word,
+	.write_word = mock_bus_write_word,
+	.read_block = mock_bus_read_block,
+	.write_block = mock_bus_write_block,
+	.dma_map = mock_bus_dma_map,
+	.dma_unmap = mock_bus_dma_unmap,
+#ifdef SOC_WEZEN
+#ifdef INLINE_RX
+	.dma_map_inline_rx = mock_bus_dma_map,
+	.dma_unmap_inline_rx = mock_bus_dma_unmap,
+#endif /* INLINE_RX */
+#endif /* SOC_WEZEN */
+#ifdef CONFIG_NRF_WIFI_LOW_POWER
+	.rpu_ps_sleep = mock_bus_rpu_ps_sleep,
+	.rpu_ps_wake = mock_bus_rpu_ps_wake,
+	.rpu_ps_status = mock_bus_rpu_ps_status,
+#endif /* CONFIG_NRF_WIFI_LOW_POWER */
+};
+
+
+struct nrf_wifi_bal_ops *get_bus_ops(void)
+{
+	return &mock_bal_ops;
+}
+
+
+struct nrf_wifi_hal_dev_ctx *
+mock_bal_hal_dev_add(void *mac_dev_ctx,
+		     enum nrf_wifi_status (*intr_callbk_fn)(void *mac_dev_ctx,
+							    void *event_data,
+							    unsigned int len),
+		     unsigned int num_cmd_bufs)
+{
+	struct nrf_wifi_hal_cfg_params cfg_params;
+	struct host_rpu_hpqm_info hpqm_info;
+	struct nrf_wifi_osal_priv *opriv = NULL;
+	struct nrf_wifi_hal_priv *hpriv = NULL;
+	struct nrf_wifi_hal_dev_ctx *hal_dev_ctx = NULL;
+	unsigned int *words = NULL;
+	unsigned int i = 0;
+
+	opriv = nrf_wifi_osal_init();
+
+	if (!opriv) {
+		return NULL;
+	}
+
+	memset(&cfg_params, 0, sizeof(cfg_params));
+	cfg_params.max_cmd_size = MOCK_BAL_MSG_BUF_SZ;
+	cfg_params.max_event_size = MOCK_BAL_MSG_BUF_SZ;
+	cfg_params.max_tx_frms = CONFIG_NRF700X_MAX_TX_TOKENS * CONFIG_NRF700X_MAX_TX_AGGREGATION;
+	cfg_params.max_tx_frm_sz = CONFIG_NRF700X_TX_MAX_DATA_SIZE;
+	cfg_params.rx_buf_headroom_sz = MOCK_BAL_RX_BUF_HEADROOM;
+
+	for (i = 0; i < MAX_NUM_OF_RX_QUEUES; i++) {
+		cfg_params.rx_buf_pool[i].num_bufs = CONFIG_NRF700X_RX_NUM_BUFS / MAX_NUM_OF_RX_QUEUES;
+		cfg_params.rx_buf_pool[i].buf_sz = CONFIG_NRF700X_RX_MAX_DATA_SIZE;
+	}
+
+	hpriv = nrf_wifi_hal_init(opriv, &cfg_params, intr_callbk_fn);
+
+	if (!hpriv) {
+		goto osal_deinit;
+	}
+
+	hal_dev_ctx = nrf_wifi_hal_dev_add(hpriv, mac_dev_ctx);
+
+	if (!hal_dev_ctx) {
+		goto hal_deinit;
+	}
+
+	/* What the firmware publishes once it has booted */
+	hpqm_info.event_busy_queue = hpqs[MOCK_BAL_HPQ_EVENT_BUSY].regs;
+	hpqm_info.event_avl_queue = hpqs[MOCK_BAL_HPQ_EVENT_AVL].regs;
+	hpqm_info.cmd_busy_queue = hpqs[MOCK_BAL_HPQ_CMD_BUSY].regs;
+	hpqm_info.cmd_avl_queue = hpqs[MOCK_BAL_HPQ_CMD_AVL].regs;
+
+	for (i = 0; i < MAX_NUM_OF_RX_QUEUES; i++) {
+		hpqm_info.rx_buf_busy_queue[i] = hpqs[MOCK_BAL_HPQ_RX_BUF_BUSY + i].regs;
+	}
+
+	words = (unsigned int *)&hpqm_info;
+
+	for (i = 0; i < (sizeof(hpqm_info) / 4); i++) {
+		mock_bal_rpu_write(RPU_MEM_HPQ_INFO + (i * 4), words[i]);
+	}
+
+	mock_bal_rpu_write(RPU_MEM_RX_CMD_BASE, MOCK_BAL_RX_CMD_BASE);
+
+	for (i = 0; i < num_cmd_bufs; i++) {
+#ifdef SOFT_HPQM
+		if (i < HOST_RPU_CMD_BUFFERS) {
+			mock_bal_rpu_write(MOCK_BAL_SOFT_HPQ_ADDR(cmd_free_buffs[i]),
+					   MOCK_BAL_CMD_BUF_BASE + (i * MOCK_BAL_MSG_BUF_SZ));
+		}
+#else
+		mock_bal_hpq_push(MOCK_BAL_HPQ_CMD_AVL,
+				  MOCK_BAL_CMD_BUF_BASE + (i * MOCK_BAL_MSG_BUF_SZ));
+#endif /* SOFT_HPQM */
+	}
+
+	if (nrf_wifi_hal_dev_init(hal_dev_ctx) != NRF_WIFI_STATUS_SUCCESS) {
+		goto dev_rem;
+	}
+
+	return hal_dev_ctx;
+dev_rem:
+	nrf_wifi_hal_dev_rem(hal_dev_ctx);
+hal_deinit:
+	nrf_wifi_hal_deinit(hpriv);
+osal_deinit:
+	nrf_wifi_osal_deinit(opriv);
+
+	return NULL;
+}
+
+
+void mock_bal_hal_dev_rem(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx)
+{
+	struct nrf_wifi_hal_priv *hpriv = hal_dev_ctx->hpriv;
+	struct nrf_wifi_osal_priv *opriv = hpriv->opriv;
+
+	nrf_wifi_hal_dev_deinit(hal_dev_ctx);
+	nrf_wifi_hal_dev_rem(hal_dev_ctx);
+	nrf_wifi_hal_deinit(hpriv);
+	nrf_wifi_osal_deinit(opriv);
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief Simulated bus and RPU for the HAL tests.
+ *
+ * The bus ops are backed by a flat copy of the host view of the RPU
+ * address space which counts the accesses made to it, so that tests can
+ * check the MMIO traffic of a code path. On top of that it plays the parts
+ * of the RPU the HAL depends on: the hardware queues (HPQs), the sleep
+ * controller and the interrupt line. DMA mappings are tracked so that an
+ * unmap of an address which was never mapped is caught.
+ */
+
+#ifndef __MOCK_BAL_H__
+#define __MOCK_BAL_H__
+
+#include <stdbool.h>
+#include "hal_api.h"
+
+/* Host view of the RPU address space, all the mapped regions are below */
+#define MOCK_BAL_MEM_SZ 0x400000
+
+#define MOCK_BAL_DMA_BASE 0x10000000UL
+#define MOCK_BAL_DMA_SLOT_SZ 0x10000UL
+#define MOCK_BAL_DMA_SLOTS 512
+
+/* RX buffer headroom of the FMAC (RX_BUF_HEADROOM) */
+#define MOCK_BAL_RX_BUF_HEADROOM 4
+
+/* Registers of the simulated HPQs, in the Wi-Fi MCU register region */
+#define MOCK_BAL_HPQ_REG_BASE 0x48001000
+
+/* Where the simulated RPU keeps its command and event buffers */
+#define MOCK_BAL_CMD_BUF_BASE 0x20090000
+#define MOCK_BAL_EVENT_BUF_BASE 0x200A0000
+#define MOCK_BAL_MSG_BUF_SZ 0x400
+
+#ifdef SOFT_HPQM
+/* RPU address of a field of the software HPQM rings */
+#define MOCK_BAL_SOFT_HPQ_ADDR(field) \
+	((unsigned int)(unsigned long)&((struct soft_hpqm_info *)HOST_RPU_GDRAM_START_ADDR)->field)
+#endif /* SOFT_HPQM */
+
+enum mock_bal_hpq {
+	MOCK_BAL_HPQ_EVENT_BUSY,
+	MOCK_BAL_HPQ_EVENT_AVL,
+	MOCK_BAL_HPQ_CMD_BUSY,
+	MOCK_BAL_HPQ_CMD_AVL,
+	MOCK_BAL_HPQ_RX_BUF_BUSY,
+	MOCK_BAL_HPQ_MAX = MOCK_BAL_HPQ_RX_BUF_BUSY + MAX_NUM_OF_RX_QUEUES
+};
+
+struct mock_bal_stats {
+	unsigned long word_reads;
+	unsigned long word_writes;
+	unsigned long block_reads;
+	unsigned long block_writes;
+	unsigned long dma_maps;
+	unsigned long dma_unmaps;
+	/* Unmaps of an address/length which is not mapped */
+	unsigned long dma_bad_unmaps;
+	unsigned long ps_wakes;
+	unsigned long ps_sleeps;
+	unsigned long ps_status_reads;
+	/* Accesses other than to the sleep controller while the RPU sleeps */
+	unsigned long asleep_accesses;
+};
+
+extern struct mock_bal_stats mock_bal_stats;
+
+/* Virtual time it takes the RPU to report ready after a wake request */
+extern unsigned long mock_bal_ps_wake_latency_us;
+
+/* Make DMA unmaps fail, as a bus error would */
+extern bool mock_bal_dma_unmap_fail;
+
+/* Called on every word write, after it has been applied */
+extern void (*mock_bal_write_hook)(unsigned long addr_offset, unsigned int val);
+
+/* Clear the RPU memory, the HPQs, the DMA mappings and the stats */
+void mock_bal_reset(void);
+
+/* Offset of an RPU address on the bus */
+unsigned long mock_bal_rpu_offset(unsigned int rpu_addr);
+
+/* Access RPU memory behind the back of the HAL, not counted */
+unsigned int mock_bal_rpu_read(unsigned int rpu_addr);
+void mock_bal_rpu_write(unsigned int rpu_addr, unsigned int val);
+
+/* Number of bus reads/writes of the word at rpu_addr since the last reset */
+unsigned long mock_bal_rpu_read_count(unsigned int rpu_addr);
+unsigned long mock_bal_rpu_write_count(unsigned int rpu_addr);
+
+/* Play the RPU side of a HPQ */
+void mock_bal_hpq_push(enum mock_bal_hpq hpq, unsigned int val);
+unsigned int mock_bal_hpq_pop(enum mock_bal_hpq hpq);
+unsigned int mock_bal_hpq_len(enum mock_bal_hpq hpq);
+const struct host_rpu_hpq *mock_bal_hpq_regs(enum mock_bal_hpq hpq);
+
+bool mock_bal_rpu_awake(void);
+
+/* Raise the RPU interrupt, runs the HAL interrupt handler */
+enum nrf_wifi_status mock_bal_irq(void);
+
+/* Number of DMA mappings currently held */
+unsigned int mock_bal_dma_mapped(void);
+
+/* Play a DMA write of the RPU to a bus address, fails if the range is not
+ * within a single mapping.
+ */
+bool mock_bal_dma_write(unsigned long phy_addr, const void *data, size_t len);
+
+/* Bring up a HAL device on the simulated RPU, as far as the firmware
+ * having booted (nrf_wifi_hal_dev_init). The RPU offers num_cmd_bufs
+ * command buffers on the command available queue (on the free command
+ * ring, at most HOST_RPU_CMD_BUFFERS, with SOFT_HPQM).
+ */
+struct nrf_wifi_hal_dev_ctx *
+mock_bal_hal_dev_add(void *mac_dev_ctx,
+		     enum nrf_wifi_status (*intr_callbk_fn)(void *mac_dev_ctx,
+							    void *event_data,
+							    unsigned int len),
+		     unsigned int num_cmd_bufs);
+
+void mock_bal_hal_dev_rem(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx);
+
+#endif /* __MOCK_BAL_H__ */
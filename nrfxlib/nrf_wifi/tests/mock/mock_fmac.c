@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief FMAC device fixture for the data path tests.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "fmac_api.h"
+#include "fmac_rx.h"
+#include "fmac_structs.h"
+#include "fmac_tx.h"
+#include "fmac_util.h"
+#include "host_rpu_data_if.h"
+#include "mock_fmac.h"
+
+struct mock_fmac_stats mock_fmac_stats;
+
+
+static void mock_fmac_tx_flow_ctrl(void *os_vif_ctx,
+				   unsigned int ac,
+				   bool stop)
+{
+	if (stop) {
+		mock_fmac_stats.txq_stops[ac]++;
+	} else {
+		mock_fmac_stats.txq_wakes[ac]++;
+	}
+
+	mock_fmac_stats.txq_stopped[ac] = stop;
+}
+
+
+static void mock_fmac_tx_done(void *os_vif_ctx,
+			      unsigned int ac,
+			      unsigned int pkts,
+			      unsigned int bytes)
+{
+	__atomic_fetch_add(&mock_fmac_stats.tx_done_pkts[ac], pkts, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&mock_fmac_stats.tx_done_bytes[ac], bytes, __ATOMIC_RELAXED);
+}
+
+
+static void mock_fmac_rx_frm(void *os_vif_ctx, void *frm)
+{
+	struct nrf_wifi_fmac_vif_ctx *vif_ctx = os_vif_ctx;
+
+	mock_fmac_stats.rx_frms++;
+
+	nrf_wifi_osal_nbuf_free(vif_ctx->fmac_dev_ctx->fpriv->opriv, frm);
+}
+
+
+static void mock_fmac_rssi(void *os_vif_ctx, signed short signal)
+{
+}
+
+
+#ifdef CMD_RX_BUFF
+enum nrf_wifi_status nrf_wifi_fmac_prog_rx_buf_info(void *dev_ctx,
+						    struct nrf_wifi_rx_buf *rx_buf,
+						    unsigned int num_buffs)
+{
+	unsigned int i = 0;
+
+	for (i = 0; i < num_buffs; i++) {
+		if (!rx_buf[i].skb_pointer) {
+			return NRF_WIFI_STATUS_FAIL;
+		}
+	}
+
+	mock_fmac_stats.rx_prog_cmds++;
+	mock_fmac_stats.rx_prog_bufs += num_buffs;
+
+	return NRF_WIFI_STATUS_SUCCESS;
+}
+#endif /* CMD_RX_BUFF */
+
+
+struct nrf_wifi_fmac_dev_ctx *mock_fmac_dev_add(void)
+{
+	struct nrf_wifi_osal_priv *opriv = NULL;
+	struct nrf_wifi_fmac_priv *fpriv = NULL;
+	struct nrf_wifi_fmac_priv_def *def_priv = NULL;
+	struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx = NULL;
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+	unsigned int size = 0;
+
+	memset(&mock_fmac_stats, 0, sizeof(mock_fmac_stats));
+
+	opriv = nrf_wifi_osal_init();
+
+	if (!opriv) {
+		return NULL;
+	}
+
+	fpriv = calloc(1, sizeof(*fpriv) + sizeof(*def_priv));
+	fpriv->opriv = opriv;
+
+	def_priv = wifi_fmac_priv(fpriv);
+
+	def_priv->callbk_fns.tx_flow_ctrl_callbk_fn = mock_fmac_tx_flow_ctrl;
+	def_priv->callbk_fns.tx_done_callbk_fn = mock_fmac_tx_done;
+	def_priv->callbk_fns.rx_frm_callbk_fn = mock_fmac_rx_frm;
+	def_priv->callbk_fns.process_rssi_from_rx = mock_fmac_rssi;
+
+	def_priv->data_config.max_tx_aggregation = CONFIG_NRF700X_MAX_TX_AGGREGATION;
+	def_priv->num_tx_tokens = CONFIG_NRF700X_MAX_TX_TOKENS;
+	def_priv->num_tx_tokens_per_ac = (def_priv->num_tx_tokens / NRF_WIFI_FMAC_AC_MAX);
+	def_priv->num_tx_tokens_spare = (def_priv->num_tx_tokens % NRF_WIFI_FMAC_AC_MAX);
+	/* Normally reported by the firmware, large enough to never limit */
+	def_priv->avail_ampdu_len_per_token = 0x10000;
+
+	fmac_dev_ctx = calloc(1, sizeof(*fmac_dev_ctx) + sizeof(*def_dev_ctx));
+	fmac_dev_ctx->fpriv = fpriv;
+	fmac_dev_ctx->fw_init_done = true;
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	size = (def_priv->num_tx_tokens *
+		def_priv->data_config.max_tx_aggregation *
+		sizeof(struct nrf_wifi_fmac_buf_map_info));
+
+	def_dev_ctx->tx_buf_info = calloc(1, size);
+
+	if (tx_init(fmac_dev_ctx) != NRF_WIFI_STATUS_SUCCESS) {
+		free(def_dev_ctx->tx_buf_info);
+		free(fmac_dev_ctx);
+		free(fpriv);
+		nrf_wifi_osal_deinit(opriv);
+		return NULL;
+	}
+
+	return fmac_dev_ctx;
+}
+
+
+void mock_fmac_dev_rem(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	struct nrf_wifi_fmac_priv *fpriv = fmac_dev_ctx->fpriv;
+	struct nrf_wifi_fmac_priv_def *def_priv = NULL;
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+	struct nrf_wifi_osal_priv *opriv = fpriv->opriv;
+	int i = 0;
+
+	def_priv = wifi_fmac_priv(fpriv);
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	if (def_dev_ctx->rx_buf_info) {
+		for (i = 0; i < def_priv->num_rx_bufs; i++) {
+			if (def_dev_ctx->rx_buf_info[i].mapped) {
+				nrf_wifi_fmac_rx_cmd_send(fmac_dev_ctx,
+							  NRF_WIFI_FMAC_RX_CMD_TYPE_DEINIT,
+							  i);
+			}
+		}
+
+		free(def_dev_ctx->rx_buf_info);
+		nrf_wifi_fmac_rx_buf_cache_deinit(fmac_dev_ctx);
+	}
+
+	tx_deinit(fmac_dev_ctx);
+
+	for (i = 0; i < MAX_NUM_VIFS; i++) {
+		free(def_dev_ctx->vif_ctx[i]);
+	}
+
+	free(def_dev_ctx->tx_buf_info);
+	free(fmac_dev_ctx);
+	free(fpriv);
+	nrf_wifi_osal_deinit(opriv);
+}
+
+
+enum nrf_wifi_status mock_fmac_rx_add(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+				      unsigned int num_bufs,
+				      unsigned int buf_sz)
+{
+	struct nrf_wifi_fmac_priv_def *def_priv = NULL;
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	unsigned int pool_id = 0;
+	unsigned int desc_id = 0;
+
+	def_priv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	memset(def_priv->rx_buf_pools, 0, sizeof(def_priv->rx_buf_pools));
+	def_priv->rx_buf_pools[0].num_bufs = num_bufs;
+	def_priv->rx_buf_pools[0].buf_sz = buf_sz;
+
+	for (pool_id = 0; pool_id < MAX_NUM_OF_RX_QUEUES; pool_id++) {
+		def_priv->rx_desc[pool_id] = desc_id;
+		desc_id += def_priv->rx_buf_pools[pool_id].num_bufs;
+	}
+
+	def_priv->num_rx_bufs = desc_id;
+
+	def_dev_ctx->rx_buf_info = calloc(def_priv->num_rx_bufs,
+					  sizeof(*def_dev_ctx->rx_buf_info));
+
+	status = nrf_wifi_fmac_rx_buf_cache_init(fmac_dev_ctx);
+
+	for (desc_id = 0;
+	     (status == NRF_WIFI_STATUS_SUCCESS) && (desc_id < def_priv->num_rx_bufs);
+	     desc_id++) {
+		status = nrf_wifi_fmac_rx_cmd_send(fmac_dev_ctx,
+						   NRF_WIFI_FMAC_RX_CMD_TYPE_INIT,
+						   desc_id);
+	}
+
+	return status;
+}
+
+
+enum nrf_wifi_status mock_fmac_rx_event(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+					unsigned char if_idx,
+					int pkt_type,
+					const unsigned int *descs,
+					unsigned int num_descs,
+					unsigned int len)
+{
+	struct nrf_wifi_rx_buff *config = NULL;
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	unsigned int i = 0;
+
+	config = calloc(1, sizeof(*config) + (num_descs * sizeof(config->rx_buff_info[0])));
+
+	config->rx_pkt_type = pkt_type;
+	config->wdev_id = if_idx;
+	config->rx_pkt_cnt = num_descs;
+
+	for (i = 0; i < num_descs; i++) {
+		config->rx_buff_info[i].descriptor_id = descs[i];
+		config->rx_buff_info[i].rx_pkt_len = len;
+		config->rx_buff_info[i].pkt_type = PKT_TYPE_MPDU;
+	}
+
+	status = nrf_wifi_fmac_rx_event_process(fmac_dev_ctx, config);
+
+	free(config);
+
+	return status;
+}
+
+
+struct nrf_wifi_fmac_vif_ctx *mock_fmac_vif_add(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+						unsigned char if_idx,
+						int if_type,
+						const unsigned char *bssid)
+{
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+	struct nrf_wifi_fmac_vif_ctx *vif_ctx = NULL;
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	vif_ctx = calloc(1, sizeof(*vif_ctx));
+	vif_ctx->fmac_dev_ctx = fmac_dev_ctx;
+	vif_ctx->os_vif_ctx = vif_ctx;
+	vif_ctx->if_type = if_type;
+
+	if (bssid) {
+		memcpy(vif_ctx->bssid, bssid, NRF_WIFI_ETH_ADDR_LEN);
+	}
+
+	mock_fmac_mac_addr((unsigned char *)vif_ctx->mac_addr, 0xff00 + if_idx);
+
+	def_dev_ctx->vif_ctx[if_idx] = vif_ctx;
+
+	return vif_ctx;
+}
+
+
+void mock_fmac_mac_addr(unsigned char *mac_addr, unsigned int idx)
+{
+	mac_addr[0] = 0x02;
+	mac_addr[1] = 0x00;
+	mac_addr[2] = 0x5e;
+	mac_addr[3] = (idx >> 16) & 0xff;
+	mac_addr[4] = (idx >> 8) & 0xff;
+	mac_addr[5] = idx & 0xff;
+}
+
+
+void *mock_fmac_frame(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+		      const unsigned char *da,
+		      unsigned int ac,
+		      unsigned int len)
+{
+	/* Lowest user priority mapping to each AC, see map_ac_from_tid() */
+	static const unsigned char ac_to_up[NRF_WIFI_FMAC_AC_MAX] = {
+		[NRF_WIFI_FMAC_AC_BK] = 1,
+		[NRF_WIFI_FMAC_AC_BE] = 0,
+		[NRF_WIFI_FMAC_AC_VI] = 5,
+		[NRF_WIFI_FMAC_AC_VO] = 6,
+		[NRF_WIFI_FMAC_AC_MC] = 0,
+	};
+	struct nrf_wifi_osal_priv *opriv = fmac_dev_ctx->fpriv->opriv;
+	unsigned char *data = NULL;
+	void *nbuf = NULL;
+
+	if (len < NRF_WIFI_FMAC_ETH_HDR_LEN + 2) {
+		len = NRF_WIFI_FMAC_ETH_HDR_LEN + 2;
+	}
+
+	nbuf = nrf_wifi_osal_nbuf_alloc(opriv, len + TX_BUF_HEADROOM);
+	nrf_wifi_osal_nbuf_headroom_res(opriv, nbuf, TX_BUF_HEADROOM);
+	data = nrf_wifi_osal_nbuf_data_put(opriv, nbuf, len);
+
+	memset(data, 0, len);
+	memcpy(data, da, NRF_WIFI_ETH_ADDR_LEN);
+	mock_fmac_mac_addr(data + NRF_WIFI_ETH_ADDR_LEN, 0xfe00);
+	/* IPv4 with the TOS carrying the user priority */
+	data[12] = 0x08;
+	data[13] = 0x00;
+	data[NRF_WIFI_FMAC_ETH_HDR_LEN] = 0x45;
+	data[NRF_WIFI_FMAC_ETH_HDR_LEN + 1] = ac_to_up[ac] << 5;
+
+	return nbuf;
+}
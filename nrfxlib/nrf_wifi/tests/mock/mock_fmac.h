@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief FMAC device fixture for the data path tests.
+ *
+ * Sets up an FMAC device context with the TX path initialized, as
+ * nrf_wifi_fmac_init() and nrf_wifi_fmac_dev_add() would, but without a
+ * HAL underneath (see mock_hal.h). The RX path is brought up on request.
+ */
+
+#ifndef __MOCK_FMAC_H__
+#define __MOCK_FMAC_H__
+
+#include "fmac_structs.h"
+
+struct mock_fmac_stats {
+	unsigned long tx_done_pkts[NRF_WIFI_FMAC_AC_MAX];
+	unsigned long tx_done_bytes[NRF_WIFI_FMAC_AC_MAX];
+	unsigned long txq_stops[NRF_WIFI_FMAC_AC_MAX];
+	unsigned long txq_wakes[NRF_WIFI_FMAC_AC_MAX];
+	bool txq_stopped[NRF_WIFI_FMAC_AC_MAX];
+	unsigned long rx_frms;
+	/* RX buffer programming commands to the UMAC, and the buffers in them */
+	unsigned long rx_prog_cmds;
+	unsigned long rx_prog_bufs;
+};
+
+extern struct mock_fmac_stats mock_fmac_stats;
+
+struct nrf_wifi_fmac_dev_ctx *mock_fmac_dev_add(void);
+void mock_fmac_dev_rem(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx);
+
+/* Add a VIF at if_idx, bssid is only used for a STA */
+struct nrf_wifi_fmac_vif_ctx *mock_fmac_vif_add(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+						unsigned char if_idx,
+						int if_type,
+						const unsigned char *bssid);
+
+/* Bring up the RX path with num_bufs buffers of buf_sz in the first pool
+ * and every desc armed, as nrf_wifi_fmac_dev_init() would. Torn down by
+ * mock_fmac_dev_rem().
+ */
+enum nrf_wifi_status mock_fmac_rx_add(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+				      unsigned int num_bufs,
+				      unsigned int buf_sz);
+
+/* Play an RX event of the RPU reporting a frame of len in each of descs */
+enum nrf_wifi_status mock_fmac_rx_event(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+					unsigned char if_idx,
+					int pkt_type,
+					const unsigned int *descs,
+					unsigned int num_descs,
+					unsigned int len);
+
+/* Build an IPv4 frame with the TOS mapping to the given AC */
+void *mock_fmac_frame(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+		      const unsigned char *da,
+		      unsigned int ac,
+		      unsigned int len);
+
+/* Fill mac_addr with a locally administered address derived from idx */
+void mock_fmac_mac_addr(unsigned char *mac_addr, unsigned int idx);
+
+#endif /* __MOCK_FMAC_H__ */
@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief Stand-in for the HAL functions used by the FMAC data path.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hal_api.h"
+#include "hal_mem.h"
+#include "fmac_structs.h"
+#include "fmac_cmd.h"
+#include "fmac_tx.h"
+#include "mock_hal.h"
+
+#define MOCK_HAL_TX_RING_SZ 256
+#define MOCK_HAL_TX_BUFS 1024
+#define MOCK_HAL_MEM_BYTES 64
+#define MOCK_HAL_RX_BUFS_PER_POOL 64
+/* Bus address of the RX buffer buf_id of pool_id */
+#define MOCK_HAL_RX_DMA_ADDR(pool_id, buf_id) (0x80000000UL | ((pool_id) << 16) | ((buf_id) << 4))
+
+struct mock_hal_stats mock_hal_stats;
+
+bool mock_hal_unmap_tx_fail;
+
+static unsigned int tx_ring[MOCK_HAL_TX_RING_SZ];
+static unsigned int tx_ring_head;
+static unsigned int tx_ring_tail;
+static unsigned long tx_bufs[MOCK_HAL_TX_BUFS];
+static unsigned long rx_bufs[MAX_NUM_OF_RX_QUEUES][MOCK_HAL_RX_BUFS_PER_POOL];
+/* Last value of the bytes written to RPU memory */
+static struct {
+	unsigned int addr;
+	unsigned char val;
+} mem_bytes[MOCK_HAL_MEM_BYTES];
+static unsigned int num_mem_bytes;
+static pthread_mutex_t mock_hal_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+
+void mock_hal_reset(void)
+{
+	pthread_mutex_lock(&mock_hal_mutex);
+
+	memset(&mock_hal_stats, 0, sizeof(mock_hal_stats));
+	memset(tx_bufs, 0, sizeof(tx_bufs));
+	memset(rx_bufs, 0, sizeof(rx_bufs));
+	num_mem_bytes = 0;
+	tx_ring_head = 0;
+	tx_ring_tail = 0;
+	mock_hal_unmap_tx_fail = false;
+
+	pthread_mutex_unlock(&mock_hal_mutex);
+}
+
+
+unsigned int mock_hal_tx_pending(void)
+{
+	unsigned int pending = 0;
+
+	pthread_mutex_lock(&mock_hal_mutex);
+	pending = tx_ring_tail - tx_ring_head;
+	pthread_mutex_unlock(&mock_hal_mutex);
+
+	return pending;
+}
+
+
+int mock_hal_tx_next(void)
+{
+	int desc = -1;
+
+	pthread_mutex_lock(&mock_hal_mutex);
+
+	if (tx_ring_head != tx_ring_tail) {
+		desc = tx_ring[tx_ring_head % MOCK_HAL_TX_RING_SZ];
+	}
+
+	pthread_mutex_unlock(&mock_hal_mutex);
+
+	return desc;
+}
+
+
+int mock_hal_tx_done(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
+{
+	struct nrf_wifi_tx_buff_done config;
+	int desc = -1;
+
+	pthread_mutex_lock(&mock_hal_mutex);
+
+	if (tx_ring_head != tx_ring_tail) {
+		desc = tx_ring[tx_ring_head++ % MOCK_HAL_TX_RING_SZ];
+	}
+
+	pthread_mutex_unlock(&mock_hal_mutex);
+
+	if (desc == -1) {
+		return -1;
+	}
+
+	memset(&config, 0, sizeof(config));
+	config.umac_head.cmd = NRF_WIFI_CMD_TX_BUFF_DONE;
+	config.tx_desc_num = desc;
+
+	nrf_wifi_fmac_tx_done_event_process(fmac_dev_ctx, &config);
+
+	return desc;
+}
+
+
+enum nrf_wifi_status nrf_wifi_hal_data_cmd_send(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
+						enum NRF_WIFI_HAL_MSG_TYPE cmd_type,
+						void *cmd,
+						unsigned int cmd_size,
+						unsigned int desc_id,
+						unsigned int pool_id,
+						bool batch)
+{
+	struct host_rpu_msg *umac_cmd = cmd;
+	struct nrf_wifi_tx_buff *config = NULL;
+
+	if (cmd_type != NRF_WIFI_HAL_MSG_TYPE_CMD_DATA_TX) {
+		return NRF_WIFI_STATUS_SUCCESS;
+	}
+
+	config = (struct nrf_wifi_tx_buff *)umac_cmd->msg;
+
+	pthread_mutex_lock(&mock_hal_mutex);
+
+	if ((tx_ring_tail - tx_ring_head) == MOCK_HAL_TX_RING_SZ) {
+		fprintf(stderr, "%s: TX ring full\n", __func__);
+		abort();
+	}
+
+	tx_ring[tx_ring_tail++ % MOCK_HAL_TX_RING_SZ] = desc_id;
+	mock_hal_stats.data_cmds++;
+	mock_hal_stats.data_cmd_frames += config->num_tx_pkts;
+
+	pthread_mutex_unlock(&mock_hal_mutex);
+
+	return NRF_WIFI_STATUS_SUCCESS;
+}
+
+
+unsigned long nrf_wifi_hal_buf_map_tx(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
+				      unsigned long buf,
+				      unsigned int buf_len,
+				      unsigned int desc_id,
+				      unsigned int token,
+				      unsigned int buf_indx)
+{
+	unsigned long phy_addr = 0;
+
+	pthread_mutex_lock(&mock_hal_mutex);
+
+	if ((desc_id < MOCK_HAL_TX_BUFS) && !tx_bufs[desc_id]) {
+		tx_bufs[desc_id] = buf;
+		phy_addr = buf;
+		mock_hal_stats.buf_maps++;
+	}
+
+	pthread_mutex_unlock(&mock_hal_mutex);
+
+	return phy_addr;
+}
+
+
+unsigned long nrf_wifi_hal_buf_unmap_tx(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
+					unsigned int desc_id)
+{
+	unsigned long virt_addr = 0;
+
+	pthread_mutex_lock(&mock_hal_mutex);
+
+	if (desc_id < MOCK_HAL_TX_BUFS) {
+		virt_addr = tx_bufs[desc_id];
+		tx_bufs[desc_id] = 0;
+		mock_hal_stats.buf_unmaps++;
+	}
+
+	pthread_mutex_unlock(&mock_hal_mutex);
+
+	return mock_hal_unmap_tx_fail ? 0 : virt_addr;
+}
+
+
+unsigned long nrf_wifi_hal_buf_map_rx(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
+				      unsigned long buf,
+				      unsigned int buf_len,
+				      unsigned int pool_id,
+				      unsigned int buf_id)
+{
+	unsigned long phy_addr = 0;
+
+	pthread_mutex_lock(&mock_hal_mutex);
+
+	if ((pool_id < MAX_NUM_OF_RX_QUEUES) &&
+	    (buf_id < MOCK_HAL_RX_BUFS_PER_POOL) &&
+	    !rx_bufs[pool_id][buf_id]) {
+		rx_bufs[pool_id][buf_id] = buf;
+		phy_addr = MOCK_HAL_RX_DMA_ADDR(pool_id, buf_id);
+		mock_hal_stats.rx_buf_maps++;
+	}
+
+	pthread_mutex_unlock(&mock_hal_mutex);
+
+	return phy_addr;
+}
+
+
+unsigned long nrf_wifi_hal_buf_unmap_rx(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
+					unsigned int data_len,
+					unsigned int pool_id,
+					unsigned int buf_id)
+{
+	unsigned long virt_addr = 0;
+
+	pthread_mutex_lock(&mock_hal_mutex);
+
+	if ((pool_id < MAX_NUM_OF_RX_QUEUES) &&
+	    (buf_id < MOCK_HAL_RX_BUFS_PER_POOL)) {
+		virt_addr = rx_bufs[pool_id][buf_id];
+		rx_bufs[pool_id][buf_id] = 0;
+		mock_hal_stats.rx_buf_unmaps++;
+	}
+
+	pthread_mutex_unlock(&mock_hal_mutex);
+
+	return virt_addr;
+}
+
+
+#ifdef CMD_RX_BUFF
+unsigned long nrf_wifi_hal_get_buf_map_rx(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
+					  unsigned int pool_id,
+					  unsigned int buf_id)
+{
+	unsigned long phy_addr = 0;
+
+	pthread_mutex_lock(&mock_hal_mutex);
+
+	if ((pool_id < MAX_NUM_OF_RX_QUEUES) &&
+	    (buf_id < MOCK_HAL_RX_BUFS_PER_POOL) &&
+	    rx_bufs[pool_id][buf_id]) {
+		phy_addr = MOCK_HAL_RX_DMA_ADDR(pool_id, buf_id);
+	}
+
+	pthread_mutex_unlock(&mock_hal_mutex);
+
+	return phy_addr;
+}
+#endif /* CMD_RX_BUFF */
+
+
+enum nrf_wifi_status hal_rpu_mem_write(struct nrf_wifi_hal_dev_ctx *hal_dev_ctx,
+				       unsigned int rpu_mem_addr,
+				       void *host_addr,
+				       unsigned int len)
+{
+	unsigned char val = *(unsigned char *)host_addr;
+	unsigned int i = 0;
+
+	pthread_mutex_lock(&mock_hal_mutex);
+
+	mock_hal_stats.mem_writes++;
+	mock_hal_stats.last_mem_write_addr = rpu_mem_addr;
+	mock_hal_stats.last_mem_write_val = val;
+
+	if (len == 1) {
+		for (i = 0; i < num_mem_bytes; i++) {
+			if (mem_bytes[i].addr == rpu_mem_addr) {
+				break;
+			}
+		}
+
+		if (i < num_mem_bytes) {
+			if (mem_bytes[i].val == val) {
+				mock_hal_stats.redundant_mem_writes++;
+			}
+		} else if (num_mem_bytes < MOCK_HAL_MEM_BYTES) {
+			mem_bytes[num_mem_bytes++].addr = rpu_mem_addr;
+		}
+
+		mem_bytes[i].val = val;
+	}
+
+	pthread_mutex_unlock(&mock_hal_mutex);
+
+	return NRF_WIFI_STATUS_SUCCESS;
+}
+
+
+struct host_rpu_msg *umac_cmd_alloc(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+				    int type,
+				    int size)
+{
+	struct host_rpu_msg *umac_cmd = NULL;
+
+	umac_cmd = calloc(1, sizeof(*umac_cmd) + size);
+
+	if (umac_cmd) {
+		umac_cmd->type = type;
+		umac_cmd->hdr.len = sizeof(*umac_cmd) + size;
+	}
+
+	return umac_cmd;
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief Stand-in for the HAL functions used by the FMAC data path.
+ *
+ * TX commands are not sent anywhere, the descriptors they were posted for
+ * are kept in FIFO order so that a test can complete them (play the RPU)
+ * with mock_hal_tx_done(). RX buffers are "mapped" at their host address.
+ */
+
+#ifndef __MOCK_HAL_H__
+#define __MOCK_HAL_H__
+
+#include <stdbool.h>
+#include "fmac_structs.h"
+
+struct mock_hal_stats {
+	unsigned long data_cmds;
+	unsigned long data_cmd_frames;
+	unsigned long mem_writes;
+	/* Address and first byte of the last RPU memory write */
+	unsigned int last_mem_write_addr;
+	unsigned char last_mem_write_val;
+	/* Single byte writes of the value already in RPU memory */
+	unsigned long redundant_mem_writes;
+	unsigned long buf_maps;
+	unsigned long buf_unmaps;
+	unsigned long rx_buf_maps;
+	unsigned long rx_buf_unmaps;
+};
+
+extern struct mock_hal_stats mock_hal_stats;
+
+/* Make nrf_wifi_hal_buf_unmap_tx fail */
+extern bool mock_hal_unmap_tx_fail;
+
+void mock_hal_reset(void);
+
+/* Number of TX descriptors posted and not yet completed */
+unsigned int mock_hal_tx_pending(void);
+
+/* Oldest posted TX descriptor not yet completed, -1 if there is none */
+int mock_hal_tx_next(void);
+
+/* Complete the oldest posted TX descriptor, returns -1 if there is none */
+int mock_hal_tx_done(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx);
+
+#endif /* __MOCK_HAL_H__ */
@@ -0,0 +1,1062 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief Host implementation of the OSAL ops used by the unit tests.
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "osal_ops.h"
+#include "mock_osal.h"
+
+#define MOCK_LOCKS_MAX 256
+#define MOCK_LOCKS_HELD_MAX 16
+#define MOCK_TASKLETS_MAX 32
+#define MOCK_TIMERS_MAX 32
+
+#define MOCK_STAT_INC(stat, val) __atomic_fetch_add(&mock_osal_stats.stat, (val), __ATOMIC_RELAXED)
+
+struct mock_osal_stats mock_osal_stats;
+
+void (*mock_osal_delay_hook)(int usecs);
+
+void (*mock_osal_preempt_hook)(void);
+static __thread bool in_preempt_hook;
+
+static unsigned long mock_time_us;
+
+static bool mock_log_verbose;
+
+
+struct mock_lock {
+	pthread_mutex_t mutex;
+	unsigned int id;
+};
+
+/* lock_after[a][b] is set once lock b has been taken with lock a held */
+static unsigned char lock_after[MOCK_LOCKS_MAX][MOCK_LOCKS_MAX];
+static bool lock_id_used[MOCK_LOCKS_MAX];
+static pthread_mutex_t lock_graph_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static __thread struct mock_lock *locks_held[MOCK_LOCKS_HELD_MAX];
+static __thread unsigned int num_locks_held;
+
+
+struct mock_tasklet {
+	void (*callback)(unsigned long);
+	unsigned long data;
+	bool scheduled;
+};
+
+static struct mock_tasklet *tasklets[MOCK_TASKLETS_MAX];
+static pthread_mutex_t tasklets_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+
+struct mock_timer {
+	void (*callback)(unsigned long);
+	unsigned long data;
+	unsigned long expires_us;
+	bool armed;
+};
+
+static struct mock_timer *timers[MOCK_TIMERS_MAX];
+static pthread_mutex_t timers_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+
+struct mock_llist_node {
+	struct mock_llist_node *next;
+	struct mock_llist_node *prev;
+	void *data;
+};
+
+struct mock_llist {
+	struct mock_llist_node head;
+	unsigned int len;
+};
+
+
+struct mock_nbuf {
+	unsigned char *head;
+	unsigned char *data;
+	unsigned int size;
+	unsigned int len;
+	unsigned char priority;
+};
+
+
+void mock_osal_stats_reset(void)
+{
+	memset(&mock_osal_stats, 0, sizeof(mock_osal_stats));
+}
+
+
+int mock_osal_printk(const char *fmt, ...)
+{
+	va_list args;
+	int ret = 0;
+
+	if (!mock_log_verbose) {
+		return 0;
+	}
+
+	va_start(args, fmt);
+	ret = vfprintf(stderr, fmt, args);
+	va_end(args);
+
+	return ret;
+}
+
+
+unsigned long mock_osal_time_us(void)
+{
+	return __atomic_load_n(&mock_time_us, __ATOMIC_RELAXED);
+}
+
+
+static void *mock_mem_alloc(size_t size)
+{
+	MOCK_STAT_INC(mem_allocs, 1);
+
+	return malloc(size);
+}
+
+
+static void *mock_mem_zalloc(size_t size)
+{
+	MOCK_STAT_INC(mem_allocs, 1);
+
+	return calloc(1, size);
+}
+
+
+static void mock_mem_free(void *buf)
+{
+	free(buf);
+}
+
+
+static void mock_preempt(void)
+{
+	if (!mock_osal_preempt_hook || in_preempt_hook) {
+		return;
+	}
+
+	in_preempt_hook = true;
+	mock_osal_preempt_hook();
+	in_preempt_hook = false;
+}
+
+
+static void *mock_mem_cpy(void *dest, const void *src, size_t count)
+{
+	memcpy(dest, src, count);
+	mock_preempt();
+
+	return dest;
+}
+
+
+static void *mock_mem_set(void *start, int val, size_t size)
+{
+	memset(start, val, size);
+	mock_preempt();
+
+	return start;
+}
+
+
+static int mock_mem_cmp(const void *addr1, const void *addr2, size_t size)
+{
+	return memcmp(addr1, addr2, size);
+}
+
+
+#ifdef INLINE_RX
+static void *mock_iomem_mmap_inline_rx(unsigned long addr, unsigned long size)
+{
+	return calloc(1, size);
+}
+
+
+static void mock_iomem_unmap_inline_rx(volatile void *addr)
+{
+	free((void *)addr);
+}
+#endif /* INLINE_RX */
+
+
+static void *mock_spinlock_alloc(void)
+{
+	struct mock_lock *lock = NULL;
+	unsigned int id = 0;
+
+	lock = calloc(1, sizeof(*lock));
+
+	if (!lock) {
+		return NULL;
+	}
+
+	pthread_mutex_lock(&lock_graph_mutex);
+
+	for (id = 0; id < MOCK_LOCKS_MAX; id++) {
+		if (!lock_id_used[id]) {
+			break;
+		}
+	}
+
+	if (id == MOCK_LOCKS_MAX) {
+		fprintf(stderr, "%s: Too many locks\n", __func__);
+		abort();
+	}
+
+	lock_id_used[id] = true;
+
+	pthread_mutex_unlock(&lock_graph_mutex);
+
+	lock->id = id;
+
+	return lock;
+}
+
+
+static void mock_spinlock_free(void *lock)
+{
+	struct mock_lock *mock_lock = lock;
+	unsigned int i = 0;
+
+	pthread_mutex_lock(&lock_graph_mutex);
+
+	for (i = 0; i < MOCK_LOCKS_MAX; i++) {
+		lock_after[mock_lock->id][i] = 0;
+		lock_after[i][mock_lock->id] = 0;
+	}
+
+	lock_id_used[mock_lock->id] = false;
+
+	pthread_mutex_unlock(&lock_graph_mutex);
+
+	pthread_mutex_destroy(&mock_lock->mutex);
+	free(mock_lock);
+}
+
+
+static void mock_spinlock_init(void *lock)
+{
+	struct mock_lock *mock_lock = lock;
+	pthread_mutexattr_t attr;
+
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ERRORCHECK);
+	pthread_mutex_init(&mock_lock->mutex, &attr);
+	pthread_mutexattr_destroy(&attr);
+}
+
+
+/* Called with lock_graph_mutex held */
+static bool lock_order_reachable(unsigned int from,
+				 unsigned int to,
+				 unsigned char *visited)
+{
+	unsigned int i = 0;
+
+	if (from == to) {
+		return true;
+	}
+
+	visited[from] = 1;
+
+	for (i = 0; i < MOCK_LOCKS_MAX; i++) {
+		if (lock_after[from][i] && !visited[i] &&
+		    lock_order_reachable(i, to, visited)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+static void lock_order_check(struct mock_lock *lock)
+{
+	unsigned char visited[MOCK_LOCKS_MAX];
+	unsigned int held_id = 0;
+	unsigned int i = 0;
+
+	pthread_mutex_lock(&lock_graph_mutex);
+
+	for (i = 0; i < num_locks_held; i++) {
+		held_id = locks_held[i]->id;
+
+		if (lock_after[held_id][lock->id]) {
+			continue;
+		}
+
+		/* A new nesting, it must not close a cycle */
+		memset(visited, 0, sizeof(visited));
+
+		if (lock_order_reachable(lock->id, held_id, visited)) {
+			fprintf(stderr,
+				"%s: Lock %u taken with lock %u held, the reverse order was seen before\n",
+				__func__,
+				lock->id,
+				held_id);
+			MOCK_STAT_INC(lock_order_violations, 1);
+		}
+
+		lock_after[held_id][lock->id] = 1;
+	}
+
+	pthread_mutex_unlock(&lock_graph_mutex);
+}
+
+
+static void mock_spinlock_take(void *lock)
+{
+	struct mock_lock *mock_lock = lock;
+	int ret = 0;
+
+	lock_order_check(mock_lock);
+
+	ret = pthread_mutex_lock(&mock_lock->mutex);
+
+	if (ret) {
+		fprintf(stderr,
+			"%s: Lock %u: %s\n",
+			__func__,
+			mock_lock->id,
+			(ret == EDEADLK) ? "already held" : strerror(ret));
+		abort();
+	}
+
+	if (num_locks_held == MOCK_LOCKS_HELD_MAX) {
+		fprintf(stderr, "%s: Too many locks held\n", __func__);
+		abort();
+	}
+
+	locks_held[num_locks_held++] = mock_lock;
+}
+
+
+static void mock_spinlock_rel(void *lock)
+{
+	struct mock_lock *mock_lock = lock;
+	unsigned int i = 0;
+
+	for (i = num_locks_held; i > 0; i--) {
+		if (locks_held[i - 1] == mock_lock) {
+			break;
+		}
+	}
+
+	if (i == 0) {
+		fprintf(stderr, "%s: Lock %u is not held\n", __func__, mock_lock->id);
+		abort();
+	}
+
+	for (; i < num_locks_held; i++) {
+		locks_held[i - 1] = locks_held[i];
+	}
+
+	num_locks_held--;
+
+	pthread_mutex_unlock(&mock_lock->mutex);
+
+	mock_preempt();
+}
+
+
+static void mock_spinlock_irq_take(void *lock, unsigned long *flags)
+{
+	mock_spinlock_take(lock);
+}
+
+
+static void mock_spinlock_irq_rel(void *lock, unsigned long *flags)
+{
+	mock_spinlock_rel(lock);
+}
+
+
+static int mock_log_dbg(const char *fmt, va_list args)
+{
+	if (!mock_log_verbose) {
+		return 0;
+	}
+
+	return vfprintf(stderr, fmt, args);
+}
+
+
+static int mock_log_info(const char *fmt, va_list args)
+{
+	if (!mock_log_verbose) {
+		return 0;
+	}
+
+	return vfprintf(stderr, fmt, args);
+}
+
+
+static int mock_log_err(const char *fmt, va_list args)
+{
+	MOCK_STAT_INC(log_errs, 1);
+
+	if (!mock_log_verbose) {
+		return 0;
+	}
+
+	return vfprintf(stderr, fmt, args);
+}
+
+
+static void *mock_llist_node_alloc(void)
+{
+	MOCK_STAT_INC(llist_node_allocs, 1);
+
+	return calloc(1, sizeof(struct mock_llist_node));
+}
+
+
+static void mock_llist_node_free(void *node)
+{
+	MOCK_STAT_INC(llist_node_frees, 1);
+
+	free(node);
+}
+
+
+static void *mock_llist_node_data_get(void *node)
+{
+	return ((struct mock_llist_node *)node)->data;
+}
+
+
+static void mock_llist_node_data_set(void *node, void *data)
+{
+	((struct mock_llist_node *)node)->data = data;
+}
+
+
+static void *mock_llist_alloc(void)
+{
+	return calloc(1, sizeof(struct mock_llist));
+}
+
+
+static void mock_llist_free(void *llist)
+{
+	free(llist);
+}
+
+
+static void mock_llist_init(void *llist)
+{
+	struct mock_llist *mock_llist = llist;
+
+	mock_llist->head.next = &mock_llist->head;
+	mock_llist->head.prev = &mock_llist->head;
+	mock_llist->len = 0;
+}
+
+
+static void mock_llist_add_node_tail(void *llist, void *llist_node)
+{
+	struct mock_llist *mock_llist = llist;
+	struct mock_llist_node *node = llist_node;
+
+	node->next = &mock_llist->head;
+	node->prev = mock_llist->head.prev;
+	mock_llist->head.prev->next = node;
+	mock_llist->head.prev = node;
+	mock_llist->len++;
+}
+
+
+static void mock_llist_add_node_head(void *llist, void *llist_node)
+{
+	struct mock_llist *mock_llist = llist;
+	struct mock_llist_node *node = llist_node;
+
+	node->prev = &mock_llist->head;
+	node->next = mock_llist->head.next;
+	mock_llist->head.next->prev = node;
+	mock_llist->head.next = node;
+	mock_llist->len++;
+}
+
+
+static void *mock_llist_get_node_head(void *llist)
+{
+	struct mock_llist *mock_llist = llist;
+
+	if (!mock_llist->len) {
+		return NULL;
+	}
+
+	return mock_llist->head.next;
+}
+
+
+static void *mock_llist_get_node_nxt(void *llist, void *llist_node)
+{
+	struct mock_llist *mock_llist = llist;
+	struct mock_llist_node *node = llist_node;
+
+	if (node->next == &mock_llist->head) {
+		return NULL;
+	}
+
+	return node->next;
+}
+
+
+static void mock_llist_del_node(void *llist, void *llist_node)
+{
+	struct mock_llist *mock_llist = llist;
+	struct mock_llist_node *node = llist_node;
+
+	node->prev->next = node->next;
+	node->next->prev = node->prev;
+	mock_llist->len--;
+}
+
+
+static unsigned int mock_llist_len(void *llist)
+{
+	return ((struct mock_llist *)llist)->len;
+}
+
+
+static void *mock_nbuf_alloc(unsigned int size)
+{
+	struct mock_nbuf *nbuf = NULL;
+
+	nbuf = calloc(1, sizeof(*nbuf));
+
+	if (!nbuf) {
+		return NULL;
+	}
+
+	nbuf->head = calloc(1, size);
+
+	if (!nbuf->head) {
+		free(nbuf);
+		return NULL;
+	}
+
+	nbuf->data = nbuf->head;
+	nbuf->size = size;
+
+	MOCK_STAT_INC(nbuf_allocs, 1);
+
+	return nbuf;
+}
+
+
+static void mock_nbuf_free(void *nbuf)
+{
+	struct mock_nbuf *mock_nbuf = nbuf;
+
+	MOCK_STAT_INC(nbuf_frees, 1);
+
+	free(mock_nbuf->head);
+	free(mock_nbuf);
+}
+
+
+static void mock_nbuf_reset(void *nbuf)
+{
+	struct mock_nbuf *mock_nbuf = nbuf;
+
+	mock_nbuf->data = mock_nbuf->head;
+	mock_nbuf->len = 0;
+}
+
+
+static void mock_nbuf_headroom_res(void *nbuf, unsigned int size)
+{
+	((struct mock_nbuf *)nbuf)->data += size;
+}
+
+
+static unsigned int mock_nbuf_headroom_get(void *nbuf)
+{
+	struct mock_nbuf *mock_nbuf = nbuf;
+
+	return mock_nbuf->data - mock_nbuf->head;
+}
+
+
+static unsigned int mock_nbuf_data_size(void *nbuf)
+{
+	return ((struct mock_nbuf *)nbuf)->len;
+}
+
+
+static void *mock_nbuf_data_get(void *nbuf)
+{
+	return ((struct mock_nbuf *)nbuf)->data;
+}
+
+
+static void *mock_nbuf_data_put(void *nbuf, unsigned int size)
+{
+	struct mock_nbuf *mock_nbuf = nbuf;
+	void *tail = mock_nbuf->data + mock_nbuf->len;
+
+	if ((mock_nbuf->data - mock_nbuf->head) + mock_nbuf->len + size > mock_nbuf->size) {
+		fprintf(stderr, "%s: Buffer overflow\n", __func__);
+		abort();
+	}
+
+	mock_nbuf->len += size;
+
+	return tail;
+}
+
+
+static void *mock_nbuf_data_push(void *nbuf, unsigned int size)
+{
+	struct mock_nbuf *mock_nbuf = nbuf;
+
+	if ((unsigned int)(mock_nbuf->data - mock_nbuf->head) < size) {
+		fprintf(stderr, "%s: Buffer underflow\n", __func__);
+		abort();
+	}
+
+	mock_nbuf->data -= size;
+	mock_nbuf->len += size;
+
+	return mock_nbuf->data;
+}
+
+
+static void *mock_nbuf_data_pull(void *nbuf, unsigned int size)
+{
+	struct mock_nbuf *mock_nbuf = nbuf;
+
+	if (size > mock_nbuf->len) {
+		return NULL;
+	}
+
+	mock_nbuf->data += size;
+	mock_nbuf->len -= size;
+
+	return mock_nbuf->data;
+}
+
+
+static unsigned char mock_nbuf_get_priority(void *nbuf)
+{
+	return ((struct mock_nbuf *)nbuf)->priority;
+}
+
+
+void mock_osal_nbuf_priority_set(void *nbuf, unsigned char priority)
+{
+	((struct mock_nbuf *)nbuf)->priority = priority;
+}
+
+
+static void *mock_tasklet_alloc(int type)
+{
+	struct mock_tasklet *tasklet = NULL;
+	unsigned int i = 0;
+
+	tasklet = calloc(1, sizeof(*tasklet));
+
+	if (!tasklet) {
+		return NULL;
+	}
+
+	pthread_mutex_lock(&tasklets_mutex);
+
+	for (i = 0; i < MOCK_TASKLETS_MAX; i++) {
+		if (!tasklets[i]) {
+			tasklets[i] = tasklet;
+			break;
+		}
+	}
+
+	pthread_mutex_unlock(&tasklets_mutex);
+
+	if (i == MOCK_TASKLETS_MAX) {
+		free(tasklet);
+		return NULL;
+	}
+
+	return tasklet;
+}
+
+
+static void mock_tasklet_free(void *tasklet)
+{
+	unsigned int i = 0;
+
+	pthread_mutex_lock(&tasklets_mutex);
+
+	for (i = 0; i < MOCK_TASKLETS_MAX; i++) {
+		if (tasklets[i] == tasklet) {
+			tasklets[i] = NULL;
+		}
+	}
+
+	pthread_mutex_unlock(&tasklets_mutex);
+
+	free(tasklet);
+}
+
+
+static void mock_tasklet_init(void *tasklet,
+			      void (*callback)(unsigned long),
+			      unsigned long data)
+{
+	struct mock_tasklet *mock_tasklet = tasklet;
+
+	mock_tasklet->callback = callback;
+	mock_tasklet->data = data;
+	mock_tasklet->scheduled = false;
+}
+
+
+static void mock_tasklet_schedule(void *tasklet)
+{
+	MOCK_STAT_INC(tasklet_schedules, 1);
+
+	pthread_mutex_lock(&tasklets_mutex);
+	((struct mock_tasklet *)tasklet)->scheduled = true;
+	pthread_mutex_unlock(&tasklets_mutex);
+}
+
+
+static void mock_tasklet_kill(void *tasklet)
+{
+	pthread_mutex_lock(&tasklets_mutex);
+	((struct mock_tasklet *)tasklet)->scheduled = false;
+	pthread_mutex_unlock(&tasklets_mutex);
+}
+
+
+unsigned int mock_osal_tasklets_run(void)
+{
+	struct mock_tasklet *tasklet = NULL;
+	unsigned int num_run = 0;
+	unsigned int i = 0;
+
+	do {
+		tasklet = NULL;
+
+		pthread_mutex_lock(&tasklets_mutex);
+
+		for (i = 0; i < MOCK_TASKLETS_MAX; i++) {
+			if (tasklets[i] && tasklets[i]->scheduled) {
+				tasklet = tasklets[i];
+				tasklet->scheduled = false;
+				break;
+			}
+		}
+
+		pthread_mutex_unlock(&tasklets_mutex);
+
+		if (tasklet) {
+			tasklet->callback(tasklet->data);
+			num_run++;
+		}
+	} while (tasklet);
+
+	return num_run;
+}
+
+
+static int mock_sleep_ms(int msecs)
+{
+	MOCK_STAT_INC(sleep_ms_calls, 1);
+
+	__atomic_fetch_add(&mock_time_us, (unsigned long)msecs * 1000, __ATOMIC_RELAXED);
+
+	return 0;
+}
+
+
+static int mock_delay_us(int usecs)
+{
+	MOCK_STAT_INC(delay_us_calls, 1);
+	MOCK_STAT_INC(delay_us_total, usecs);
+
+	__atomic_fetch_add(&mock_time_us, (unsigned long)usecs, __ATOMIC_RELAXED);
+
+	if (mock_osal_delay_hook) {
+		mock_osal_delay_hook(usecs);
+	}
+
+	return 0;
+}
+
+
+static unsigned long mock_time_get_curr_us(void)
+{
+	return mock_osal_time_us();
+}
+
+
+static unsigned int mock_time_elapsed_us(unsigned long start_time_us)
+{
+	return mock_osal_time_us() - start_time_us;
+}
+
+
+#if defined(CONFIG_NRF_WIFI_LOW_POWER) || defined(HAL_CMD_ASYNC)
+static void *mock_timer_alloc(void)
+{
+	struct mock_timer *timer = NULL;
+	unsigned int i = 0;
+
+	timer = calloc(1, sizeof(*timer));
+
+	if (!timer) {
+		return NULL;
+	}
+
+	pthread_mutex_lock(&timers_mutex);
+
+	for (i = 0; i < MOCK_TIMERS_MAX; i++) {
+		if (!timers[i]) {
+			timers[i] = timer;
+			break;
+		}
+	}
+
+	pthread_mutex_unlock(&timers_mutex);
+
+	if (i == MOCK_TIMERS_MAX) {
+		free(timer);
+		return NULL;
+	}
+
+	return timer;
+}
+
+
+static void mock_timer_free(void *timer)
+{
+	unsigned int i = 0;
+
+	pthread_mutex_lock(&timers_mutex);
+
+	for (i = 0; i < MOCK_TIMERS_MAX; i++) {
+		if (timers[i] == timer) {
+			timers[i] = NULL;
+		}
+	}
+
+	pthread_mutex_unlock(&timers_mutex);
+
+	free(timer);
+}
+
+
+static void mock_timer_init(void *timer,
+			    void (*callback)(unsigned long),
+			    unsigned long data)
+{
+	struct mock_timer *mock_timer = timer;
+
+	mock_timer->callback = callback;
+	mock_timer->data = data;
+	mock_timer->armed = false;
+}
+
+
+static void mock_timer_schedule(void *timer, unsigned long duration)
+{
+	struct mock_timer *mock_timer = timer;
+
+	MOCK_STAT_INC(timer_schedules, 1);
+
+	pthread_mutex_lock(&timers_mutex);
+	mock_timer->expires_us = mock_osal_time_us() + (duration * 1000);
+	mock_timer->armed = true;
+	pthread_mutex_unlock(&timers_mutex);
+}
+
+
+static void mock_timer_kill(void *timer)
+{
+	pthread_mutex_lock(&timers_mutex);
+	((struct mock_timer *)timer)->armed = false;
+	pthread_mutex_unlock(&timers_mutex);
+}
+#endif /* CONFIG_NRF_WIFI_LOW_POWER || HAL_CMD_ASYNC */
+
+
+bool mock_osal_timer_armed(void *timer)
+{
+	bool armed = false;
+
+	pthread_mutex_lock(&timers_mutex);
+	armed = ((struct mock_timer *)timer)->armed;
+	pthread_mutex_unlock(&timers_mutex);
+
+	return armed;
+}
+
+
+void mock_osal_time_advance(unsigned long usecs)
+{
+	struct mock_timer *timer = NULL;
+	unsigned int i = 0;
+
+	__atomic_fetch_add(&mock_time_us, usecs, __ATOMIC_RELAXED);
+
+	do {
+		timer = NULL;
+
+		pthread_mutex_lock(&timers_mutex);
+
+		for (i = 0; i < MOCK_TIMERS_MAX; i++) {
+			if (timers[i] && timers[i]->armed &&
+			    (timers[i]->expires_us <= mock_osal_time_us())) {
+				timer = timers[i];
+				timer->armed = false;
+				break;
+			}
+		}
+
+		pthread_mutex_unlock(&timers_mutex);
+
+		if (timer) {
+			timer->callback(timer->data);
+		}
+	} while (timer);
+}
+
+
+static void mock_assert(int test_val,
+			int val,
+			enum nrf_wifi_assert_op_type op,
+			char *assert_msg)
+{
+	bool ok = false;
+
+	switch (op) {
+	case NRF_WIFI_ASSERT_EQUAL_TO:
+		ok = (test_val == val);
+		break;
+	case NRF_WIFI_ASSERT_NOT_EQUAL_TO:
+		ok = (test_val != val);
+		break;
+	case NRF_WIFI_ASSERT_LESS_THAN:
+		ok = (test_val < val);
+		break;
+	case NRF_WIFI_ASSERT_LESS_THAN_EQUAL_TO:
+		ok = (test_val <= val);
+		break;
+	case NRF_WIFI_ASSERT_GREATER_THAN:
+		ok = (test_val > val);
+		break;
+	case NRF_WIFI_ASSERT_GREATER_THAN_EQUAL_TO:
+		ok = (test_val >= val);
+		break;
+	}
+
+	if (!ok) {
+		fprintf(stderr, "%s: %s\n", __func__, assert_msg);
+		abort();
+	}
+}
+
+
+static unsigned int mock_strlen(const void *str)
+{
+	return strlen(str);
+}
+
+
+static const struct nrf_wifi_osal_ops mock_osal_ops = {
+	.mem_alloc = mock_mem_alloc,
+	.mem_zalloc = mock_mem_zalloc,
+	.mem_free = mock_mem_free,
+	.mem_cpy = mock_mem_cpy,
+	.mem_set = mock_mem_set,
+	.mem_cmp = mock_mem_cmp,
+#ifdef INLINE_RX
+	.iomem_mmap_inline_rx = mock_iomem_mmap_inline_rx,
+	.iomem_unmap_inline_rx = mock_iomem_unmap_inline_rx,
+#endif /* INLINE_RX */
+
+	.spinlock_alloc = mock_spinlock_alloc,
+	.spinlock_free = mock_spinlock_free,
+	.spinlock_init = mock_spinlock_init,
+	.spinlock_take = mock_spinlock_take,
+	.spinlock_rel = mock_spinlock_rel,
+	.spinlock_irq_take = mock_spinlock_irq_take,
+	.spinlock_irq_rel = mock_spinlock_irq_rel,
+
+	.log_dbg = mock_log_dbg,
+	.log_info = mock_log_info,
+	.log_err = mock_log_err,
+
+	.llist_node_alloc = mock_llist_node_alloc,
+	.llist_node_free = mock_llist_node_free,
+	.llist_node_data_get = mock_llist_node_data_get,
+	.llist_node_data_set = mock_llist_node_data_set,
+	.llist_alloc = mock_llist_alloc,
+	.llist_free = mock_llist_free,
+	.llist_init = mock_llist_init,
+	.llist_add_node_tail = mock_llist_add_node_tail,
+	.llist_add_node_head = mock_llist_add_node_head,
+	.llist_get_node_head = mock_llist_get_node_head,
+	.llist_get_node_nxt = mock_llist_get_node_nxt,
+	.llist_del_node = mock_llist_del_node,
+	.llist_len = mock_llist_len,
+
+	.nbuf_alloc = mock_nbuf_alloc,
+	.nbuf_free = mock_nbuf_free,
+	.nbuf_reset = mock_nbuf_reset,
+	.nbuf_headroom_res = mock_nbuf_headroom_res,
+	.nbuf_headroom_get = mock_nbuf_headroom_get,
+	.nbuf_data_size = mock_nbuf_data_size,
+	.nbuf_data_get = mock_nbuf_data_get,
+	.nbuf_data_put = mock_nbuf_data_put,
+	.nbuf_data_push = mock_nbuf_data_push,
+	.nbuf_data_pull = mock_nbuf_data_pull,
+	.nbuf_get_priority = mock_nbuf_get_priority,
+
+	.tasklet_alloc = mock_tasklet_alloc,
+	.tasklet_free = mock_tasklet_free,
+	.tasklet_init = mock_tasklet_init,
+	.tasklet_schedule = mock_tasklet_schedule,
+	.tasklet_kill = mock_tasklet_kill,
+
+	.sleep_ms = mock_sleep_ms,
+	.delay_us = mock_delay_us,
+	.time_get_curr_us = mock_time_get_curr_us,
+	.time_elapsed_us = mock_time_elapsed_us,
+
+#if defined(CONFIG_NRF_WIFI_LOW_POWER) || defined(HAL_CMD_ASYNC)
+	.timer_alloc = mock_timer_alloc,
+	.timer_free = mock_timer_free,
+	.timer_init = mock_timer_init,
+	.timer_schedule = mock_timer_schedule,
+	.timer_kill = mock_timer_kill,
+#endif /* CONFIG_NRF_WIFI_LOW_POWER || HAL_CMD_ASYNC */
+
+	.assert = mock_assert,
+	.strlen = mock_strlen,
+};
+
+
+const struct nrf_wifi_osal_ops *get_os_ops(void)
+{
+	mock_log_verbose = (getenv("MOCK_OSAL_VERBOSE") != NULL);
+
+	return &mock_osal_ops;
+}
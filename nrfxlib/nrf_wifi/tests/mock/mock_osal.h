@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief Host implementation of the OSAL ops used by the unit tests.
+ *
+ * Time is virtual: it only moves when the code under test delays/sleeps or
+ * when a test advances it, so timing dependent paths run deterministically
+ * and instantly. Tasklets and timers only run when a test asks for it.
+ * Spinlocks are mutexes which also record the order in which they nest, so
+ * that a lock order inversion is caught even if it never deadlocks.
+ */
+
+#ifndef __MOCK_OSAL_H__
+#define __MOCK_OSAL_H__
+
+#include <stdbool.h>
+#include "osal_api.h"
+
+struct mock_osal_stats {
+	unsigned long mem_allocs;
+	unsigned long llist_node_allocs;
+	unsigned long llist_node_frees;
+	unsigned long nbuf_allocs;
+	unsigned long nbuf_frees;
+	unsigned long delay_us_calls;
+	unsigned long delay_us_total;
+	unsigned long sleep_ms_calls;
+	unsigned long timer_schedules;
+	unsigned long tasklet_schedules;
+	unsigned long log_errs;
+	unsigned long lock_order_violations;
+};
+
+extern struct mock_osal_stats mock_osal_stats;
+
+void mock_osal_stats_reset(void);
+
+/* Virtual clock */
+unsigned long mock_osal_time_us(void);
+/* Advance the virtual clock and fire the timers which expired */
+void mock_osal_time_advance(unsigned long usecs);
+
+/* Run the scheduled tasklets until none is left, returns the number run */
+unsigned int mock_osal_tasklets_run(void);
+bool mock_osal_timer_armed(void *timer);
+
+/* Called on every delay_us, e.g. to move a simulated device along */
+extern void (*mock_osal_delay_hook)(int usecs);
+
+/* Called after every OSAL memory copy/set and lock release, as if the
+ * caller got preempted there, e.g. to run a lockless reader in the middle
+ * of an update. Not called recursively.
+ */
+extern void (*mock_osal_preempt_hook)(void);
+
+void mock_osal_nbuf_priority_set(void *nbuf, unsigned char priority);
+
+#endif /* __MOCK_OSAL_H__ */
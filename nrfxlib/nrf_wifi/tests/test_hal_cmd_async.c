@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief Tests for the sending of control commands with HAL_CMD_ASYNC.
+ *
+ * Commands which find no free command buffer on the RPU stay queued in the
+ * HAL instead of the sender spinning on the command available queue. The
+ * simulated RPU hands out its buffers late, checking that the queued
+ * commands still go out, in order, from the next send or from the retry
+ * timer when no event comes to push them.
+ */
+
+#include <string.h>
+#include "hal_api.h"
+#include "mock_bal.h"
+#include "mock_osal.h"
+#include "test.h"
+
+#define NUM_CMDS 8
+#define CMD_LEN 64
+
+static struct nrf_wifi_hal_dev_ctx *hal_dev_ctx;
+static unsigned int cmd_avl_deq_addr;
+static unsigned int next_seq;
+static unsigned int next_buf;
+
+
+static enum nrf_wifi_status event_process(void *mac_dev_ctx,
+					  void *event_data,
+					  unsigned int len)
+{
+	return NRF_WIFI_STATUS_SUCCESS;
+}
+
+
+static void setup(unsigned int num_cmd_bufs)
+{
+	mock_bal_reset();
+
+	hal_dev_ctx = mock_bal_hal_dev_add(NULL, event_process, num_cmd_bufs);
+	TEST_CHECK(hal_dev_ctx != NULL);
+
+	cmd_avl_deq_addr = mock_bal_hpq_regs(MOCK_BAL_HPQ_CMD_AVL)->dequeue_addr;
+	next_seq = 0;
+	next_buf = num_cmd_bufs;
+}
+
+
+static void teardown(void)
+{
+	mock_bal_hal_dev_rem(hal_dev_ctx);
+}
+
+
+/* Send a command, it must neither spin nor wait for a command buffer */
+static void cmd_send(void)
+{
+	unsigned long time_us = mock_osal_time_us();
+	unsigned int *cmd = NULL;
+
+	/* Consumed by the HAL */
+	cmd = nrf_wifi_osal_mem_zalloc(hal_dev_ctx->hpriv->opriv, CMD_LEN);
+	cmd[0] = next_seq++;
+
+	TEST_CHECK_EQ(nrf_wifi_hal_ctrl_cmd_send(hal_dev_ctx, cmd, CMD_LEN),
+		      NRF_WIFI_STATUS_SUCCESS);
+
+	TEST_CHECK_EQ(mock_osal_time_us(), time_us);
+}
+
+
+/* The RPU frees command buffers, without raising an event */
+static void cmd_bufs_free(unsigned int num_bufs)
+{
+	unsigned int i = 0;
+
+	for (i = 0; i < num_bufs; i++) {
+		mock_bal_hpq_push(MOCK_BAL_HPQ_CMD_AVL,
+				  MOCK_BAL_CMD_BUF_BASE +
+				  ((next_buf++ % 64) * MOCK_BAL_MSG_BUF_SZ));
+	}
+}
+
+
+/* The RPU takes the posted commands, which must come in sequence */
+static unsigned int cmds_take(unsigned int first_seq)
+{
+	unsigned int num_cmds = 0;
+	unsigned int addr = 0;
+
+	while (mock_bal_hpq_len(MOCK_BAL_HPQ_CMD_BUSY)) {
+		addr = mock_bal_hpq_pop(MOCK_BAL_HPQ_CMD_BUSY);
+		TEST_CHECK_EQ(mock_bal_rpu_read(addr), first_seq + num_cmds);
+		num_cmds++;
+	}
+
+	return num_cmds;
+}
+
+
+static bool cmd_retry_armed(void)
+{
+	return mock_osal_timer_armed(hal_dev_ctx->cmd_retry_timer);
+}
+
+
+/* With no command buffer free the sender returns at once, the retry timer
+ * posts the commands once the RPU has buffers again.
+ */
+static void test_no_spin(void)
+{
+	unsigned long reads = 0;
+	unsigned int i = 0;
+
+	setup(0);
+
+	mock_osal_stats_reset();
+	reads = mock_bal_rpu_read_count(cmd_avl_deq_addr);
+
+	for (i = 0; i < NUM_CMDS; i++) {
+		cmd_send();
+	}
+
+	/* One look at the command available queue per command, no spinning */
+	TEST_CHECK_EQ(mock_bal_rpu_read_count(cmd_avl_deq_addr) - reads, NUM_CMDS);
+	TEST_CHECK_EQ(mock_bal_hpq_len(MOCK_BAL_HPQ_CMD_BUSY), 0);
+	TEST_CHECK(cmd_retry_armed());
+
+	cmd_bufs_free(NUM_CMDS);
+	mock_osal_time_advance(HAL_CMD_RETRY_INTERVAL_MS * 1000);
+
+	TEST_CHECK_EQ(cmds_take(0), NUM_CMDS);
+	TEST_CHECK(!cmd_retry_armed());
+
+	teardown();
+}
+
+
+/* A send posts the commands queued before it first */
+static void test_retry_on_send(void)
+{
+	setup(2);
+
+	mock_osal_stats_reset();
+
+	cmd_send();
+	cmd_send();
+	cmd_send();
+	cmd_send();
+
+	TEST_CHECK_EQ(cmds_take(0), 2);
+	TEST_CHECK(cmd_retry_armed());
+
+	/* The timer has not expired yet, the next send finds the buffers */
+	cmd_bufs_free(3);
+	cmd_send();
+
+	TEST_CHECK_EQ(cmds_take(2), 3);
+
+	/* The timer then finds nothing left to do and stays idle */
+	mock_osal_time_advance(HAL_CMD_RETRY_INTERVAL_MS * 1000);
+
+	TEST_CHECK_EQ(mock_bal_hpq_len(MOCK_BAL_HPQ_CMD_BUSY), 0);
+	TEST_CHECK(!cmd_retry_armed());
+
+	teardown();
+}
+
+
+/* The retry timer keeps at it while the RPU has no buffer for the command */
+static void test_retry_timer(void)
+{
+	unsigned int i = 0;
+
+	setup(0);
+
+	mock_osal_stats_reset();
+
+	cmd_send();
+
+	for (i = 0; i < 10; i++) {
+		mock_osal_time_advance(HAL_CMD_RETRY_INTERVAL_MS * 1000);
+		TEST_CHECK(cmd_retry_armed());
+	}
+
+	TEST_CHECK_EQ(mock_bal_hpq_len(MOCK_BAL_HPQ_CMD_BUSY), 0);
+
+	cmd_bufs_free(1);
+	mock_osal_time_advance(HAL_CMD_RETRY_INTERVAL_MS * 1000);
+
+	TEST_CHECK_EQ(cmds_take(0), 1);
+	TEST_CHECK(!cmd_retry_armed());
+
+	teardown();
+}
+
+
+/* Commands still queued are dropped and the timer stopped on removal */
+static void test_rem_pending(void)
+{
+	setup(0);
+
+	cmd_send();
+	cmd_send();
+
+	TEST_CHECK(cmd_retry_armed());
+
+	teardown();
+
+	mock_osal_time_advance(HAL_CMD_RETRY_INTERVAL_MS * 1000);
+}
+
+
+int main(void)
+{
+	TEST_RUN(test_no_spin);
+	TEST_RUN(test_retry_on_send);
+	TEST_RUN(test_retry_timer);
+	TEST_RUN(test_rem_pending);
+
+	return TEST_EXIT();
+}
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief Tests for the reading of RPU events into the HAL event ring.
+ *
+ * The simulated RPU posts events on the event busy queue and raises the
+ * interrupt, the event tasklet then hands them to the callback. Events
+ * which fit a slot of the ring are read into it without any allocation,
+ * only fragmented events and events arriving while the ring is full fall
+ * back to an allocated message. A threaded interrupt handler processes the
+ * events itself.
+ */
+
+#include <string.h>
+#include "hal_api.h"
+#include "mock_bal.h"
+#include "mock_osal.h"
+#include "test.h"
+
+/* Event buffers of the simulated RPU */
+#define NUM_EVENT_BUFS 64
+#define EVENT_LEN 64
+#define NUM_ROUNDS 100
+
+static struct nrf_wifi_hal_dev_ctx *hal_dev_ctx;
+static unsigned int next_buf;
+static unsigned int next_seq;
+static unsigned int events_rcvd;
+static unsigned int events_bad;
+static unsigned int event_bufs_freed;
+/* Events the RPU posts as others are processed, keeping the host polling */
+static unsigned int events_to_post;
+
+
+static void event_post(unsigned int len);
+
+
+static unsigned int event_word(unsigned int seq, unsigned int i)
+{
+	return (seq << 16) | i;
+}
+
+
+static enum nrf_wifi_status event_process(void *mac_dev_ctx,
+					  void *event_data,
+					  unsigned int len)
+{
+	struct host_rpu_msg_hdr *hdr = event_data;
+	unsigned int *words = event_data;
+	unsigned int seq = events_rcvd;
+	unsigned int i = 0;
+
+	if (hdr->len != len) {
+		events_bad++;
+	}
+
+	for (i = 2; i < (len / 4); i++) {
+		if (words[i] != event_word(seq, i)) {
+			events_bad++;
+			break;
+		}
+	}
+
+	events_rcvd++;
+
+	if (events_to_post) {
+		events_to_post--;
+		event_post(EVENT_LEN);
+	}
+
+	return NRF_WIFI_STATUS_SUCCESS;
+}
+
+
+static void setup(void)
+{
+	mock_bal_reset();
+
+	hal_dev_ctx = mock_bal_hal_dev_add(NULL, event_process, 0);
+	TEST_CHECK(hal_dev_ctx != NULL);
+
+	next_buf = 0;
+	next_seq = 0;
+	events_rcvd = 0;
+	events_bad = 0;
+	event_bufs_freed = 0;
+	events_to_post = 0;
+}
+
+
+static void teardown(void)
+{
+	mock_bal_hal_dev_rem(hal_dev_ctx);
+}
+
+
+/* Post an event of len bytes, in fragments of the size of an event buffer */
+static void event_post(unsigned int len)
+{
+	unsigned int buf_addr = 0;
+	unsigned int val = 0;
+	unsigned int i = 0;
+
+	for (i = 0; i < (len / 4); i++) {
+		if (!((i * 4) % MOCK_BAL_MSG_BUF_SZ)) {
+			if (i) {
+				mock_bal_hpq_push(MOCK_BAL_HPQ_EVENT_BUSY, buf_addr);
+			}
+
+			buf_addr = MOCK_BAL_EVENT_BUF_BASE +
+				((next_buf++ % NUM_EVENT_BUFS) * MOCK_BAL_MSG_BUF_SZ);
+		}
+
+		if (i == 0) {
+			val = len;
+		} else if (i == 1) {
+			/* resubmit */
+			val = 1;
+		} else {
+			val = event_word(next_seq, i);
+		}
+
+		mock_bal_rpu_write(buf_addr + ((i * 4) % MOCK_BAL_MSG_BUF_SZ), val);
+	}
+
+	mock_bal_hpq_push(MOCK_BAL_HPQ_EVENT_BUSY, buf_addr);
+
+	next_seq++;
+}
+
+
+static void events_process(void)
+{
+	TEST_CHECK_EQ(mock_bal_irq(), NRF_WIFI_STATUS_SUCCESS);
+	mock_osal_tasklets_run();
+
+	/* The RPU takes back the event buffers the host has freed */
+	while (mock_bal_hpq_len(MOCK_BAL_HPQ_EVENT_AVL)) {
+		mock_bal_hpq_pop(MOCK_BAL_HPQ_EVENT_AVL);
+		event_bufs_freed++;
+	}
+}
+
+
+/* Typical events are read into the ring, nothing is allocated for them */
+static void test_ring(void)
+{
+	unsigned long mem_allocs = 0;
+	unsigned int i = 0;
+
+	setup();
+
+	mem_allocs = mock_osal_stats.mem_allocs;
+
+	for (i = 0; i < NUM_ROUNDS; i++) {
+		event_post(EVENT_LEN);
+		event_post(EVENT_LEN);
+		event_post(RPU_EVENT_COMMON_SIZE_MAX + EVENT_LEN);
+		events_process();
+	}
+
+	TEST_CHECK_EQ(events_rcvd, NUM_ROUNDS * 3);
+	TEST_CHECK_EQ(events_bad, 0);
+	TEST_CHECK_EQ(mock_osal_stats.mem_allocs, mem_allocs);
+	TEST_CHECK_EQ(event_bufs_freed, NUM_ROUNDS * 3);
+
+	teardown();
+}
+
+
+/* Events which find the ring full are still delivered, in order */
+static void test_ring_full(void)
+{
+	unsigned long mem_allocs = 0;
+	unsigned int i = 0;
+
+	setup();
+
+	mem_allocs = mock_osal_stats.mem_allocs;
+
+	for (i = 0; i < HAL_EVENT_RING_SLOTS + 8; i++) {
+		event_post(EVENT_LEN);
+	}
+
+	events_process();
+
+	TEST_CHECK_EQ(events_rcvd, HAL_EVENT_RING_SLOTS + 8);
+	TEST_CHECK_EQ(events_bad, 0);
+	TEST_CHECK_EQ(mock_osal_stats.mem_allocs, mem_allocs + 8);
+
+	/* The slots are free again */
+	mem_allocs = mock_osal_stats.mem_allocs;
+
+	event_post(EVENT_LEN);
+	events_process();
+
+	TEST_CHECK_EQ(events_rcvd, HAL_EVENT_RING_SLOTS + 9);
+	TEST_CHECK_EQ(mock_osal_stats.mem_allocs, mem_allocs);
+
+	teardown();
+}
+
+
+/* A fragmented event is assembled in one message */
+static void test_fragmented(void)
+{
+	unsigned long mem_allocs = 0;
+
+	setup();
+
+	mem_allocs = mock_osal_stats.mem_allocs;
+
+	event_post(EVENT_LEN);
+	event_post((2 * MOCK_BAL_MSG_BUF_SZ) + EVENT_LEN);
+	event_post(EVENT_LEN);
+	events_process();
+
+	TEST_CHECK_EQ(events_rcvd, 3);
+	TEST_CHECK_EQ(events_bad, 0);
+	TEST_CHECK_EQ(mock_osal_stats.mem_allocs, mem_allocs + 1);
+	TEST_CHECK_EQ(event_bufs_freed, 5);
+
+	teardown();
+}
+
+
+/* A threaded interrupt handler processes and polls for the events itself,
+ * it never leaves them to the tasklet.
+ */
+static void test_threaded_poll(void)
+{
+	unsigned int i = 0;
+
+	setup();
+
+	nrf_wifi_hal_irq_threaded_set(hal_dev_ctx, true);
+	nrf_wifi_hal_irq_mod_set(hal_dev_ctx, 2, 64, 0);
+
+	mock_osal_stats_reset();
+
+	for (i = 0; i < 4; i++) {
+		event_post(EVENT_LEN);
+	}
+
+	events_to_post = 16;
+
+	TEST_CHECK_EQ(mock_bal_irq(), NRF_WIFI_STATUS_SUCCESS);
+
+	TEST_CHECK_EQ(events_rcvd, 4 + 16);
+	TEST_CHECK_EQ(events_bad, 0);
+	TEST_CHECK(!hal_dev_ctx->irq_polling);
+	TEST_CHECK_EQ(mock_osal_stats.tasklet_schedules, 0);
+	TEST_CHECK_EQ(mock_osal_tasklets_run(), 0);
+
+	teardown();
+}
+
+
+int main(void)
+{
+	TEST_RUN(test_ring);
+	TEST_RUN(test_ring_full);
+	TEST_RUN(test_fragmented);
+	TEST_RUN(test_threaded_poll);
+
+	return TEST_EXIT();
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief Tests for the waking of the RPU from power save.
+ *
+ * The simulated sleep controller reports the RPU ready a set time after the
+ * wake request. An access to a sleeping RPU must wake it and wait for it to
+ * be ready before touching anything but the sleep controller. Past the
+ * settle delay, the wait must track the actual wake time rather than a
+ * fixed delay.
+ */
+
+#include <string.h>
+#include "hal_api.h"
+#include "hal_reg.h"
+#include "mock_bal.h"
+#include "mock_osal.h"
+#include "test.h"
+
+#define REG_VAL 0x20091000
+
+static struct nrf_wifi_hal_dev_ctx *hal_dev_ctx;
+static unsigned int reg_addr;
+
+static const unsigned long wake_latencies_us[] = {
+	1, 5, 10, 50, 300, 1000, 2000, 20000, 300000
+};
+
+
+static enum nrf_wifi_status event_process(void *mac_dev_ctx,
+					  void *event_data,
+					  unsigned int len)
+{
+	return NRF_WIFI_STATUS_SUCCESS;
+}
+
+
+static void setup(void)
+{
+	mock_bal_reset();
+
+	hal_dev_ctx = mock_bal_hal_dev_add(NULL, event_process, 0);
+	TEST_CHECK(hal_dev_ctx != NULL);
+
+	/* A register with a known value to read back */
+	reg_addr = mock_bal_hpq_regs(MOCK_BAL_HPQ_CMD_AVL)->dequeue_addr;
+	mock_bal_hpq_push(MOCK_BAL_HPQ_CMD_AVL, REG_VAL);
+}
+
+
+static void teardown(void)
+{
+	mock_bal_hal_dev_rem(hal_dev_ctx);
+}
+
+
+/* Let the idle timer put the RPU to sleep */
+static void rpu_sleep(void)
+{
+	mock_osal_time_advance(hal_dev_ctx->rpu_ps_idle_timeout_ms * 1000);
+
+	TEST_CHECK(!mock_bal_rpu_awake());
+	TEST_CHECK_EQ(hal_dev_ctx->rpu_ps_state, RPU_PS_STATE_ASLEEP);
+
+	mock_osal_stats_reset();
+	memset(&mock_bal_stats, 0, sizeof(mock_bal_stats));
+}
+
+
+static enum nrf_wifi_status rpu_access(void)
+{
+	unsigned int val = 0;
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+
+	status = hal_rpu_reg_read(hal_dev_ctx, &val, reg_addr);
+
+	if (status == NRF_WIFI_STATUS_SUCCESS) {
+		TEST_CHECK_EQ(val, REG_VAL);
+	}
+
+	return status;
+}
+
+
+/* An RPU which is ready by the end of the settle delay is used right then */
+static void test_wake_ready(void)
+{
+	setup();
+
+	mock_bal_ps_wake_latency_us = 0;
+	rpu_sleep();
+
+	TEST_CHECK_EQ(rpu_access(), NRF_WIFI_STATUS_SUCCESS);
+
+	TEST_CHECK_EQ(mock_bal_stats.ps_wakes, 1);
+	TEST_CHECK_EQ(mock_bal_stats.ps_status_reads, 1);
+	TEST_CHECK_EQ(mock_osal_stats.delay_us_total, RPU_PS_WAKE_SETTLE_US);
+	TEST_CHECK_EQ(mock_bal_stats.asleep_accesses, 0);
+
+	/* Awake now, no more wakes */
+	TEST_CHECK_EQ(rpu_access(), NRF_WIFI_STATUS_SUCCESS);
+	TEST_CHECK_EQ(mock_bal_stats.ps_wakes, 1);
+	TEST_CHECK_EQ(mock_bal_stats.ps_status_reads, 1);
+
+	teardown();
+}
+
+
+/* The wait follows the wake time of the RPU, whatever it is */
+static void test_wake_latency(void)
+{
+	unsigned long latency_us = 0;
+	unsigned int i = 0;
+
+	setup();
+
+	for (i = 0; i < (sizeof(wake_latencies_us) / sizeof(wake_latencies_us[0])); i++) {
+		latency_us = wake_latencies_us[i];
+		mock_bal_ps_wake_latency_us = latency_us;
+		rpu_sleep();
+
+		TEST_CHECK_EQ(rpu_access(), NRF_WIFI_STATUS_SUCCESS);
+
+		TEST_CHECK_EQ(mock_bal_stats.asleep_accesses, 0);
+		TEST_CHECK(mock_osal_stats.delay_us_total >= latency_us);
+		TEST_CHECK(mock_osal_stats.delay_us_total >= RPU_PS_WAKE_SETTLE_US);
+
+		if (latency_us <= RPU_PS_WAKE_SETTLE_US) {
+			TEST_CHECK_EQ(mock_osal_stats.delay_us_total, RPU_PS_WAKE_SETTLE_US);
+			continue;
+		}
+
+		/* Overshoot by at most the last backoff step */
+		TEST_CHECK(mock_osal_stats.delay_us_total <=
+			   (2 * latency_us) + RPU_PS_WAKE_POLL_MIN_US);
+		TEST_CHECK(mock_osal_stats.delay_us_total <=
+			   latency_us + (2 * RPU_PS_WAKE_INTERVAL_MS * 1000));
+	}
+
+	teardown();
+}
+
+
+/* An RPU which does not wake is given up on, and left alone */
+static void test_wake_timeout(void)
+{
+	unsigned long log_errs = 0;
+
+	setup();
+
+	mock_bal_ps_wake_latency_us = 2 * RPU_PS_WAKE_TIMEOUT_S * 1000 * 1000;
+	rpu_sleep();
+
+	log_errs = mock_osal_stats.log_errs;
+
+	TEST_CHECK(rpu_access() != NRF_WIFI_STATUS_SUCCESS);
+
+	TEST_CHECK(mock_osal_stats.log_errs > log_errs);
+	TEST_CHECK_EQ(mock_bal_stats.asleep_accesses, 0);
+	TEST_CHECK(mock_osal_stats.delay_us_total >= RPU_PS_WAKE_TIMEOUT_S * 1000 * 1000);
+	TEST_CHECK(mock_osal_stats.delay_us_total <=
+		   (RPU_PS_WAKE_TIMEOUT_S * 1000 * 1000) + (2 * RPU_PS_WAKE_INTERVAL_MS * 1000));
+
+	/* It is woken fine once it is back */
+	mock_bal_ps_wake_latency_us = 0;
+	rpu_sleep();
+
+	TEST_CHECK_EQ(rpu_access(), NRF_WIFI_STATUS_SUCCESS);
+
+	teardown();
+}
+
+
+int main(void)
+{
+	TEST_RUN(test_wake_ready);
+	TEST_RUN(test_wake_latency);
+	TEST_RUN(test_wake_timeout);
+
+	return TEST_EXIT();
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief Tests for the ROM access register of Wezen.
+ *
+ * RAM0 and ROM0 share a host window, the ROM access register selects which
+ * of them it shows. The HAL sets it on each RAM read and ROM write, but only
+ * writes it over the bus when the value changes, or when the RPU may have
+ * lost it by going to sleep.
+ */
+
+#include <string.h>
+#include "hal_api.h"
+#include "hal_mem.h"
+#include "mock_bal.h"
+#include "mock_osal.h"
+#include "test.h"
+
+#define NUM_ACCESSES 16
+#define RAM_VAL 0x5AA50000
+
+static struct nrf_wifi_hal_dev_ctx *hal_dev_ctx;
+static unsigned long reg_writes_base;
+
+
+static enum nrf_wifi_status event_process(void *mac_dev_ctx,
+					  void *event_data,
+					  unsigned int len)
+{
+	return NRF_WIFI_STATUS_SUCCESS;
+}
+
+
+static unsigned long reg_writes(void)
+{
+	return mock_bal_rpu_write_count(ROM_ACCESS_REG_ADDR) - reg_writes_base;
+}
+
+
+static void ram_read(unsigned int i)
+{
+	unsigned int val = 0;
+
+	TEST_CHECK_EQ(hal_rpu_mem_read(hal_dev_ctx,
+				       &val,
+				       RPU_ADDR_RAM0_START + (i * 4),
+				       sizeof(val)),
+		      NRF_WIFI_STATUS_SUCCESS);
+
+	TEST_CHECK_EQ(mock_bal_rpu_read(ROM_ACCESS_REG_ADDR),
+		      RPU_REG_BIT_ROM_ACCESS_DISABLE);
+}
+
+
+static void rom_write(unsigned int i)
+{
+	unsigned int val = i;
+
+	TEST_CHECK_EQ(hal_rpu_mem_write(hal_dev_ctx,
+					RPU_ADDR_ROM0_START + (i * 4),
+					&val,
+					sizeof(val)),
+		      NRF_WIFI_STATUS_SUCCESS);
+
+	TEST_CHECK_EQ(mock_bal_rpu_read(ROM_ACCESS_REG_ADDR),
+		      RPU_REG_BIT_ROM_ACCESS_ENABLE);
+}
+
+
+/* Start with the window on ROM */
+static void setup(void)
+{
+	mock_bal_reset();
+
+	hal_dev_ctx = mock_bal_hal_dev_add(NULL, event_process, 0);
+	TEST_CHECK(hal_dev_ctx != NULL);
+
+	rom_write(0);
+	reg_writes_base = mock_bal_rpu_write_count(ROM_ACCESS_REG_ADDR);
+}
+
+
+static void teardown(void)
+{
+	mock_bal_hal_dev_rem(hal_dev_ctx);
+}
+
+
+/* Back to back RAM reads set the register once */
+static void test_ram_reads(void)
+{
+	unsigned int val = 0;
+	unsigned int i = 0;
+
+	setup();
+
+	mock_bal_rpu_write(RPU_ADDR_RAM0_START, RAM_VAL);
+
+	TEST_CHECK_EQ(hal_rpu_mem_read(hal_dev_ctx,
+				       &val,
+				       RPU_ADDR_RAM0_START,
+				       sizeof(val)),
+		      NRF_WIFI_STATUS_SUCCESS);
+	TEST_CHECK_EQ(val, RAM_VAL);
+
+	for (i = 1; i < NUM_ACCESSES; i++) {
+		ram_read(i);
+	}
+
+	TEST_CHECK_EQ(reg_writes(), 1);
+
+	teardown();
+}
+
+
+/* The register is written on each switch between ROM and RAM, not more */
+static void test_rom_ram_switch(void)
+{
+	unsigned int i = 0;
+
+	setup();
+
+	for (i = 0; i < NUM_ACCESSES; i++) {
+		ram_read(i);
+		ram_read(i + 1);
+		rom_write(i);
+		rom_write(i + 1);
+	}
+
+	TEST_CHECK_EQ(reg_writes(), 2 * NUM_ACCESSES);
+
+	teardown();
+}
+
+
+/* The register is set again after the RPU has slept */
+static void test_sleep(void)
+{
+	setup();
+
+	ram_read(0);
+	ram_read(1);
+	TEST_CHECK_EQ(reg_writes(), 1);
+
+	mock_osal_time_advance(hal_dev_ctx->rpu_ps_idle_timeout_ms * 1000);
+	TEST_CHECK(!mock_bal_rpu_awake());
+
+	ram_read(0);
+	ram_read(1);
+	TEST_CHECK_EQ(reg_writes(), 2);
+
+	teardown();
+}
+
+
+int main(void)
+{
+	TEST_RUN(test_ram_reads);
+	TEST_RUN(test_rom_ram_switch);
+	TEST_RUN(test_sleep);
+
+	return TEST_EXIT();
+}
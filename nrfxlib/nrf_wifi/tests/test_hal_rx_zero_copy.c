@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief Tests for the zero-copy RX buffer mapping of the HAL.
+ *
+ * With INLINE_RX_ZERO_COPY the RX buffers of the host are DMA mapped as a
+ * whole, headroom included, and the RPU writes the frame past the headroom
+ * at the address it was given. The simulated bus checks that the RPU only
+ * writes within a mapping and that every mapping is torn down as mapped.
+ */
+
+#include <string.h>
+#include "hal_api.h"
+#include "mock_bal.h"
+#include "mock_osal.h"
+#include "test.h"
+
+#define RX_BUF_SZ CONFIG_NRF700X_RX_MAX_DATA_SIZE
+#define FRAME_LEN (RX_BUF_SZ - MOCK_BAL_RX_BUF_HEADROOM)
+#define NUM_BUFS 4
+
+static struct nrf_wifi_hal_dev_ctx *hal_dev_ctx;
+static unsigned char rx_bufs[NUM_BUFS][RX_BUF_SZ];
+static unsigned char frame[FRAME_LEN];
+
+
+static enum nrf_wifi_status event_process(void *mac_dev_ctx,
+					  void *event_data,
+					  unsigned int len)
+{
+	return NRF_WIFI_STATUS_SUCCESS;
+}
+
+
+static void setup(void)
+{
+	unsigned int i = 0;
+
+	mock_bal_reset();
+
+	hal_dev_ctx = mock_bal_hal_dev_add(NULL, event_process, 0);
+	TEST_CHECK(hal_dev_ctx != NULL);
+
+	memset(rx_bufs, 0, sizeof(rx_bufs));
+
+	for (i = 0; i < FRAME_LEN; i++) {
+		frame[i] = i;
+	}
+}
+
+
+static void teardown(void)
+{
+	mock_bal_hal_dev_rem(hal_dev_ctx);
+}
+
+
+static unsigned long rx_buf_map(unsigned int buf_id)
+{
+	/* The FMAC puts the desc in the headroom before mapping */
+	*(unsigned int *)rx_bufs[buf_id] = buf_id;
+
+	return nrf_wifi_hal_buf_map_rx(hal_dev_ctx,
+				       (unsigned long)rx_bufs[buf_id],
+				       RX_BUF_SZ,
+				       0,
+				       buf_id);
+}
+
+
+/* The RPU fills the frame in place, the headroom is left to the host */
+static void test_rx_in_place(void)
+{
+	unsigned long phy_addr = 0;
+	unsigned int i = 0;
+
+	setup();
+
+	for (i = 0; i < NUM_BUFS; i++) {
+		phy_addr = rx_buf_map(i);
+		TEST_CHECK(phy_addr != 0);
+
+		/* The whole frame fits the mapping past the headroom, and
+		 * the headroom itself is mapped too.
+		 */
+		TEST_CHECK(mock_bal_dma_write(phy_addr, frame, FRAME_LEN));
+		TEST_CHECK(mock_bal_dma_write(phy_addr - MOCK_BAL_RX_BUF_HEADROOM,
+					      rx_bufs[i],
+					      MOCK_BAL_RX_BUF_HEADROOM));
+	}
+
+	TEST_CHECK_EQ(mock_bal_dma_mapped(), NUM_BUFS);
+
+	for (i = 0; i < NUM_BUFS; i++) {
+		TEST_CHECK_EQ(nrf_wifi_hal_buf_unmap_rx(hal_dev_ctx, FRAME_LEN, 0, i),
+			      (unsigned long)rx_bufs[i]);
+		TEST_CHECK_EQ(*(unsigned int *)rx_bufs[i], i);
+		TEST_CHECK(!memcmp(&rx_bufs[i][MOCK_BAL_RX_BUF_HEADROOM], frame, FRAME_LEN));
+	}
+
+	TEST_CHECK_EQ(mock_bal_dma_mapped(), 0);
+	TEST_CHECK_EQ(mock_bal_stats.dma_bad_unmaps, 0);
+
+	teardown();
+}
+
+
+/* A failed unmap is not reported as a received buffer */
+static void test_unmap_fail(void)
+{
+	unsigned long log_errs = 0;
+
+	setup();
+
+	TEST_CHECK(rx_buf_map(0) != 0);
+
+	log_errs = mock_osal_stats.log_errs;
+	mock_bal_dma_unmap_fail = true;
+
+	TEST_CHECK_EQ(nrf_wifi_hal_buf_unmap_rx(hal_dev_ctx, FRAME_LEN, 0, 0), 0);
+	TEST_CHECK(mock_osal_stats.log_errs > log_errs);
+
+	/* The buffer is still mapped and can be unmapped once the bus is back */
+	mock_bal_dma_unmap_fail = false;
+
+	TEST_CHECK_EQ(nrf_wifi_hal_buf_unmap_rx(hal_dev_ctx, FRAME_LEN, 0, 0),
+		      (unsigned long)rx_bufs[0]);
+	TEST_CHECK_EQ(mock_bal_dma_mapped(), 0);
+
+	teardown();
+}
+
+
+int main(void)
+{
+	TEST_RUN(test_rx_in_place);
+	TEST_RUN(test_unmap_fail);
+
+	return TEST_EXIT();
+}
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief Tests for the software HPQM rings.
+ *
+ * With SOFT_HPQM the host and the RPU exchange commands and events through
+ * rings in RPU memory, each with an index owned by the host. The host keeps
+ * its own copy of those indices, so after init it only ever writes them.
+ * The simulated RPU plays its side of each ring for several laps, checking
+ * that the host wraps around with it.
+ */
+
+#include <string.h>
+#include "hal_api.h"
+#include "mock_bal.h"
+#include "mock_osal.h"
+#include "test.h"
+
+#define NUM_LAPS 3
+#define CMD_LEN 64
+#define EVENT_LEN 64
+
+static struct nrf_wifi_hal_dev_ctx *hal_dev_ctx;
+static unsigned char cmd[CMD_LEN];
+static unsigned int events_rcvd;
+static unsigned long idx_reads_base[4];
+
+static const unsigned int idx_addrs[4] = {
+	MOCK_BAL_SOFT_HPQ_ADDR(host_cmd_free_index),
+	MOCK_BAL_SOFT_HPQ_ADDR(host_event_busy_index),
+	MOCK_BAL_SOFT_HPQ_ADDR(host_tx_cmd_busy_index),
+	MOCK_BAL_SOFT_HPQ_ADDR(host_tx_done_busy_index),
+};
+
+
+static enum nrf_wifi_status event_process(void *mac_dev_ctx,
+					  void *event_data,
+					  unsigned int len)
+{
+	unsigned int *words = event_data;
+
+	if ((len == EVENT_LEN) && (words[2] == events_rcvd)) {
+		events_rcvd++;
+	}
+
+	return NRF_WIFI_STATUS_SUCCESS;
+}
+
+
+static void setup(void)
+{
+	unsigned int i = 0;
+
+	mock_bal_reset();
+
+	hal_dev_ctx = mock_bal_hal_dev_add(NULL, event_process, HOST_RPU_CMD_BUFFERS);
+	TEST_CHECK(hal_dev_ctx != NULL);
+
+	for (i = 0; i < 4; i++) {
+		idx_reads_base[i] = mock_bal_rpu_read_count(idx_addrs[i]);
+	}
+
+	events_rcvd = 0;
+}
+
+
+static void teardown(void)
+{
+	unsigned int i = 0;
+
+	/* The host owned indices were never read back from the RPU */
+	for (i = 0; i < 4; i++) {
+		TEST_CHECK_EQ(mock_bal_rpu_read_count(idx_addrs[i]), idx_reads_base[i]);
+	}
+
+	mock_bal_hal_dev_rem(hal_dev_ctx);
+}
+
+
+static unsigned int event_buf_addr(unsigned int seq)
+{
+	return MOCK_BAL_EVENT_BUF_BASE + ((seq % 16) * MOCK_BAL_MSG_BUF_SZ);
+}
+
+
+static void event_write(unsigned int seq, unsigned int resubmit)
+{
+	unsigned int addr = event_buf_addr(seq);
+
+	mock_bal_rpu_write(addr, EVENT_LEN);
+	mock_bal_rpu_write(addr + 4, resubmit);
+	mock_bal_rpu_write(addr + 8, seq);
+}
+
+
+static void events_process(void)
+{
+	TEST_CHECK_EQ(mock_bal_irq(), NRF_WIFI_STATUS_SUCCESS);
+	mock_osal_tasklets_run();
+}
+
+
+/* Each control command takes the next free buffer and is posted in the
+ * matching busy slot, the RPU hands the buffer back in the same slot.
+ */
+static void test_cmd_ring(void)
+{
+	unsigned int num_cmds = NUM_LAPS * HOST_RPU_CMD_BUFFERS + 1;
+	unsigned int slot = 0;
+	unsigned int addr = 0;
+	unsigned int i = 0;
+	void *ctrl_cmd = NULL;
+
+	setup();
+
+	for (i = 0; i < num_cmds; i++) {
+		slot = i % HOST_RPU_CMD_BUFFERS;
+		addr = mock_bal_rpu_read(MOCK_BAL_SOFT_HPQ_ADDR(cmd_free_buffs[slot]));
+		TEST_CHECK(addr != 0);
+
+		/* Consumed by the HAL */
+		ctrl_cmd = nrf_wifi_osal_mem_zalloc(hal_dev_ctx->hpriv->opriv, CMD_LEN);
+
+		TEST_CHECK_EQ(nrf_wifi_hal_ctrl_cmd_send(hal_dev_ctx, ctrl_cmd, CMD_LEN),
+			      NRF_WIFI_STATUS_SUCCESS);
+
+		TEST_CHECK_EQ(mock_bal_rpu_read(MOCK_BAL_SOFT_HPQ_ADDR(cmd_free_buffs[slot])), 0);
+		TEST_CHECK_EQ(mock_bal_rpu_read(MOCK_BAL_SOFT_HPQ_ADDR(cmd_busy_buffs[slot])), addr);
+		TEST_CHECK_EQ(mock_bal_rpu_read(MOCK_BAL_SOFT_HPQ_ADDR(host_cmd_free_index)),
+			      (i + 1) % HOST_RPU_CMD_BUFFERS);
+
+		/* The RPU consumes the command and frees its buffer */
+		mock_bal_rpu_write(MOCK_BAL_SOFT_HPQ_ADDR(cmd_busy_buffs[slot]), 0);
+		mock_bal_rpu_write(MOCK_BAL_SOFT_HPQ_ADDR(cmd_free_buffs[slot]), addr);
+	}
+
+	teardown();
+}
+
+
+/* Events are taken from the busy ring and resubmitted on the free ring */
+static void test_event_ring(void)
+{
+	unsigned int num_events = NUM_LAPS * HOST_RPU_EVENT_BUFFERS + 1;
+	unsigned int slot = 0;
+	unsigned int i = 0;
+
+	setup();
+
+	for (i = 0; i < num_events; i++) {
+		slot = i % HOST_RPU_EVENT_BUFFERS;
+
+		event_write(i, 1);
+		mock_bal_rpu_write(MOCK_BAL_SOFT_HPQ_ADDR(event_busy_buffs[slot]),
+				   event_buf_addr(i));
+
+		events_process();
+
+		TEST_CHECK_EQ(events_rcvd, i + 1);
+		TEST_CHECK_EQ(mock_bal_rpu_read(MOCK_BAL_SOFT_HPQ_ADDR(event_busy_buffs[slot])), 0);
+		TEST_CHECK_EQ(mock_bal_rpu_read(MOCK_BAL_SOFT_HPQ_ADDR(event_free_buffs[slot])),
+			      event_buf_addr(i));
+		TEST_CHECK_EQ(mock_bal_rpu_read(MOCK_BAL_SOFT_HPQ_ADDR(host_event_busy_index)),
+			      (i + 1) % HOST_RPU_EVENT_BUFFERS);
+	}
+
+	teardown();
+}
+
+
+/* TX commands fill the TX command ring, TX done events are read off their
+ * ring in batches which wrap around its end.
+ */
+static void test_tx_rings(void)
+{
+	unsigned int num_cmds = NUM_LAPS * HOST_RPU_TX_DESC + 1;
+	unsigned int batch = 5;
+	unsigned int slot = 0;
+	unsigned int seq = 0;
+	unsigned int i = 0;
+	unsigned int j = 0;
+
+	setup();
+
+	for (i = 0; i < num_cmds; i++) {
+		slot = i % HOST_RPU_TX_DESC;
+
+		TEST_CHECK_EQ(nrf_wifi_hal_data_cmd_send(hal_dev_ctx,
+							 NRF_WIFI_HAL_MSG_TYPE_CMD_DATA_TX,
+							 cmd,
+							 sizeof(cmd),
+							 slot,
+							 0,
+							 false),
+			      NRF_WIFI_STATUS_SUCCESS);
+
+		TEST_CHECK_EQ(mock_bal_rpu_read(MOCK_BAL_SOFT_HPQ_ADDR(tx_cmd_buffs[slot])),
+			      RPU_MEM_TX_CMD_BASE + (slot * RPU_DATA_CMD_SIZE_MAX_TX));
+		TEST_CHECK_EQ(mock_bal_rpu_read(MOCK_BAL_SOFT_HPQ_ADDR(host_tx_cmd_busy_index)),
+			      (i + 1) % HOST_RPU_TX_DESC);
+
+		mock_bal_rpu_write(MOCK_BAL_SOFT_HPQ_ADDR(tx_cmd_buffs[slot]), 0);
+	}
+
+	for (i = 0; i < NUM_LAPS * HOST_RPU_TX_DESC; i += batch) {
+		for (j = 0; j < batch; j++) {
+			seq = i + j;
+			slot = seq % HOST_RPU_TX_DESC;
+
+			event_write(seq, 0);
+			mock_bal_rpu_write(MOCK_BAL_SOFT_HPQ_ADDR(tx_done_buffs[slot]),
+					   event_buf_addr(seq));
+		}
+
+		events_process();
+
+		TEST_CHECK_EQ(events_rcvd, i + batch);
+		TEST_CHECK_EQ(mock_bal_rpu_read(MOCK_BAL_SOFT_HPQ_ADDR(host_tx_done_busy_index)),
+			      (i + batch) % HOST_RPU_TX_DESC);
+
+		for (j = 0; j < HOST_RPU_TX_DESC; j++) {
+			TEST_CHECK_EQ(mock_bal_rpu_read(MOCK_BAL_SOFT_HPQ_ADDR(tx_done_buffs[j])), 0);
+		}
+	}
+
+	teardown();
+}
+
+
+int main(void)
+{
+	TEST_RUN(test_cmd_ring);
+	TEST_RUN(test_event_ring);
+	TEST_RUN(test_tx_rings);
+
+	return TEST_EXIT();
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief Tests for the batching of the TX doorbell in the HAL.
+ *
+ * The event tasklet batches the TX commands it sends while processing TX
+ * done events. Only those are held back until the batch ends, a TX command
+ * sent from another context during the batch (e.g. start_xmit on another
+ * CPU) must ring the doorbell straight away.
+ */
+
+#include "hal_api.h"
+#include "mock_bal.h"
+#include "test.h"
+
+#define TX_CMD_SIZE 64
+#define NUM_CMDS 4
+
+static struct nrf_wifi_hal_dev_ctx *hal_dev_ctx;
+static unsigned char tx_cmd[TX_CMD_SIZE];
+static unsigned long doorbells_base;
+
+
+static enum nrf_wifi_status event_process(void *mac_dev_ctx,
+					  void *event_data,
+					  unsigned int len)
+{
+	return NRF_WIFI_STATUS_SUCCESS;
+}
+
+
+static void setup(void)
+{
+	mock_bal_reset();
+
+	hal_dev_ctx = mock_bal_hal_dev_add(NULL, event_process, 0);
+	TEST_CHECK(hal_dev_ctx != NULL);
+
+	doorbells_base = mock_bal_rpu_write_count(WEZEN_RPU_REG_INT_TO_WIFICORE_BELLBOARD_TASKS_TRIGGER);
+}
+
+
+static void teardown(void)
+{
+	mock_bal_hal_dev_rem(hal_dev_ctx);
+}
+
+
+static unsigned long doorbells(void)
+{
+	return mock_bal_rpu_write_count(WEZEN_RPU_REG_INT_TO_WIFICORE_BELLBOARD_TASKS_TRIGGER) -
+		doorbells_base;
+}
+
+
+static void tx_cmd_send(unsigned int desc, bool batch)
+{
+	TEST_CHECK_EQ(nrf_wifi_hal_data_cmd_send(hal_dev_ctx,
+						 NRF_WIFI_HAL_MSG_TYPE_CMD_DATA_TX,
+						 tx_cmd,
+						 sizeof(tx_cmd),
+						 desc,
+						 0,
+						 batch),
+		      NRF_WIFI_STATUS_SUCCESS);
+}
+
+
+/* Without a batch every TX command rings the doorbell */
+static void test_no_batch(void)
+{
+	unsigned int i = 0;
+
+	setup();
+
+	for (i = 0; i < NUM_CMDS; i++) {
+		tx_cmd_send(i, true);
+	}
+
+	TEST_CHECK_EQ(doorbells(), NUM_CMDS);
+	TEST_CHECK_EQ(mock_bal_hpq_len(MOCK_BAL_HPQ_CMD_BUSY), NUM_CMDS);
+
+	teardown();
+}
+
+
+/* The batch owner's commands are posted, but signalled once at the end */
+static void test_batch_owner(void)
+{
+	unsigned int i = 0;
+
+	setup();
+
+	nrf_wifi_hal_data_cmd_batch_start(hal_dev_ctx);
+
+	for (i = 0; i < NUM_CMDS; i++) {
+		tx_cmd_send(i, true);
+	}
+
+	TEST_CHECK_EQ(doorbells(), 0);
+	TEST_CHECK_EQ(mock_bal_hpq_len(MOCK_BAL_HPQ_CMD_BUSY), NUM_CMDS);
+
+	TEST_CHECK_EQ(nrf_wifi_hal_data_cmd_batch_end(hal_dev_ctx),
+		      NRF_WIFI_STATUS_SUCCESS);
+
+	TEST_CHECK_EQ(doorbells(), 1);
+
+	teardown();
+}
+
+
+/* A command from outside the batch is not delayed by it, and its doorbell
+ * covers what the batch had held back so far.
+ */
+static void test_batch_other_ctx(void)
+{
+	setup();
+
+	nrf_wifi_hal_data_cmd_batch_start(hal_dev_ctx);
+
+	tx_cmd_send(0, true);
+	tx_cmd_send(1, true);
+	TEST_CHECK_EQ(doorbells(), 0);
+
+	tx_cmd_send(2, false);
+	TEST_CHECK_EQ(doorbells(), 1);
+
+	TEST_CHECK_EQ(nrf_wifi_hal_data_cmd_batch_end(hal_dev_ctx),
+		      NRF_WIFI_STATUS_SUCCESS);
+
+	TEST_CHECK_EQ(doorbells(), 1);
+	TEST_CHECK_EQ(mock_bal_hpq_len(MOCK_BAL_HPQ_CMD_BUSY), 3);
+
+	teardown();
+}
+
+
+int main(void)
+{
+	TEST_RUN(test_no_batch);
+	TEST_RUN(test_batch_owner);
+	TEST_RUN(test_batch_other_ctx);
+
+	return TEST_EXIT();
+}
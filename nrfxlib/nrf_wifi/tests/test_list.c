@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief Tests and benchmark for the utils list and queue.
+ */
+
+#include "list.h"
+#include "queue.h"
+#include "mock_osal.h"
+#include "test.h"
+
+#define NUM_OPS 1000000
+
+static struct nrf_wifi_osal_priv *opriv;
+static unsigned long items[128];
+
+
+static enum nrf_wifi_status sum_items(void *callbk_data, void *data)
+{
+	*(unsigned long *)callbk_data += *(unsigned long *)data;
+
+	return NRF_WIFI_STATUS_SUCCESS;
+}
+
+
+static void test_queue_order(void)
+{
+	unsigned long sum = 0;
+	void *q = NULL;
+	unsigned int i = 0;
+
+	q = nrf_wifi_utils_q_alloc(opriv);
+
+	for (i = 1; i < 5; i++) {
+		nrf_wifi_utils_q_enqueue(opriv, q, &items[i]);
+	}
+
+	nrf_wifi_utils_q_enqueue_head(opriv, q, &items[0]);
+	TEST_CHECK_EQ(nrf_wifi_utils_q_len(opriv, q), 5);
+	TEST_CHECK(nrf_wifi_utils_q_peek(opriv, q) == &items[0]);
+
+	nrf_wifi_utils_list_traverse(opriv, q, &sum, sum_items);
+	TEST_CHECK_EQ(sum, 0 + 1 + 2 + 3 + 4);
+
+	/* Unlink from the middle */
+	nrf_wifi_utils_list_del_node(opriv, q, &items[2]);
+
+	TEST_CHECK(nrf_wifi_utils_q_dequeue(opriv, q) == &items[0]);
+	TEST_CHECK(nrf_wifi_utils_q_dequeue(opriv, q) == &items[1]);
+	TEST_CHECK(nrf_wifi_utils_q_dequeue(opriv, q) == &items[3]);
+	TEST_CHECK(nrf_wifi_utils_q_dequeue(opriv, q) == &items[4]);
+	TEST_CHECK(nrf_wifi_utils_q_dequeue(opriv, q) == NULL);
+	TEST_CHECK_EQ(nrf_wifi_utils_q_len(opriv, q), 0);
+
+	nrf_wifi_utils_q_free(opriv, q);
+}
+
+
+/* Once a queue has been as deep as it gets, it no longer allocates. */
+static void test_node_reuse(void)
+{
+	void *q = NULL;
+	unsigned int iter = 0;
+	unsigned int i = 0;
+
+	mock_osal_stats_reset();
+
+	q = nrf_wifi_utils_q_alloc(opriv);
+
+	for (i = 0; i < NRF_WIFI_UTILS_LIST_NODE_CACHE_MAX; i++) {
+		nrf_wifi_utils_q_enqueue(opriv, q, &items[i]);
+	}
+
+	TEST_CHECK_EQ(mock_osal_stats.llist_node_allocs, NRF_WIFI_UTILS_LIST_NODE_CACHE_MAX);
+
+	for (iter = 0; iter < 1000; iter++) {
+		while (nrf_wifi_utils_q_dequeue(opriv, q))
+			;
+
+		for (i = 0; i < 1 + (iter % NRF_WIFI_UTILS_LIST_NODE_CACHE_MAX); i++) {
+			nrf_wifi_utils_q_enqueue(opriv, q, &items[i]);
+		}
+
+		nrf_wifi_utils_list_del_node(opriv, q, &items[0]);
+		nrf_wifi_utils_q_enqueue_head(opriv, q, &items[0]);
+	}
+
+	TEST_CHECK_EQ(mock_osal_stats.llist_node_allocs, NRF_WIFI_UTILS_LIST_NODE_CACHE_MAX);
+	TEST_CHECK_EQ(mock_osal_stats.llist_node_frees, 0);
+
+	while (nrf_wifi_utils_q_dequeue(opriv, q))
+		;
+
+	nrf_wifi_utils_q_free(opriv, q);
+
+	TEST_CHECK_EQ(mock_osal_stats.llist_node_frees, mock_osal_stats.llist_node_allocs);
+}
+
+
+/* Only up to NRF_WIFI_UTILS_LIST_NODE_CACHE_MAX nodes are kept around. */
+static void test_node_cache_cap(void)
+{
+	unsigned int depth = NRF_WIFI_UTILS_LIST_NODE_CACHE_MAX * 3;
+	void *q = NULL;
+	unsigned int i = 0;
+
+	mock_osal_stats_reset();
+
+	q = nrf_wifi_utils_q_alloc(opriv);
+
+	for (i = 0; i < depth; i++) {
+		nrf_wifi_utils_q_enqueue(opriv, q, &items[i]);
+	}
+
+	while (nrf_wifi_utils_q_dequeue(opriv, q))
+		;
+
+	TEST_CHECK_EQ(mock_osal_stats.llist_node_frees, depth - NRF_WIFI_UTILS_LIST_NODE_CACHE_MAX);
+
+	for (i = 0; i < depth; i++) {
+		nrf_wifi_utils_q_enqueue(opriv, q, &items[i]);
+	}
+
+	TEST_CHECK_EQ(mock_osal_stats.llist_node_allocs,
+		      (2 * depth) - NRF_WIFI_UTILS_LIST_NODE_CACHE_MAX);
+
+	while (nrf_wifi_utils_q_dequeue(opriv, q))
+		;
+
+	nrf_wifi_utils_q_free(opriv, q);
+
+	TEST_CHECK_EQ(mock_osal_stats.llist_node_frees, mock_osal_stats.llist_node_allocs);
+}
+
+
+/* Steady state of a TX pending queue, a few frames in and out at a time */
+static void bench_enqueue_dequeue(void)
+{
+	unsigned long long start = 0;
+	void *q = NULL;
+	unsigned int i = 0;
+
+	q = nrf_wifi_utils_q_alloc(opriv);
+
+	start = test_ns();
+
+	for (i = 0; i < NUM_OPS; i++) {
+		nrf_wifi_utils_q_enqueue(opriv, q, &items[i % 8]);
+
+		if ((i % 8) == 7) {
+			while (nrf_wifi_utils_q_dequeue(opriv, q))
+				;
+		}
+	}
+
+	printf("  %.1f ns per enqueue + dequeue\n",
+	       (double)(test_ns() - start) / NUM_OPS);
+
+	nrf_wifi_utils_q_free(opriv, q);
+}
+
+
+int main(void)
+{
+	unsigned int i = 0;
+
+	for (i = 0; i < sizeof(items) / sizeof(items[0]); i++) {
+		items[i] = i;
+	}
+
+	opriv = nrf_wifi_osal_init();
+
+	TEST_RUN(test_queue_order);
+	TEST_RUN(test_node_reuse);
+	TEST_RUN(test_node_cache_cap);
+	TEST_RUN(bench_enqueue_dequeue);
+
+	nrf_wifi_osal_deinit(opriv);
+
+	return TEST_EXIT();
+}
@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief Tests for the translation of RPU addresses to host offsets.
+ *
+ * pal_rpu_addr_offset_get() looks addresses up in a table of regions. It is
+ * checked against the chain of comparisons it replaced, kept here as the
+ * reference: every word of every 1 MiB block the reference maps anything in
+ * and a coarse sweep of the rest of the address space, in order and in
+ * random order.
+ */
+
+#include "pal.h"
+#include "mock_osal.h"
+#include "test.h"
+
+/* Granularity of the coarse sweep, below the smallest region (8 KiB) */
+#define SWEEP_STEP 0x1000
+#define BLOCK_SZ (RPU_ADDR_MASK_OFFSET + 1)
+#define NUM_BLOCKS (0x100000000ULL / BLOCK_SZ)
+#define NUM_RANDOM 1000000
+
+static struct nrf_wifi_osal_priv *opriv;
+static bool blocks_mapped[NUM_BLOCKS];
+static unsigned long num_mapped;
+/* Addresses the reference mapped onto the bellboard/GRTC window with no
+ * region offset, which are now rejected.
+ */
+static unsigned long num_bellboard_rejected;
+
+
+/* pal_rpu_addr_offset_get() before the region table */
+static enum nrf_wifi_status ref_rpu_addr_offset_get(unsigned int rpu_addr,
+						    unsigned long *addr,
+						    enum RPU_PROC_TYPE proc)
+{
+	unsigned int addr_base = (rpu_addr & RPU_ADDR_MASK_BASE);
+	unsigned long region_offset = 0;
+#ifdef SOC_WEZEN
+	unsigned int bellboard_grtc_addr_base = 0;
+
+	if (addr_base == RPU_ADDR_WIFI_MCU_REGS_START) {
+		region_offset = SOC_MMAP_ADDR_OFFSET_WIFI_MCU_REGS;
+	} else if ((rpu_addr >= RPU_ADDR_RAM0_START) &&
+		   (rpu_addr <= RPU_ADDR_RAM0_END)) {
+		*addr = SOC_MMAP_ADDR_OFFSET_RAM0_PKD +
+			((rpu_addr - RPU_ADDR_RAM0_START) & RPU_ADDR_RAM_ROM_MASK_OFFSET);
+		return NRF_WIFI_STATUS_SUCCESS;
+	} else if ((rpu_addr >= RPU_ADDR_RAM1_START) &&
+		   (rpu_addr <= RPU_ADDR_RAM1_END)) {
+		*addr = SOC_MMAP_ADDR_OFFSET_RAM1_PKD +
+			((rpu_addr - RPU_ADDR_RAM1_START) & RPU_ADDR_RAM_ROM_MASK_OFFSET);
+		return NRF_WIFI_STATUS_SUCCESS;
+	} else if ((rpu_addr >= RPU_ADDR_ROM0_START) &&
+		   (rpu_addr <= RPU_ADDR_ROM0_END)) {
+		*addr = SOC_MMAP_ADDR_OFFSET_ROM0_PKD +
+			((rpu_addr - RPU_ADDR_ROM0_START) & RPU_ADDR_RAM_ROM_MASK_OFFSET);
+		return NRF_WIFI_STATUS_SUCCESS;
+	} else if ((rpu_addr >= RPU_ADDR_ROM1_START) &&
+		   (rpu_addr <= RPU_ADDR_ROM1_END)) {
+		*addr = SOC_MMAP_ADDR_OFFSET_ROM1_PKD +
+			((rpu_addr - RPU_ADDR_ROM1_START) & RPU_ADDR_RAM_ROM_MASK_OFFSET);
+		return NRF_WIFI_STATUS_SUCCESS;
+	} else if ((rpu_addr >= RPU_ADDR_DATA_RAM_START) &&
+		   (rpu_addr <= RPU_ADDR_DATA_RAM_END)) {
+		region_offset = SOC_MMAP_ADDR_OFFSET_DATA_RAM_PKD;
+	} else if ((rpu_addr >= RPU_ADDR_ACTUAL_DATA_RAM_START) &&
+		   (rpu_addr <= RPU_ADDR_ACTUAL_DATA_RAM_END)) {
+		region_offset = SOC_MMAP_ADDR_OFFSET_DATA_RAM_PKD;
+	} else if ((rpu_addr >= RPU_ADDR_CODE_RAM_START) &&
+		   (rpu_addr <= RPU_ADDR_CODE_RAM_END)) {
+		region_offset = SOC_MMAP_ADDR_OFFSET_CODE_RAM_PKD;
+	} else if (addr_base == RPU_ADDR_BELLBOARD_GRTC_REGION) {
+		bellboard_grtc_addr_base = (rpu_addr & RPU_ADDR_BELLBOARD_GRTC_MASK_BASE);
+
+		if (bellboard_grtc_addr_base == RPU_ADDR_BELLBOARD_APP_REGION)
+			region_offset = SOC_MMAP_ADDR_OFFSET_BELLBOARD_APP;
+		else if (bellboard_grtc_addr_base == RPU_ADDR_BELLBOARD_WIFI_REGION)
+			region_offset = SOC_MMAP_ADDR_OFFSET_BELLBOARD_WIFI;
+		else if (bellboard_grtc_addr_base == RPU_ADDR_GRTC_REGION)
+			region_offset = SOC_MMAP_ADDR_OFFSET_GRTC;
+	} else if (addr_base == RPU_ADDR_FPGA_REGS_REGION) {
+		region_offset = SOC_MMAP_ADDR_OFFSET_FPGA_REGS;
+	} else if (addr_base == RPU_ADDR_WICR_REGS_REGION) {
+		region_offset = SOC_MMAP_ADDR_OFFSET_WICR_REGS;
+#ifdef SOC_WEZEN_SECURE_DOMAIN
+	} else if (addr_base == RPU_ADDR_SECURERAM_REGION) {
+		region_offset = SOC_MAMP_ADDR_OFFSET_SECURERAM;
+#endif /* SOC_WEZEN_SECURE_DOMAIN */
+#else
+	if (addr_base == RPU_ADDR_SBUS_START) {
+		region_offset = SOC_MMAP_ADDR_OFFSET_SYSBUS;
+	} else if ((rpu_addr >= RPU_ADDR_GRAM_START) &&
+		   (rpu_addr <= RPU_ADDR_GRAM_END)) {
+		region_offset = SOC_MMAP_ADDR_OFFSET_GRAM_PKD;
+	} else if (addr_base == RPU_ADDR_PBUS_START) {
+		region_offset = SOC_MMAP_ADDR_OFFSET_PBUS;
+	} else if ((rpu_addr >= RPU_ADDR_GDRAM_START) &&
+		   (rpu_addr <= RPU_ADDR_GDRAM_END)) {
+		region_offset = SOC_MMAP_ADDR_OFFSET_GDRAM_PKD;
+	} else if (addr_base == RPU_ADDR_PKTRAM_START) {
+		region_offset = SOC_MMAP_ADDR_OFFSET_PKTRAM_HOST_VIEW;
+	} else if (pal_check_rpu_mcu_regions(proc, rpu_addr)) {
+		region_offset = SOC_MMAP_ADDR_OFFSETS_MCU[proc];
+#endif /* SOC_WEZEN */
+	} else {
+		return NRF_WIFI_STATUS_FAIL;
+	}
+
+#ifdef SOC_WEZEN
+	if (addr_base == RPU_ADDR_BELLBOARD_GRTC_REGION)
+		*addr = region_offset + (rpu_addr & RPU_BELLBOARD_GRTC_ADDR_MASK_OFFSET);
+	else if (addr_base == RPU_ADDR_CODE_RAM_REGION)
+		*addr = region_offset + ((rpu_addr - RPU_ADDR_CODE_RAM_START) & RPU_ADDR_MASK_OFFSET);
+	else if (addr_base == RPU_ADDR_WICR_REGS_REGION)
+		*addr = region_offset + (rpu_addr & RPU_WICR_ADDR_MASK_OFFSET);
+	else
+#endif /* SOC_WEZEN */
+	*addr = region_offset + (rpu_addr & RPU_ADDR_MASK_OFFSET);
+
+	return NRF_WIFI_STATUS_SUCCESS;
+}
+
+
+/* Returns true if the reference maps rpu_addr */
+static bool addr_check(unsigned int rpu_addr)
+{
+	enum nrf_wifi_status ref_status = NRF_WIFI_STATUS_FAIL;
+	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
+	unsigned long ref_offset = 0;
+	unsigned long offset = 0;
+	enum RPU_PROC_TYPE proc = RPU_PROC_TYPE_MCU_LMAC;
+
+	ref_status = ref_rpu_addr_offset_get(rpu_addr, &ref_offset, proc);
+	status = pal_rpu_addr_offset_get(opriv, rpu_addr, &offset, proc);
+
+#ifdef SOC_WEZEN
+	if ((ref_status == NRF_WIFI_STATUS_SUCCESS) &&
+	    (status != NRF_WIFI_STATUS_SUCCESS) &&
+	    ((rpu_addr & RPU_ADDR_MASK_BASE) == RPU_ADDR_BELLBOARD_GRTC_REGION) &&
+	    (ref_offset == (rpu_addr & RPU_BELLBOARD_GRTC_ADDR_MASK_OFFSET))) {
+		num_bellboard_rejected++;
+		return true;
+	}
+#endif /* SOC_WEZEN */
+
+	if (status != ref_status) {
+		fprintf(stderr, "  0x%08X: status %d, expected %d\n",
+			rpu_addr, status, ref_status);
+		test_failures++;
+	} else if ((status == NRF_WIFI_STATUS_SUCCESS) && (offset != ref_offset)) {
+		fprintf(stderr, "  0x%08X: offset 0x%lX, expected 0x%lX\n",
+			rpu_addr, offset, ref_offset);
+		test_failures++;
+	} else if (status == NRF_WIFI_STATUS_SUCCESS) {
+		num_mapped++;
+	}
+
+	return (ref_status == NRF_WIFI_STATUS_SUCCESS);
+}
+
+
+static void setup(void)
+{
+	mock_osal_stats_reset();
+	num_mapped = 0;
+	num_bellboard_rejected = 0;
+}
+
+
+/* Every word of the blocks with anything mapped, the rest sampled */
+static void test_sweep(void)
+{
+	unsigned long long block = 0;
+	unsigned int base = 0;
+	unsigned int off = 0;
+	unsigned int failures = test_failures;
+
+	setup();
+
+	for (block = 0; block < NUM_BLOCKS; block++) {
+		base = block * BLOCK_SZ;
+
+		for (off = 0; off < BLOCK_SZ; off += SWEEP_STEP) {
+			if (addr_check(base + off) || addr_check(base + off + SWEEP_STEP - 4)) {
+				blocks_mapped[block] = true;
+			}
+		}
+
+		if (!blocks_mapped[block]) {
+			continue;
+		}
+
+		for (off = 0; off < BLOCK_SZ; off += 4) {
+			addr_check(base + off);
+
+			/* Keep a runaway translation from flooding the log */
+			if (test_failures > failures + 10) {
+				return;
+			}
+		}
+	}
+
+	printf("  %lu words mapped, %lu bellboard words rejected\n",
+	       num_mapped, num_bellboard_rejected);
+
+	TEST_CHECK(num_mapped > 0);
+}
+
+
+/* Addresses jumping between regions */
+static void test_random(void)
+{
+	unsigned int mapped[NUM_BLOCKS];
+	unsigned int num_blocks = 0;
+	unsigned int seed = 1;
+	unsigned int rpu_addr = 0;
+	unsigned int i = 0;
+
+	setup();
+
+	for (i = 0; i < NUM_BLOCKS; i++) {
+		if (blocks_mapped[i]) {
+			mapped[num_blocks++] = i;
+		}
+	}
+
+	TEST_CHECK(num_blocks > 1);
+
+	for (i = 0; i < NUM_RANDOM; i++) {
+		seed = (seed * 1103515245) + 12345;
+		rpu_addr = (mapped[(seed >> 16) % num_blocks] * BLOCK_SZ);
+		seed = (seed * 1103515245) + 12345;
+		rpu_addr += (seed & RPU_ADDR_MASK_OFFSET) & ~3;
+
+		addr_check(rpu_addr);
+	}
+
+	TEST_CHECK(num_mapped > 0);
+}
+
+
+int main(void)
+{
+	opriv = nrf_wifi_osal_init();
+
+	TEST_RUN(test_sweep);
+	TEST_RUN(test_random);
+
+	nrf_wifi_osal_deinit(opriv);
+
+	return TEST_EXIT();
+}
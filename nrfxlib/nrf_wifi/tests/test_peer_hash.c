@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief Tests and benchmark for the peer lookup table.
+ */
+
+#include <string.h>
+#include "fmac_peer.h"
+#include "fmac_structs.h"
+#include "fmac_util.h"
+#include "mock_fmac.h"
+#include "mock_hal.h"
+#include "mock_osal.h"
+#include "test.h"
+
+#define NUM_STABLE_PEERS 3
+#define NUM_LOOKUPS 1000000
+
+static struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx;
+static unsigned char peer_addr[MAX_PEERS][NRF_WIFI_ETH_ADDR_LEN];
+static unsigned long lookups;
+static unsigned long lookup_misses;
+
+
+static void setup(void)
+{
+	unsigned int i = 0;
+
+	mock_hal_reset();
+
+	fmac_dev_ctx = mock_fmac_dev_add();
+
+	mock_fmac_vif_add(fmac_dev_ctx, 0, NRF_WIFI_IFTYPE_AP, NULL);
+	mock_fmac_vif_add(fmac_dev_ctx, 1, NRF_WIFI_IFTYPE_AP, NULL);
+
+	/* Spread over the address so that some of the peers collide */
+	for (i = 0; i < MAX_PEERS; i++) {
+		mock_fmac_mac_addr(peer_addr[i], 0x10203 * (i + 1));
+	}
+}
+
+
+static void teardown(void)
+{
+	mock_fmac_dev_rem(fmac_dev_ctx);
+}
+
+
+static void test_lookup(void)
+{
+	unsigned char unknown[NRF_WIFI_ETH_ADDR_LEN];
+	unsigned char mcast[NRF_WIFI_ETH_ADDR_LEN] = { 0x01, 0x00, 0x5e, 0x00, 0x00, 0x01 };
+	int ids[MAX_PEERS];
+	unsigned int i = 0;
+
+	setup();
+
+	mock_fmac_mac_addr(unknown, 0xabcdef);
+
+	for (i = 0; i < MAX_PEERS; i++) {
+		ids[i] = nrf_wifi_fmac_peer_add(fmac_dev_ctx, 0, peer_addr[i], 0, 1);
+		TEST_CHECK_EQ(ids[i], i);
+	}
+
+	/* Full */
+	TEST_CHECK_EQ(nrf_wifi_fmac_peer_add(fmac_dev_ctx, 0, unknown, 0, 1), -1);
+
+	for (i = 0; i < MAX_PEERS; i++) {
+		TEST_CHECK_EQ(nrf_wifi_fmac_peer_get_id(fmac_dev_ctx, peer_addr[i]), ids[i]);
+	}
+
+	TEST_CHECK_EQ(nrf_wifi_fmac_peer_get_id(fmac_dev_ctx, unknown), -1);
+	TEST_CHECK_EQ(nrf_wifi_fmac_peer_get_id(fmac_dev_ctx, mcast), MAX_PEERS);
+
+	/* Removing a peer keeps the ones probed past it reachable */
+	for (i = 0; i < MAX_PEERS; i += 2) {
+		nrf_wifi_fmac_peer_remove(fmac_dev_ctx, 0, ids[i]);
+	}
+
+	for (i = 0; i < MAX_PEERS; i++) {
+		TEST_CHECK_EQ(nrf_wifi_fmac_peer_get_id(fmac_dev_ctx, peer_addr[i]),
+			      (i % 2) ? ids[i] : -1);
+	}
+
+	/* A new peer takes the lowest free index */
+	TEST_CHECK_EQ(nrf_wifi_fmac_peer_add(fmac_dev_ctx, 0, unknown, 0, 1), 0);
+	TEST_CHECK_EQ(nrf_wifi_fmac_peer_get_id(fmac_dev_ctx, unknown), 0);
+
+	nrf_wifi_fmac_peers_flush(fmac_dev_ctx, 0);
+
+	for (i = 0; i < MAX_PEERS; i++) {
+		TEST_CHECK_EQ(nrf_wifi_fmac_peer_get_id(fmac_dev_ctx, peer_addr[i]), -1);
+	}
+
+	TEST_CHECK_EQ(nrf_wifi_fmac_peer_get_id(fmac_dev_ctx, unknown), -1);
+
+	teardown();
+}
+
+
+static void lookup_stable_peers(void)
+{
+	unsigned int i = 0;
+
+	for (i = 0; i < NUM_STABLE_PEERS; i++) {
+		if (nrf_wifi_fmac_peer_get_id(fmac_dev_ctx, peer_addr[i]) != (int)i) {
+			lookup_misses++;
+		}
+
+		lookups++;
+	}
+}
+
+
+/* Peers which stay connected must be found while other peers come and go.
+ * The lookups are lockless, so they are run at every point where the
+ * add/remove path could be preempted.
+ */
+static void test_lookup_during_update(void)
+{
+	unsigned int iter = 0;
+	unsigned int i = 0;
+	int id = 0;
+
+	setup();
+
+	for (i = 0; i < NUM_STABLE_PEERS; i++) {
+		nrf_wifi_fmac_peer_add(fmac_dev_ctx, 0, peer_addr[i], 0, 1);
+	}
+
+	lookups = 0;
+	lookup_misses = 0;
+	mock_osal_preempt_hook = lookup_stable_peers;
+
+	for (iter = 0; iter < 100; iter++) {
+		for (i = NUM_STABLE_PEERS; i < MAX_PEERS; i++) {
+			nrf_wifi_fmac_peer_add(fmac_dev_ctx, 0, peer_addr[i], 0, 1);
+		}
+
+		for (i = NUM_STABLE_PEERS; i < MAX_PEERS; i++) {
+			id = nrf_wifi_fmac_peer_get_id(fmac_dev_ctx, peer_addr[i]);
+			nrf_wifi_fmac_peer_remove(fmac_dev_ctx, 0, id);
+		}
+
+		nrf_wifi_fmac_peer_add(fmac_dev_ctx, 1, peer_addr[MAX_PEERS - 1], 0, 1);
+		nrf_wifi_fmac_peers_flush(fmac_dev_ctx, 1);
+	}
+
+	mock_osal_preempt_hook = NULL;
+
+	TEST_CHECK(lookups > 0);
+	TEST_CHECK_EQ(lookup_misses, 0);
+
+	teardown();
+}
+
+
+/* Full table, lookups rotate over all peers so the last hit cache never
+ * helps, plus one miss per round.
+ */
+static void bench_lookup(void)
+{
+	unsigned char unknown[NRF_WIFI_ETH_ADDR_LEN];
+	unsigned long long start = 0;
+	unsigned int i = 0;
+	int expected = 0;
+	int sum = 0;
+
+	setup();
+
+	mock_fmac_mac_addr(unknown, 0xabcdef);
+
+	for (i = 0; i < MAX_PEERS; i++) {
+		nrf_wifi_fmac_peer_add(fmac_dev_ctx, 0, peer_addr[i], 0, 1);
+	}
+
+	start = test_ns();
+
+	for (i = 0; i < NUM_LOOKUPS; i++) {
+		if ((i % (MAX_PEERS + 1)) == MAX_PEERS) {
+			sum += nrf_wifi_fmac_peer_get_id(fmac_dev_ctx, unknown);
+		} else {
+			sum += nrf_wifi_fmac_peer_get_id(fmac_dev_ctx,
+							 peer_addr[i % (MAX_PEERS + 1)]);
+		}
+	}
+
+	printf("  %.1f ns per lookup\n",
+	       (double)(test_ns() - start) / NUM_LOOKUPS);
+
+	for (i = 0; i < NUM_LOOKUPS; i++) {
+		if ((i % (MAX_PEERS + 1)) == MAX_PEERS) {
+			expected -= 1;
+		} else {
+			expected += i % (MAX_PEERS + 1);
+		}
+	}
+
+	TEST_CHECK_EQ(sum, expected);
+
+	teardown();
+}
+
+
+int main(void)
+{
+	TEST_RUN(test_lookup);
+	TEST_RUN(test_lookup_during_update);
+	TEST_RUN(bench_lookup);
+
+	return TEST_EXIT();
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief Tests for the RPU pending queue bitmap writes in AP mode.
+ *
+ * Every write of the bitmap is an MMIO access to the RPU, it must only be
+ * written when the bitmap of a peer actually changed during a pass.
+ */
+
+#include "fmac_api.h"
+#include "fmac_peer.h"
+#include "fmac_structs.h"
+#include "fmac_tx.h"
+#include "fmac_util.h"
+#include "mock_fmac.h"
+#include "mock_hal.h"
+#include "test.h"
+
+#define NUM_FRAMES 40
+
+static struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx;
+static unsigned char peer_addr[NRF_WIFI_ETH_ADDR_LEN];
+static int peer_id;
+
+
+static void setup(void)
+{
+	mock_hal_reset();
+
+	fmac_dev_ctx = mock_fmac_dev_add();
+
+	mock_fmac_vif_add(fmac_dev_ctx, 0, NRF_WIFI_IFTYPE_AP, NULL);
+	mock_fmac_mac_addr(peer_addr, 1);
+	peer_id = nrf_wifi_fmac_peer_add(fmac_dev_ctx, 0, peer_addr, 0, 1);
+
+	mock_hal_stats.mem_writes = 0;
+}
+
+
+static void teardown(void)
+{
+	mock_fmac_dev_rem(fmac_dev_ctx);
+}
+
+
+static unsigned int bmp_addr(int id)
+{
+	return RPU_MEM_UMAC_PEND_Q_BMP +
+		(sizeof(struct sap_pend_frames_bitmap) * id) +
+		NRF_WIFI_FMAC_ETH_ADDR_LEN;
+}
+
+
+/* A frame sent out straight away sets and clears its bit in the same pass. */
+static void test_no_backlog(void)
+{
+	void *nbuf = NULL;
+
+	setup();
+
+	nbuf = mock_fmac_frame(fmac_dev_ctx, peer_addr, NRF_WIFI_FMAC_AC_BE, 100);
+	TEST_CHECK_EQ(nrf_wifi_fmac_start_xmit(fmac_dev_ctx, 0, nbuf),
+		      NRF_WIFI_STATUS_SUCCESS);
+	TEST_CHECK_EQ(mock_hal_tx_pending(), 1);
+
+	while (mock_hal_tx_done(fmac_dev_ctx) != -1)
+		;
+
+	TEST_CHECK_EQ(mock_hal_stats.mem_writes, 0);
+
+	teardown();
+}
+
+
+/* A backlog only costs a write when an AC of the peer starts or stops
+ * having frames pending across a pass, not per frame.
+ */
+static void test_backlog(void)
+{
+	unsigned int i = 0;
+	void *nbuf = NULL;
+
+	setup();
+
+	for (i = 0; i < NUM_FRAMES; i++) {
+		nbuf = mock_fmac_frame(fmac_dev_ctx, peer_addr, NRF_WIFI_FMAC_AC_BE, 100);
+		TEST_CHECK_EQ(nrf_wifi_fmac_start_xmit(fmac_dev_ctx, 0, nbuf),
+			      NRF_WIFI_STATUS_SUCCESS);
+	}
+
+	TEST_CHECK_EQ(mock_hal_stats.last_mem_write_addr, bmp_addr(peer_id));
+	TEST_CHECK_EQ(mock_hal_stats.last_mem_write_val, 1 << NRF_WIFI_FMAC_AC_BE);
+
+	for (i = 0; i < NUM_FRAMES; i++) {
+		nbuf = mock_fmac_frame(fmac_dev_ctx, peer_addr, NRF_WIFI_FMAC_AC_VI, 100);
+		nrf_wifi_fmac_start_xmit(fmac_dev_ctx, 0, nbuf);
+	}
+
+	TEST_CHECK_EQ(mock_hal_stats.last_mem_write_val,
+		      (1 << NRF_WIFI_FMAC_AC_BE) | (1 << NRF_WIFI_FMAC_AC_VI));
+
+	while (mock_hal_tx_done(fmac_dev_ctx) != -1)
+		;
+
+	TEST_CHECK_EQ(mock_hal_stats.redundant_mem_writes, 0);
+	TEST_CHECK(mock_hal_stats.mem_writes <= (2 * NUM_FRAMES) / 4);
+	TEST_CHECK_EQ(mock_hal_stats.last_mem_write_addr, bmp_addr(peer_id));
+	TEST_CHECK_EQ(mock_hal_stats.last_mem_write_val, 0);
+	TEST_CHECK_EQ(mock_hal_stats.data_cmd_frames, 2 * NUM_FRAMES);
+
+	printf("  %lu bitmap writes for %u frames\n",
+	       mock_hal_stats.mem_writes,
+	       2 * NUM_FRAMES);
+
+	teardown();
+}
+
+
+/* No bitmap is kept for a STA, nothing is written. */
+static void test_sta(void)
+{
+	unsigned char bssid[NRF_WIFI_ETH_ADDR_LEN];
+	unsigned int i = 0;
+	void *nbuf = NULL;
+
+	mock_hal_reset();
+
+	fmac_dev_ctx = mock_fmac_dev_add();
+
+	mock_fmac_mac_addr(bssid, 2);
+	mock_fmac_vif_add(fmac_dev_ctx, 0, NRF_WIFI_IFTYPE_STATION, bssid);
+	nrf_wifi_fmac_peer_add(fmac_dev_ctx, 0, bssid, 0, 1);
+
+	for (i = 0; i < NUM_FRAMES; i++) {
+		nbuf = mock_fmac_frame(fmac_dev_ctx, peer_addr, NRF_WIFI_FMAC_AC_BE, 100);
+		nrf_wifi_fmac_start_xmit(fmac_dev_ctx, 0, nbuf);
+	}
+
+	while (mock_hal_tx_done(fmac_dev_ctx) != -1)
+		;
+
+	TEST_CHECK_EQ(mock_hal_stats.mem_writes, 0);
+	TEST_CHECK_EQ(mock_hal_stats.data_cmd_frames, NUM_FRAMES);
+
+	teardown();
+}
+
+
+int main(void)
+{
+	TEST_RUN(test_no_backlog);
+	TEST_RUN(test_backlog);
+	TEST_RUN(test_sta);
+
+	return TEST_EXIT();
+}
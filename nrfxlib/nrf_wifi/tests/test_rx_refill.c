@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief Tests for the re-arming of the RX descs after an RX event.
+ *
+ * The mock RPU reports beacons, which the driver consumes itself, so every
+ * buffer of an event comes back to the free queue of its pool and has to
+ * be reused for the desc it came from rather than allocated afresh.
+ */
+
+#include <string.h>
+#include "fmac_api.h"
+#include "fmac_rx.h"
+#include "fmac_structs.h"
+#include "fmac_util.h"
+#include "mock_fmac.h"
+#include "mock_hal.h"
+#include "mock_osal.h"
+#include "test.h"
+
+#define NUM_RX_BUFS 64
+#define RX_BUF_SZ 1600
+#define FRAME_LEN 200
+#define NUM_EVENTS 100
+
+static struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx;
+static unsigned int descs[NUM_RX_BUFS];
+
+
+static void setup(void)
+{
+	unsigned int i = 0;
+
+	mock_hal_reset();
+
+	fmac_dev_ctx = mock_fmac_dev_add();
+	mock_fmac_vif_add(fmac_dev_ctx, 0, NRF_WIFI_IFTYPE_STATION, NULL);
+
+	TEST_CHECK_EQ(mock_fmac_rx_add(fmac_dev_ctx, NUM_RX_BUFS, RX_BUF_SZ),
+		      NRF_WIFI_STATUS_SUCCESS);
+
+	for (i = 0; i < NUM_RX_BUFS; i++) {
+		descs[i] = i;
+	}
+}
+
+
+static void teardown(void)
+{
+	mock_fmac_dev_rem(fmac_dev_ctx);
+
+	TEST_CHECK_EQ(mock_hal_stats.rx_buf_maps, mock_hal_stats.rx_buf_unmaps);
+}
+
+
+static void rx_event(unsigned int first_desc, unsigned int num_descs)
+{
+	TEST_CHECK_EQ(mock_fmac_rx_event(fmac_dev_ctx,
+					 0,
+					 NRF_WIFI_RX_PKT_BCN_PRB_RSP,
+					 &descs[first_desc],
+					 num_descs,
+					 FRAME_LEN),
+		      NRF_WIFI_STATUS_SUCCESS);
+}
+
+
+/* Consumed frames are re-armed with their own buffers, nothing is allocated */
+static void test_recycle(void)
+{
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+	unsigned long nbuf_allocs = 0;
+	unsigned long nbuf_frees = 0;
+	unsigned int i = 0;
+
+	setup();
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	nbuf_allocs = mock_osal_stats.nbuf_allocs;
+	nbuf_frees = mock_osal_stats.nbuf_frees;
+
+	for (i = 0; i < NUM_EVENTS; i++) {
+		rx_event((i * 8) % NUM_RX_BUFS, 8);
+	}
+
+	TEST_CHECK_EQ(mock_osal_stats.nbuf_allocs, nbuf_allocs);
+	TEST_CHECK_EQ(mock_osal_stats.nbuf_frees, nbuf_frees);
+	TEST_CHECK_EQ(def_dev_ctx->host_stats.rx_buf_recycle_hits[0], NUM_EVENTS * 8);
+	TEST_CHECK_EQ(def_dev_ctx->host_stats.rx_buf_recycle_misses[0], NUM_RX_BUFS);
+	TEST_CHECK_EQ(mock_hal_stats.rx_buf_maps,
+		      NUM_RX_BUFS + (NUM_EVENTS * 8));
+
+	teardown();
+}
+
+
+#ifdef CMD_RX_BUFF
+/* The buffers re-armed for an event are programmed to the UMAC together */
+static void test_prog_per_event(void)
+{
+	unsigned int num_descs = 0;
+	unsigned long prog_cmds = 0;
+	unsigned long prog_bufs = 0;
+
+	setup();
+
+	for (num_descs = 1; num_descs <= NUM_RX_BUFS; num_descs *= 2) {
+		prog_cmds = mock_fmac_stats.rx_prog_cmds;
+		prog_bufs = mock_fmac_stats.rx_prog_bufs;
+
+		rx_event(0, num_descs);
+
+		TEST_CHECK_EQ(mock_fmac_stats.rx_prog_cmds, prog_cmds + 1);
+		TEST_CHECK_EQ(mock_fmac_stats.rx_prog_bufs, prog_bufs + num_descs);
+	}
+
+	teardown();
+}
+#endif /* CMD_RX_BUFF */
+
+
+int main(void)
+{
+	TEST_RUN(test_recycle);
+#ifdef CMD_RX_BUFF
+	TEST_RUN(test_prog_per_event);
+#endif /* CMD_RX_BUFF */
+
+	return TEST_EXIT();
+}
@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief Tests for the TX completion accounting used by BQL.
+ *
+ * The test plays the OS side with a copy of the Linux dynamic queue limits
+ * algorithm: a frame is accounted before it is handed to
+ * nrf_wifi_fmac_start_xmit(), and completed at once if that drops it. The
+ * queue is stopped while the bytes in flight exceed the limit.
+ * The mock RPU completes one command per tick. Every frame taken must be
+ * reported back exactly once, whether it was sent or dropped.
+ */
+
+#include <limits.h>
+#include <string.h>
+#include "fmac_api.h"
+#include "fmac_peer.h"
+#include "fmac_structs.h"
+#include "fmac_tx.h"
+#include "fmac_util.h"
+#include "mock_fmac.h"
+#include "mock_hal.h"
+#include "queue.h"
+#include "test.h"
+
+#define FRAME_LEN 1500
+#define NUM_TICKS 4000
+#define SLACK_HOLD_TICKS 50
+/* More than fits in all the TX descriptors */
+#define PEER_BACKLOG 300
+
+/* Limits of the Linux DQL defaults */
+#define DQL_MAX_LIMIT ((UINT_MAX / 16) - 1)
+#define DQL_MIN_LIMIT 0
+
+#define POSDIFF(a, b) ((int)((a) - (b)) > 0 ? (a) - (b) : 0)
+
+struct dql {
+	unsigned int num_queued;
+	unsigned int adj_limit;
+	unsigned int last_obj_cnt;
+	unsigned int limit;
+	unsigned int num_completed;
+	unsigned int prev_ovlimit;
+	unsigned int prev_num_queued;
+	unsigned int prev_last_obj_cnt;
+	unsigned int lowest_slack;
+	unsigned long slack_start_time;
+	/* Completions of more than was queued, a BUG_ON in Linux */
+	unsigned int over_completions;
+};
+
+static struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx;
+static unsigned char peer_addr[NRF_WIFI_ETH_ADDR_LEN];
+static int peer_id;
+static struct dql dql;
+static unsigned long ticks;
+
+
+static void dql_queued(struct dql *dql, unsigned int count)
+{
+	dql->last_obj_cnt = count;
+	dql->num_queued += count;
+}
+
+
+static int dql_avail(const struct dql *dql)
+{
+	return (int)(dql->adj_limit - dql->num_queued);
+}
+
+
+static void dql_completed(struct dql *dql, unsigned int count)
+{
+	unsigned int inprogress, prev_inprogress, limit;
+	unsigned int ovlimit, completed, num_queued;
+	unsigned int slack, slack_last_objs;
+	bool all_prev_completed;
+
+	num_queued = dql->num_queued;
+
+	if (count > num_queued - dql->num_completed) {
+		dql->over_completions++;
+	}
+
+	completed = dql->num_completed + count;
+	limit = dql->limit;
+	ovlimit = POSDIFF(num_queued - dql->num_completed, limit);
+	inprogress = num_queued - completed;
+	prev_inprogress = dql->prev_num_queued - dql->num_completed;
+	all_prev_completed = (int)(completed - dql->prev_num_queued) >= 0;
+
+	if ((ovlimit && !inprogress) ||
+	    (dql->prev_ovlimit && all_prev_completed)) {
+		/* Starved, grow by what was missing */
+		limit += POSDIFF(completed, dql->prev_num_queued) +
+			dql->prev_ovlimit;
+		dql->slack_start_time = ticks;
+		dql->lowest_slack = UINT_MAX;
+	} else if (inprogress && prev_inprogress && !all_prev_completed) {
+		/* Shrink by the lowest slack seen over the hold time */
+		slack = POSDIFF(limit + dql->prev_ovlimit,
+				2 * (completed - dql->num_completed));
+		slack_last_objs = dql->prev_ovlimit ?
+			POSDIFF(dql->prev_last_obj_cnt, dql->prev_ovlimit) : 0;
+
+		if (slack_last_objs > slack) {
+			slack = slack_last_objs;
+		}
+
+		if (slack < dql->lowest_slack) {
+			dql->lowest_slack = slack;
+		}
+
+		if (ticks > dql->slack_start_time + SLACK_HOLD_TICKS) {
+			limit = POSDIFF(limit, dql->lowest_slack);
+			dql->slack_start_time = ticks;
+			dql->lowest_slack = UINT_MAX;
+		}
+	}
+
+	if (limit > DQL_MAX_LIMIT) {
+		limit = DQL_MAX_LIMIT;
+	}
+
+	if (limit != dql->limit) {
+		dql->limit = limit;
+		ovlimit = 0;
+	}
+
+	dql->adj_limit = limit + completed;
+	dql->prev_ovlimit = ovlimit;
+	dql->prev_last_obj_cnt = dql->last_obj_cnt;
+	dql->num_completed = completed;
+	dql->prev_num_queued = num_queued;
+}
+
+
+static void tx_done(void *os_vif_ctx,
+		    unsigned int ac,
+		    unsigned int pkts,
+		    unsigned int bytes)
+{
+	mock_fmac_stats.tx_done_pkts[ac] += pkts;
+	mock_fmac_stats.tx_done_bytes[ac] += bytes;
+
+	dql_completed(&dql, bytes);
+}
+
+
+static void setup(void)
+{
+	struct nrf_wifi_fmac_priv_def *def_priv = NULL;
+
+	mock_hal_reset();
+
+	fmac_dev_ctx = mock_fmac_dev_add();
+	def_priv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
+	def_priv->callbk_fns.tx_done_callbk_fn = tx_done;
+
+	mock_fmac_vif_add(fmac_dev_ctx, 0, NRF_WIFI_IFTYPE_AP, NULL);
+
+	mock_fmac_mac_addr(peer_addr, 1);
+	peer_id = nrf_wifi_fmac_peer_add(fmac_dev_ctx, 0, peer_addr, 0, 1);
+	TEST_CHECK(peer_id != -1);
+
+	memset(&dql, 0, sizeof(dql));
+	dql.lowest_slack = UINT_MAX;
+	ticks = 0;
+}
+
+
+static void teardown(void)
+{
+	while (mock_hal_tx_done(fmac_dev_ctx) != -1)
+		;
+
+	mock_fmac_dev_rem(fmac_dev_ctx);
+}
+
+
+/* What start_xmit in the Linux glue does */
+static bool xmit(void)
+{
+	void *nbuf = NULL;
+
+	nbuf = mock_fmac_frame(fmac_dev_ctx, peer_addr, NRF_WIFI_FMAC_AC_BE, FRAME_LEN);
+
+	dql_queued(&dql, FRAME_LEN);
+
+	if (nrf_wifi_fmac_start_xmit(fmac_dev_ctx, 0, nbuf) != NRF_WIFI_STATUS_SUCCESS) {
+		dql_completed(&dql, FRAME_LEN);
+		return false;
+	}
+
+	return true;
+}
+
+
+static unsigned int in_flight(void)
+{
+	return dql.num_queued - dql.num_completed;
+}
+
+
+/* The stack keeps the queue full, the limit settles to what keeps the RPU
+ * busy instead of growing with the backlog the driver could hold.
+ */
+static void test_converge(void)
+{
+	unsigned int min_limit = UINT_MAX;
+	unsigned int max_limit = 0;
+	unsigned int max_in_flight = 0;
+
+	setup();
+
+	for (ticks = 1; ticks <= NUM_TICKS; ticks++) {
+		while (dql_avail(&dql) >= 0 &&
+		       !mock_fmac_stats.txq_stopped[NRF_WIFI_FMAC_AC_BE]) {
+			TEST_CHECK(xmit());
+		}
+
+		if (in_flight() > max_in_flight) {
+			max_in_flight = in_flight();
+		}
+
+		mock_hal_tx_done(fmac_dev_ctx);
+
+		if (ticks > NUM_TICKS / 2) {
+			if (dql.limit < min_limit) {
+				min_limit = dql.limit;
+			}
+
+			if (dql.limit > max_limit) {
+				max_limit = dql.limit;
+			}
+		}
+	}
+
+	printf("  limit %u..%u, max in flight %u\n",
+	       min_limit, max_limit, max_in_flight);
+
+	TEST_CHECK_EQ(dql.over_completions, 0);
+	TEST_CHECK(max_limit > 0);
+	TEST_CHECK(max_limit <= 2 * min_limit);
+	TEST_CHECK(max_limit < TX_PENDING_QLEN_HIGH_WM * FRAME_LEN / 4);
+	TEST_CHECK_EQ(mock_fmac_stats.txq_stops[NRF_WIFI_FMAC_AC_BE], 0);
+
+	teardown();
+
+	TEST_CHECK_EQ(in_flight(), 0);
+}
+
+
+/* Frames held for a peer which goes away are reported on the way out */
+static void test_peer_remove(void)
+{
+	unsigned long data_cmds = 0;
+	unsigned int i = 0;
+
+	setup();
+
+	for (i = 0; i < PEER_BACKLOG; i++) {
+		TEST_CHECK(xmit());
+	}
+
+	TEST_CHECK(in_flight() > 0);
+
+	nrf_wifi_fmac_peer_remove(fmac_dev_ctx, 0, peer_id);
+	data_cmds = mock_hal_stats.data_cmds;
+
+	while (mock_hal_tx_done(fmac_dev_ctx) != -1)
+		;
+
+	/* Nothing more is sent to the peer once it is gone */
+	TEST_CHECK_EQ(mock_hal_stats.data_cmds, data_cmds);
+	TEST_CHECK_EQ(in_flight(), 0);
+	TEST_CHECK_EQ(dql.over_completions, 0);
+	TEST_CHECK_EQ(mock_fmac_stats.tx_done_pkts[NRF_WIFI_FMAC_AC_BE], PEER_BACKLOG);
+
+	teardown();
+}
+
+
+/* A completion which fails to unmap its buffers still completes them */
+static void test_unmap_fail(void)
+{
+	unsigned int i = 0;
+
+	setup();
+
+	for (i = 0; i < 20; i++) {
+		TEST_CHECK(xmit());
+	}
+
+	mock_hal_unmap_tx_fail = true;
+
+	while (mock_hal_tx_done(fmac_dev_ctx) != -1)
+		;
+
+	TEST_CHECK_EQ(in_flight(), 0);
+	TEST_CHECK_EQ(dql.over_completions, 0);
+
+	teardown();
+}
+
+
+int main(void)
+{
+	TEST_RUN(test_converge);
+	TEST_RUN(test_peer_remove);
+	TEST_RUN(test_unmap_fail);
+
+	return TEST_EXIT();
+}
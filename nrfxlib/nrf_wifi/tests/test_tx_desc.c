@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief Tests and benchmark for the TX descriptor allocator.
+ */
+
+#include "fmac_structs.h"
+#include "fmac_tx.h"
+#include "fmac_util.h"
+#include "mock_fmac.h"
+#include "mock_hal.h"
+#include "test.h"
+
+static struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx;
+static struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx;
+static struct nrf_wifi_fmac_priv_def *def_priv;
+
+
+static void setup(void)
+{
+	mock_hal_reset();
+
+	fmac_dev_ctx = mock_fmac_dev_add();
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	def_priv = wifi_fmac_priv(fmac_dev_ctx->fpriv);
+}
+
+
+static void teardown(void)
+{
+	mock_fmac_dev_rem(fmac_dev_ctx);
+}
+
+
+static unsigned int spare_map(unsigned int desc, int queue)
+{
+	unsigned int rsvd = def_priv->num_tx_tokens_per_ac * NRF_WIFI_FMAC_AC_MAX;
+
+	return 1 << (((desc - rsvd) * SPARE_DESC_Q_MAP_SIZE) + queue);
+}
+
+
+/* Reserved descs come first, lowest first, then spares, then none. */
+static void test_get_order(void)
+{
+	unsigned int rsvd = 0;
+	unsigned int desc = 0;
+	unsigned int i = 0;
+	int ac = 0;
+
+	setup();
+
+	rsvd = def_priv->num_tx_tokens_per_ac * NRF_WIFI_FMAC_AC_MAX;
+
+	for (ac = 0; ac < NRF_WIFI_FMAC_AC_MAX; ac++) {
+		for (i = 0; i < def_priv->num_tx_tokens_per_ac; i++) {
+			desc = tx_desc_get(fmac_dev_ctx, ac);
+			TEST_CHECK_EQ(desc, ac + (NRF_WIFI_FMAC_AC_MAX * i));
+		}
+
+		TEST_CHECK_EQ(def_dev_ctx->tx_config.outstanding_descs[ac],
+			      def_priv->num_tx_tokens_per_ac);
+	}
+
+	TEST_CHECK_EQ(def_dev_ctx->tx_config.spare_desc_queue_map, 0);
+
+	for (i = 0; i < def_priv->num_tx_tokens_spare; i++) {
+		desc = tx_desc_get(fmac_dev_ctx, NRF_WIFI_FMAC_AC_VO);
+		TEST_CHECK_EQ(desc, rsvd + i);
+		TEST_CHECK(def_dev_ctx->tx_config.spare_desc_queue_map &
+			   spare_map(desc, NRF_WIFI_FMAC_AC_VO));
+	}
+
+	/* Exhausted */
+	for (ac = 0; ac < NRF_WIFI_FMAC_AC_MAX; ac++) {
+		TEST_CHECK_EQ(tx_desc_get(fmac_dev_ctx, ac), def_priv->num_tx_tokens);
+	}
+
+	TEST_CHECK_EQ(def_dev_ctx->tx_config.outstanding_descs[NRF_WIFI_FMAC_AC_VO],
+		      def_priv->num_tx_tokens_per_ac + def_priv->num_tx_tokens_spare);
+
+	teardown();
+}
+
+
+/* A freed desc is handed out again and the spare bookkeeping follows it. */
+static void test_free_reuse(void)
+{
+	unsigned int rsvd = 0;
+	unsigned int descs[CONFIG_NRF700X_MAX_TX_TOKENS];
+	unsigned int spare = 0;
+	unsigned int i = 0;
+
+	setup();
+
+	rsvd = def_priv->num_tx_tokens_per_ac * NRF_WIFI_FMAC_AC_MAX;
+
+	for (i = 0; i < def_priv->num_tx_tokens_per_ac + def_priv->num_tx_tokens_spare; i++) {
+		descs[i] = tx_desc_get(fmac_dev_ctx, NRF_WIFI_FMAC_AC_BE);
+	}
+
+	/* Free the first reserved desc, it is the next one handed out */
+	tx_desc_free(fmac_dev_ctx, descs[0], NRF_WIFI_FMAC_AC_BE);
+	TEST_CHECK_EQ(def_dev_ctx->tx_config.outstanding_descs[NRF_WIFI_FMAC_AC_BE],
+		      def_priv->num_tx_tokens_per_ac + def_priv->num_tx_tokens_spare - 1);
+	TEST_CHECK_EQ(tx_desc_get(fmac_dev_ctx, NRF_WIFI_FMAC_AC_BE), descs[0]);
+
+	/* Other ACs still get their own reserved descs */
+	TEST_CHECK_EQ(tx_desc_get(fmac_dev_ctx, NRF_WIFI_FMAC_AC_BK), NRF_WIFI_FMAC_AC_BK);
+
+	/* Free a spare desc, its queue map bit is cleared and another AC
+	 * can take it.
+	 */
+	spare = rsvd + 1;
+	tx_desc_free(fmac_dev_ctx, spare, NRF_WIFI_FMAC_AC_BE);
+	TEST_CHECK(!(def_dev_ctx->tx_config.spare_desc_queue_map &
+		     spare_map(spare, NRF_WIFI_FMAC_AC_BE)));
+	TEST_CHECK(def_dev_ctx->tx_config.spare_desc_queue_map &
+		   spare_map(rsvd, NRF_WIFI_FMAC_AC_BE));
+
+	for (i = 0; i < def_priv->num_tx_tokens_per_ac; i++) {
+		tx_desc_get(fmac_dev_ctx, NRF_WIFI_FMAC_AC_VI);
+	}
+
+	TEST_CHECK_EQ(tx_desc_get(fmac_dev_ctx, NRF_WIFI_FMAC_AC_VI), spare);
+	TEST_CHECK(def_dev_ctx->tx_config.spare_desc_queue_map &
+		   spare_map(spare, NRF_WIFI_FMAC_AC_VI));
+
+	teardown();
+}
+
+
+/* Freeing a desc twice or an out of range desc changes nothing. */
+static void test_double_free(void)
+{
+	unsigned int rsvd = 0;
+	unsigned int desc = 0;
+	unsigned int spare = 0;
+
+	setup();
+
+	rsvd = def_priv->num_tx_tokens_per_ac * NRF_WIFI_FMAC_AC_MAX;
+
+	desc = tx_desc_get(fmac_dev_ctx, NRF_WIFI_FMAC_AC_VO);
+	tx_desc_free(fmac_dev_ctx, desc, NRF_WIFI_FMAC_AC_VO);
+	tx_desc_free(fmac_dev_ctx, desc, NRF_WIFI_FMAC_AC_VO);
+	TEST_CHECK_EQ(def_dev_ctx->tx_config.outstanding_descs[NRF_WIFI_FMAC_AC_VO], 0);
+
+	while (tx_desc_get(fmac_dev_ctx, NRF_WIFI_FMAC_AC_VO) < rsvd)
+		;
+
+	spare = rsvd;
+	tx_desc_free(fmac_dev_ctx, spare, NRF_WIFI_FMAC_AC_VO);
+	tx_desc_free(fmac_dev_ctx, spare, NRF_WIFI_FMAC_AC_VO);
+	TEST_CHECK_EQ(def_dev_ctx->tx_config.outstanding_descs[NRF_WIFI_FMAC_AC_VO],
+		      def_priv->num_tx_tokens_per_ac);
+
+	tx_desc_free(fmac_dev_ctx, def_priv->num_tx_tokens, NRF_WIFI_FMAC_AC_VO);
+	TEST_CHECK_EQ(def_dev_ctx->tx_config.outstanding_descs[NRF_WIFI_FMAC_AC_VO],
+		      def_priv->num_tx_tokens_per_ac);
+
+	teardown();
+}
+
+
+/* Small packet AP load: every AC keeps its descs busy and spills into the
+ * spares, descs complete out of order.
+ */
+static void bench_get_free(void)
+{
+	unsigned int descs[NRF_WIFI_FMAC_AC_MAX][CONFIG_NRF700X_MAX_TX_TOKENS];
+	unsigned int cnt[NRF_WIFI_FMAC_AC_MAX] = { 0 };
+	unsigned long long start = 0;
+	unsigned long ops = 0;
+	unsigned int desc = 0;
+	unsigned int iter = 0;
+	unsigned int half = 0;
+	unsigned int i = 0;
+	int ac = 0;
+
+	setup();
+
+	start = test_ns();
+
+	for (iter = 0; iter < 1000000; iter++) {
+		ac = iter % NRF_WIFI_FMAC_AC_MAX;
+
+		desc = tx_desc_get(fmac_dev_ctx, ac);
+		ops++;
+
+		if (desc != def_priv->num_tx_tokens) {
+			descs[ac][cnt[ac]++] = desc;
+			continue;
+		}
+
+		/* Out of descs, complete the oldest half of this AC */
+		half = cnt[ac] / 2;
+
+		for (i = 0; i < half; i++) {
+			tx_desc_free(fmac_dev_ctx, descs[ac][i], ac);
+			ops++;
+		}
+
+		for (i = half; i < cnt[ac]; i++) {
+			descs[ac][i - half] = descs[ac][i];
+		}
+
+		cnt[ac] -= half;
+	}
+
+	printf("  %.1f ns per get/free\n",
+	       (double)(test_ns() - start) / ops);
+
+	for (ac = 0; ac < NRF_WIFI_FMAC_AC_MAX; ac++) {
+		while (cnt[ac]) {
+			tx_desc_free(fmac_dev_ctx, descs[ac][--cnt[ac]], ac);
+		}
+
+		TEST_CHECK_EQ(def_dev_ctx->tx_config.outstanding_descs[ac], 0);
+	}
+
+	TEST_CHECK_EQ(def_dev_ctx->tx_config.spare_desc_queue_map, 0);
+
+	teardown();
+}
+
+
+int main(void)
+{
+	TEST_RUN(test_get_order);
+	TEST_RUN(test_free_reuse);
+	TEST_RUN(test_double_free);
+	TEST_RUN(bench_get_free);
+
+	return TEST_EXIT();
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief Tests for the flow control of the OS TX queues in AP mode.
+ *
+ * The OS queues are per VIF and AC, shared by all the peers of the VIF.
+ * Frames for a client in power save are held in the driver until it wakes
+ * up, so its backlog must neither stop an AC nor keep it stopped, or one
+ * sleeping client would starve all the others.
+ */
+
+#include "fmac_api.h"
+#include "fmac_peer.h"
+#include "fmac_structs.h"
+#include "fmac_tx.h"
+#include "fmac_util.h"
+#include "mock_fmac.h"
+#include "mock_hal.h"
+#include "queue.h"
+#include "test.h"
+
+#define NUM_PEERS 2
+#define PS_PEER 0
+#define ACTIVE_PEER 1
+#define BACKLOG (TX_PENDING_QLEN_HIGH_WM + 16)
+
+static struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx;
+static unsigned char peer_addr[NUM_PEERS][NRF_WIFI_ETH_ADDR_LEN];
+static int peer_ids[NUM_PEERS];
+
+
+static void setup(void)
+{
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+	unsigned int i = 0;
+
+	mock_hal_reset();
+
+	fmac_dev_ctx = mock_fmac_dev_add();
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	mock_fmac_vif_add(fmac_dev_ctx, 0, NRF_WIFI_IFTYPE_AP, NULL);
+
+	for (i = 0; i < NUM_PEERS; i++) {
+		mock_fmac_mac_addr(peer_addr[i], i + 1);
+		peer_ids[i] = nrf_wifi_fmac_peer_add(fmac_dev_ctx, 0, peer_addr[i], 0, 1);
+		TEST_CHECK(peer_ids[i] != -1);
+	}
+
+	def_dev_ctx->tx_config.peers[peer_ids[PS_PEER]].ps_state = NRF_WIFI_CLIENT_PS_MODE;
+}
+
+
+static void teardown(void)
+{
+	while (mock_hal_tx_done(fmac_dev_ctx) != -1)
+		;
+
+	mock_fmac_dev_rem(fmac_dev_ctx);
+}
+
+
+static void send(unsigned int peer, unsigned int num_frames)
+{
+	unsigned int i = 0;
+	void *nbuf = NULL;
+
+	for (i = 0; i < num_frames; i++) {
+		nbuf = mock_fmac_frame(fmac_dev_ctx,
+				       peer_addr[peer],
+				       NRF_WIFI_FMAC_AC_BE,
+				       100);
+		TEST_CHECK_EQ(nrf_wifi_fmac_start_xmit(fmac_dev_ctx, 0, nbuf),
+			      NRF_WIFI_STATUS_SUCCESS);
+	}
+}
+
+
+static unsigned int pending(unsigned int peer)
+{
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	return nrf_wifi_utils_q_len(fmac_dev_ctx->fpriv->opriv,
+				    def_dev_ctx->tx_config.data_pending_txq[peer_ids[peer]][NRF_WIFI_FMAC_AC_BE]);
+}
+
+
+/* A sleeping client piling up frames leaves the AC open for the others */
+static void test_ps_peer_no_stop(void)
+{
+	unsigned long data_cmds = 0;
+
+	setup();
+
+	send(PS_PEER, BACKLOG);
+
+	TEST_CHECK_EQ(pending(PS_PEER), BACKLOG);
+	TEST_CHECK_EQ(mock_fmac_stats.txq_stops[NRF_WIFI_FMAC_AC_BE], 0);
+	TEST_CHECK_EQ(mock_hal_stats.data_cmds, 0);
+
+	data_cmds = mock_hal_stats.data_cmds;
+	send(ACTIVE_PEER, 1);
+	TEST_CHECK_EQ(mock_hal_stats.data_cmds, data_cmds + 1);
+
+	teardown();
+}
+
+
+/* Once the active peer drains, the AC wakes up even though the sleeping
+ * client still holds more than the low watermark.
+ */
+static void test_ps_peer_no_hold(void)
+{
+	setup();
+
+	send(PS_PEER, BACKLOG);
+	/* The first frames go straight out on the reserved descriptors */
+	send(ACTIVE_PEER, BACKLOG + 64);
+
+	TEST_CHECK_EQ(mock_fmac_stats.txq_stops[NRF_WIFI_FMAC_AC_BE], 1);
+	TEST_CHECK(mock_fmac_stats.txq_stopped[NRF_WIFI_FMAC_AC_BE]);
+
+	while (pending(ACTIVE_PEER) > TX_PENDING_QLEN_LOW_WM) {
+		TEST_CHECK(mock_hal_tx_done(fmac_dev_ctx) != -1);
+	}
+
+	TEST_CHECK(!mock_fmac_stats.txq_stopped[NRF_WIFI_FMAC_AC_BE]);
+	TEST_CHECK_EQ(mock_fmac_stats.txq_wakes[NRF_WIFI_FMAC_AC_BE], 1);
+	TEST_CHECK_EQ(pending(PS_PEER), BACKLOG);
+
+	teardown();
+}
+
+
+int main(void)
+{
+	TEST_RUN(test_ps_peer_no_stop);
+	TEST_RUN(test_ps_peer_no_hold);
+
+	return TEST_EXIT();
+}
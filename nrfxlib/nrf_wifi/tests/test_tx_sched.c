@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief Fairness tests for the TX scheduling policies in AP mode.
+ *
+ * Two peers are kept backlogged on the same AC, one sending short frames
+ * and one sending long ones. Round robin gives both the same number of TX
+ * opportunities, airtime DRR gives both the same share of airtime (here
+ * estimated from the frame sizes as the mock RPU reports no timestamps).
+ */
+
+#include "fmac_api.h"
+#include "fmac_peer.h"
+#include "fmac_structs.h"
+#include "fmac_tx.h"
+#include "fmac_util.h"
+#include "mock_fmac.h"
+#include "mock_hal.h"
+#include "queue.h"
+#include "test.h"
+
+#define NUM_PEERS 2
+#define PEER_BACKLOG 32
+#define NUM_TX_DONE 2000
+
+static const unsigned int frame_len[NUM_PEERS] = { 150, 1500 };
+
+static struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx;
+static unsigned char peer_addr[NUM_PEERS][NRF_WIFI_ETH_ADDR_LEN];
+static int peer_ids[NUM_PEERS];
+static unsigned long served_pkts[NUM_PEERS];
+static unsigned long served_bytes[NUM_PEERS];
+
+
+static void setup(enum nrf_wifi_fmac_tx_sched_policy policy)
+{
+	unsigned int i = 0;
+
+	mock_hal_reset();
+
+	fmac_dev_ctx = mock_fmac_dev_add();
+
+	mock_fmac_vif_add(fmac_dev_ctx, 0, NRF_WIFI_IFTYPE_AP, NULL);
+
+	for (i = 0; i < NUM_PEERS; i++) {
+		mock_fmac_mac_addr(peer_addr[i], i + 1);
+		peer_ids[i] = nrf_wifi_fmac_peer_add(fmac_dev_ctx, 0, peer_addr[i], 0, 1);
+		served_pkts[i] = 0;
+		served_bytes[i] = 0;
+	}
+
+	nrf_wifi_fmac_set_tx_sched_policy(fmac_dev_ctx, policy);
+}
+
+
+static void teardown(void)
+{
+	while (mock_hal_tx_done(fmac_dev_ctx) != -1)
+		;
+
+	mock_fmac_dev_rem(fmac_dev_ctx);
+}
+
+
+static void top_up(void)
+{
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+	unsigned int i = 0;
+	void *txq = NULL;
+	void *nbuf = NULL;
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	for (i = 0; i < NUM_PEERS; i++) {
+		txq = def_dev_ctx->tx_config.data_pending_txq[peer_ids[i]][NRF_WIFI_FMAC_AC_BE];
+
+		while (!mock_fmac_stats.txq_stopped[NRF_WIFI_FMAC_AC_BE] &&
+		       nrf_wifi_utils_q_len(fmac_dev_ctx->fpriv->opriv, txq) < PEER_BACKLOG) {
+			nbuf = mock_fmac_frame(fmac_dev_ctx,
+					       peer_addr[i],
+					       NRF_WIFI_FMAC_AC_BE,
+					       frame_len[i]);
+			TEST_CHECK_EQ(nrf_wifi_fmac_start_xmit(fmac_dev_ctx, 0, nbuf),
+				      NRF_WIFI_STATUS_SUCCESS);
+		}
+	}
+}
+
+
+/* Keep both peers backlogged and account what every completed descriptor
+ * carried to the peer it was sent to.
+ */
+static void run(void)
+{
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+	struct tx_pkt_info *pkt_info = NULL;
+	unsigned int n = 0;
+	unsigned int i = 0;
+	int desc = 0;
+
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	for (n = 0; n < NUM_TX_DONE; n++) {
+		top_up();
+
+		desc = mock_hal_tx_next();
+		TEST_CHECK(desc != -1);
+
+		if (desc == -1) {
+			return;
+		}
+
+		pkt_info = &def_dev_ctx->tx_config.pkt_info_p[desc];
+
+		for (i = 0; i < NUM_PEERS; i++) {
+			if (pkt_info->peer_id == (unsigned int)peer_ids[i]) {
+				served_pkts[i] += nrf_wifi_utils_q_len(fmac_dev_ctx->fpriv->opriv,
+								       pkt_info->pkt);
+				served_bytes[i] += pkt_info->bytes;
+			}
+		}
+
+		mock_hal_tx_done(fmac_dev_ctx);
+	}
+}
+
+
+/* Same number of frames, the peer with the long frames gets the airtime */
+static void test_rr(void)
+{
+	double ratio = 0;
+
+	setup(NRF_WIFI_FMAC_TX_SCHED_RR);
+	run();
+
+	ratio = (double)served_pkts[0] / served_pkts[1];
+
+	printf("  frames %lu/%lu, bytes %lu/%lu\n",
+	       served_pkts[0], served_pkts[1],
+	       served_bytes[0], served_bytes[1]);
+
+	TEST_CHECK(ratio > 0.9 && ratio < 1.1);
+	TEST_CHECK(served_bytes[1] > 5 * served_bytes[0]);
+
+	teardown();
+}
+
+
+/* Same airtime, the peer with the short frames gets more of them out */
+static void test_airtime(void)
+{
+	double ratio = 0;
+
+	setup(NRF_WIFI_FMAC_TX_SCHED_AIRTIME);
+	run();
+
+	ratio = (double)served_bytes[0] / served_bytes[1];
+
+	printf("  frames %lu/%lu, bytes %lu/%lu\n",
+	       served_pkts[0], served_pkts[1],
+	       served_bytes[0], served_bytes[1]);
+
+	TEST_CHECK(ratio > 0.8 && ratio < 1.25);
+	TEST_CHECK(served_pkts[0] > 5 * served_pkts[1]);
+
+	teardown();
+}
+
+
+/* Once the reserved descriptors of an AC are busy, frames are held back
+ * until a full aggregate at the current limit can go out on a spare one.
+ */
+static void test_agg_limit(void)
+{
+	unsigned int i = 0;
+	void *nbuf = NULL;
+
+	setup(NRF_WIFI_FMAC_TX_SCHED_RR);
+
+	TEST_CHECK_EQ(nrf_wifi_fmac_set_tx_agg_limits(fmac_dev_ctx, 2, 2),
+		      NRF_WIFI_STATUS_SUCCESS);
+
+	for (i = 0; i < 4; i++) {
+		nbuf = mock_fmac_frame(fmac_dev_ctx, peer_addr[0], NRF_WIFI_FMAC_AC_BE, 100);
+		TEST_CHECK_EQ(nrf_wifi_fmac_start_xmit(fmac_dev_ctx, 0, nbuf),
+			      NRF_WIFI_STATUS_SUCCESS);
+	}
+
+	/* One frame on each reserved descriptor, then two on a spare one */
+	TEST_CHECK_EQ(mock_hal_stats.data_cmds, 3);
+	TEST_CHECK_EQ(mock_hal_stats.data_cmd_frames, 4);
+
+	teardown();
+}
+
+
+int main(void)
+{
+	TEST_RUN(test_rr);
+	TEST_RUN(test_airtime);
+	TEST_RUN(test_agg_limit);
+
+	return TEST_EXIT();
+}
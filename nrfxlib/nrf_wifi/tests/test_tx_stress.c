@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @brief Multithreaded stress test of the TX path locking.
+ *
+ * Several threads transmit to several peers on all ACs while another one
+ * completes the TX descriptors, as the TX done tasklet would, and another
+ * one keeps changing the TX scheduling configuration. The mock OSAL checks
+ * the lock nesting order on every lock taken.
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include "fmac_api.h"
+#include "fmac_peer.h"
+#include "fmac_structs.h"
+#include "fmac_tx.h"
+#include "fmac_util.h"
+#include "mock_fmac.h"
+#include "mock_hal.h"
+#include "mock_osal.h"
+#include "test.h"
+
+#define NUM_XMIT_THREADS 4
+#define NUM_PEERS MAX_PEERS
+#define FRAMES_PER_THREAD 50000
+
+static struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx;
+static unsigned char peer_addr[NUM_PEERS][NRF_WIFI_ETH_ADDR_LEN];
+static unsigned long accepted[NUM_XMIT_THREADS];
+static volatile int xmit_done;
+
+
+static void *xmit_thread(void *arg)
+{
+	unsigned long id = (unsigned long)arg;
+	unsigned int seed = id;
+	unsigned int i = 0;
+	unsigned int ac = 0;
+	void *nbuf = NULL;
+
+	for (i = 0; i < FRAMES_PER_THREAD; i++) {
+		ac = rand_r(&seed) % NRF_WIFI_FMAC_AC_MC;
+
+		/* Honour the flow control like the OS TX queues would */
+		while (__atomic_load_n(&mock_fmac_stats.txq_stopped[ac], __ATOMIC_RELAXED)) {
+			sched_yield();
+		}
+
+		nbuf = mock_fmac_frame(fmac_dev_ctx,
+				       peer_addr[rand_r(&seed) % NUM_PEERS],
+				       ac,
+				       64 + (rand_r(&seed) % 1400));
+
+		if (nrf_wifi_fmac_start_xmit(fmac_dev_ctx, 0, nbuf) ==
+		    NRF_WIFI_STATUS_SUCCESS) {
+			accepted[id]++;
+		}
+	}
+
+	return NULL;
+}
+
+
+static void *tx_done_thread(void *arg)
+{
+	/* Keep completing until the xmit threads are done and nothing is
+	 * left in flight.
+	 */
+	while (!xmit_done || mock_hal_tx_pending()) {
+		if (mock_hal_tx_done(fmac_dev_ctx) == -1) {
+			sched_yield();
+		}
+	}
+
+	return NULL;
+}
+
+
+static void *config_thread(void *arg)
+{
+	unsigned int i = 0;
+
+	while (!xmit_done) {
+		nrf_wifi_fmac_set_tx_sched_policy(fmac_dev_ctx,
+						  (i & 1) ?
+						  NRF_WIFI_FMAC_TX_SCHED_AIRTIME :
+						  NRF_WIFI_FMAC_TX_SCHED_RR);
+		nrf_wifi_fmac_set_tx_agg_limits(fmac_dev_ctx,
+						1 + (i % 3),
+						CONFIG_NRF700X_MAX_TX_AGGREGATION - (i % 4));
+		i++;
+		sched_yield();
+	}
+
+	return NULL;
+}
+
+
+static void test_tx_stress(void)
+{
+	struct nrf_wifi_fmac_dev_ctx_def *def_dev_ctx = NULL;
+	pthread_t xmit[NUM_XMIT_THREADS];
+	pthread_t tx_done;
+	pthread_t config;
+	unsigned long total_accepted = 0;
+	unsigned long total_done = 0;
+	unsigned long i = 0;
+
+	mock_osal_stats_reset();
+	mock_hal_reset();
+
+	fmac_dev_ctx = mock_fmac_dev_add();
+	def_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	mock_fmac_vif_add(fmac_dev_ctx, 0, NRF_WIFI_IFTYPE_AP, NULL);
+
+	for (i = 0; i < NUM_PEERS; i++) {
+		mock_fmac_mac_addr(peer_addr[i], i);
+		TEST_CHECK(nrf_wifi_fmac_peer_add(fmac_dev_ctx, 0, peer_addr[i], 0, 1) >= 0);
+	}
+
+	xmit_done = 0;
+
+	pthread_create(&tx_done, NULL, tx_done_thread, NULL);
+	pthread_create(&config, NULL, config_thread, NULL);
+
+	for (i = 0; i < NUM_XMIT_THREADS; i++) {
+		pthread_create(&xmit[i], NULL, xmit_thread, (void *)i);
+	}
+
+	for (i = 0; i < NUM_XMIT_THREADS; i++) {
+		pthread_join(xmit[i], NULL);
+		total_accepted += accepted[i];
+	}
+
+	xmit_done = 1;
+
+	pthread_join(config, NULL);
+	pthread_join(tx_done, NULL);
+
+	for (i = 0; i < NRF_WIFI_FMAC_AC_MAX; i++) {
+		total_done += mock_fmac_stats.tx_done_pkts[i];
+		TEST_CHECK_EQ(def_dev_ctx->tx_config.outstanding_descs[i], 0);
+	}
+
+	printf("  %lu frames accepted, %lu TX commands\n",
+	       total_accepted,
+	       mock_hal_stats.data_cmds);
+
+	TEST_CHECK(total_accepted > 0);
+	TEST_CHECK_EQ(total_done, total_accepted);
+	TEST_CHECK_EQ(mock_hal_stats.data_cmd_frames, total_accepted);
+	TEST_CHECK_EQ(mock_osal_stats.nbuf_frees, mock_osal_stats.nbuf_allocs);
+	TEST_CHECK_EQ(mock_osal_stats.lock_order_violations, 0);
+
+	mock_fmac_dev_rem(fmac_dev_ctx);
+}
+
+
+int main(void)
+{
+	TEST_RUN(test_tx_stress);
+
+	return TEST_EXIT();
+}
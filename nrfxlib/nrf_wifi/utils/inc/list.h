@@ -15,6 +15,9 @@
 #include <stddef.h>
 #include "osal_api.h"
 
+/* Maximum number of free nodes a list keeps around for reuse */
+#define NRF_WIFI_UTILS_LIST_NODE_CACHE_MAX 32
+
 void *nrf_wifi_utils_list_alloc(struct nrf_wifi_osal_priv *opriv);
 
 void nrf_wifi_utils_list_free(struct nrf_wifi_osal_priv *opriv,
@@ -12,11 +12,66 @@
 
 #include "list.h"
 
+/**
+ * struct nrf_wifi_utils_list - Linked list with a cache of free nodes.
+ * @llist: OSAL linked list holding the data.
+ * @free_nodes: Stack of nodes released from the list, each node's data
+ *              points to the next free node.
+ * @num_free_nodes: Number of nodes in @free_nodes.
+ *
+ * Nodes removed from the list are kept for reuse, so that once a list has
+ * reached its usual depth, adding to it no longer needs an allocation.
+ */
+struct nrf_wifi_utils_list {
+	void *llist;
+	void *free_nodes;
+	unsigned int num_free_nodes;
+};
+
+
+static void *list_node_get(struct nrf_wifi_osal_priv *opriv,
+			   struct nrf_wifi_utils_list *list)
+{
+	void *list_node = NULL;
+
+	if (list->free_nodes) {
+		list_node = list->free_nodes;
+		list->free_nodes = nrf_wifi_osal_llist_node_data_get(opriv,
+								     list_node);
+		list->num_free_nodes--;
+	} else {
+		list_node = nrf_wifi_osal_llist_node_alloc(opriv);
+	}
+
+	return list_node;
+}
+
+
+static void list_node_put(struct nrf_wifi_osal_priv *opriv,
+			  struct nrf_wifi_utils_list *list,
+			  void *list_node)
+{
+	if (list->num_free_nodes >= NRF_WIFI_UTILS_LIST_NODE_CACHE_MAX) {
+		nrf_wifi_osal_llist_node_free(opriv,
+					      list_node);
+		return;
+	}
+
+	nrf_wifi_osal_llist_node_data_set(opriv,
+					  list_node,
+					  list->free_nodes);
+	list->free_nodes = list_node;
+	list->num_free_nodes++;
+}
+
+
+
 void *nrf_wifi_utils_list_alloc(struct nrf_wifi_osal_priv *opriv)
 {
-	void *list = NULL;
+	struct nrf_wifi_utils_list *list = NULL;
 
-	list = nrf_wifi_osal_llist_alloc(opriv);
+	list = nrf_wifi_osal_mem_zalloc(opriv,
+					sizeof(*list));
 
 	if (!list) {
 		nrf_wifi_osal_log_err(opriv,
@@ -25,8 +80,20 @@ void *nrf_wifi_utils_list_alloc(struct nrf_wifi_osal_priv *opriv)
 		goto out;
 	}
 
+	list->llist = nrf_wifi_osal_llist_alloc(opriv);
+
+	if (!list->llist) {
+		nrf_wifi_osal_log_err(opriv,
+				      "%s: Unable to allocate list\n",
+				      __func__);
+		nrf_wifi_osal_mem_free(opriv,
+				       list);
+		list = NULL;
+		goto out;
+	}
+
 	nrf_wifi_osal_llist_init(opriv,
-				 list);
+				 list->llist);
 
 out:
 	return list;
@@ -37,8 +104,26 @@ out:
 void nrf_wifi_utils_list_free(struct nrf_wifi_osal_priv *opriv,
 			      void *list)
 {
+	struct nrf_wifi_utils_list *utils_list = list;
+	void *list_node = NULL;
+
+	if (!utils_list) {
+		return;
+	}
+
+	while (utils_list->free_nodes) {
+		list_node = utils_list->free_nodes;
+		utils_list->free_nodes = nrf_wifi_osal_llist_node_data_get(opriv,
+									   list_node);
+		nrf_wifi_osal_llist_node_free(opriv,
+					      list_node);
+	}
+
 	nrf_wifi_osal_llist_free(opriv,
-				 list);
+				 utils_list->llist);
+
+	nrf_wifi_osal_mem_free(opriv,
+			       utils_list);
 }
 
 
@@ -46,9 +131,11 @@ enum nrf_wifi_status nrf_wifi_utils_list_add_tail(struct nrf_wifi_osal_priv *opr
 						  void *list,
 						  void *data)
 {
+	struct nrf_wifi_utils_list *utils_list = list;
 	void *list_node = NULL;
 
-	list_node = nrf_wifi_osal_llist_node_alloc(opriv);
+	list_node = list_node_get(opriv,
+				  utils_list);
 
 	if (!list_node) {
 		nrf_wifi_osal_log_err(opriv,
@@ -62,7 +149,7 @@ enum nrf_wifi_status nrf_wifi_utils_list_add_tail(struct nrf_wifi_osal_priv *opr
 					  data);
 
 	nrf_wifi_osal_llist_add_node_tail(opriv,
-					  list,
+					  utils_list->llist,
 					  list_node);
 
 	return NRF_WIFI_STATUS_SUCCESS;
@@ -72,9 +159,11 @@ enum nrf_wifi_status nrf_wifi_utils_list_add_head(struct nrf_wifi_osal_priv *opr
 						  void *list,
 						  void *data)
 {
+	struct nrf_wifi_utils_list *utils_list = list;
 	void *list_node = NULL;
 
-	list_node = nrf_wifi_osal_llist_node_alloc(opriv);
+	list_node = list_node_get(opriv,
+				  utils_list);
 
 	if (!list_node) {
 		nrf_wifi_osal_log_err(opriv,
@@ -88,7 +177,7 @@ enum nrf_wifi_status nrf_wifi_utils_list_add_head(struct nrf_wifi_osal_priv *opr
 					  data);
 
 	nrf_wifi_osal_llist_add_node_head(opriv,
-					  list,
+					  utils_list->llist,
 					  list_node);
 
 	return NRF_WIFI_STATUS_SUCCESS;
@@ -98,28 +187,30 @@ void nrf_wifi_utils_list_del_node(struct nrf_wifi_osal_priv *opriv,
 				  void *list,
 				  void *data)
 {
+	struct nrf_wifi_utils_list *utils_list = list;
 	void *stored_data;
 	void *list_node = NULL;
 	void *list_node_next = NULL;
 
 	list_node = nrf_wifi_osal_llist_get_node_head(opriv,
-						      list);
+						      utils_list->llist);
 
 	while (list_node) {
 		stored_data = nrf_wifi_osal_llist_node_data_get(opriv,
 								list_node);
 
 		list_node_next = nrf_wifi_osal_llist_get_node_nxt(opriv,
-								  list,
+								  utils_list->llist,
 								  list_node);
 
 		if (stored_data == data) {
 			nrf_wifi_osal_llist_del_node(opriv,
-						     list,
+						     utils_list->llist,
 						     list_node);
 
-			nrf_wifi_osal_llist_node_free(opriv,
-						      list_node);
+			list_node_put(opriv,
+				      utils_list,
+				      list_node);
 		}
 
 		list_node = list_node_next;
@@ -129,11 +220,12 @@ void nrf_wifi_utils_list_del_node(struct nrf_wifi_osal_priv *opriv,
 void *nrf_wifi_utils_list_del_head(struct nrf_wifi_osal_priv *opriv,
 				   void *list)
 {
+	struct nrf_wifi_utils_list *utils_list = list;
 	void *list_node = NULL;
 	void *data = NULL;
 
 	list_node = nrf_wifi_osal_llist_get_node_head(opriv,
-						      list);
+						      utils_list->llist);
 
 	if (!list_node) {
 		goto out;
@@ -143,10 +235,11 @@ void *nrf_wifi_utils_list_del_head(struct nrf_wifi_osal_priv *opriv,
 						 list_node);
 
 	nrf_wifi_osal_llist_del_node(opriv,
-				     list,
+				     utils_list->llist,
 				     list_node);
-	nrf_wifi_osal_llist_node_free(opriv,
-				      list_node);
+	list_node_put(opriv,
+		      utils_list,
+		      list_node);
 
 out:
 	return data;
@@ -156,11 +249,12 @@ out:
 void *nrf_wifi_utils_list_peek(struct nrf_wifi_osal_priv *opriv,
 			       void *list)
 {
+	struct nrf_wifi_utils_list *utils_list = list;
 	void *list_node = NULL;
 	void *data = NULL;
 
 	list_node = nrf_wifi_osal_llist_get_node_head(opriv,
-						      list);
+						      utils_list->llist);
 
 	if (!list_node) {
 		goto out;
@@ -177,8 +271,10 @@ out:
 unsigned int nrf_wifi_utils_list_len(struct nrf_wifi_osal_priv *opriv,
 				     void *list)
 {
+	struct nrf_wifi_utils_list *utils_list = list;
+
 	return nrf_wifi_osal_llist_len(opriv,
-				       list);
+				       utils_list->llist);
 }
 
 
@@ -189,12 +285,13 @@ nrf_wifi_utils_list_traverse(struct nrf_wifi_osal_priv *opriv,
 			     enum nrf_wifi_status (*callbk_func)(void *callbk_data,
 								 void *data))
 {
+	struct nrf_wifi_utils_list *utils_list = list;
 	void *list_node = NULL;
 	void *data = NULL;
 	enum nrf_wifi_status status = NRF_WIFI_STATUS_FAIL;
 
 	list_node = nrf_wifi_osal_llist_get_node_head(opriv,
-						      list);
+						      utils_list->llist);
 
 	while (list_node) {
 		data = nrf_wifi_osal_llist_node_data_get(opriv,
@@ -208,7 +305,7 @@ nrf_wifi_utils_list_traverse(struct nrf_wifi_osal_priv *opriv,
 		}
 
 		list_node = nrf_wifi_osal_llist_get_node_nxt(opriv,
-							     list,
+							     utils_list->llist,
 							     list_node);
 	}
 out: